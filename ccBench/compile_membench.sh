@@ -26,6 +26,60 @@ echo -e "\nbandwidth/single-r1w1:\n" >> compile_membench.err
 echo -e "\nlatency/read:\n" | tee -a compile_membench.log
 echo -e "\nlatency/read:\n" >> compile_membench.err
 ./COMPILE.SH kernel/arch_x86-64/memory_latency/C/pthread/0/read/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/multiple-reader:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/multiple-reader:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/SIMD/multiple-reader/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/multiple-r1w1:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/multiple-r1w1:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/SIMD/multiple-r1w1/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-reader:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-reader:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/SIMD/single-reader/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-writer:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-writer:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/SIMD/single-writer/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-r1w1:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-r1w1:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/SIMD/single-r1w1/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-stream:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-stream:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/SIMD/single-stream/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-zero:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-zero:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/SIMD/single-zero/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-stride:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/single-stride:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/SIMD/single-stride/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/atomic-contention:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/atomic-contention:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/0/atomic-contention/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/false-sharing:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/false-sharing:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/0/false-sharing/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/gups:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/gups:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/0/gups/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/ifetch:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/ifetch:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/0/ifetch/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/page-fault:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/page-fault:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/0/page-fault/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/memcpy:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 bandwidth/memcpy:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_bandwidth/C/pthread/SIMD/memcpy/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 latency/read:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 latency/read:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_latency/C/pthread/0/read/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 latency/loaded-read:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 latency/loaded-read:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_latency/C/pthread/0/loaded-read/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 latency/core-to-core:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 latency/core-to-core:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_latency/C/pthread/0/core-to-core/ 2>> compile_membench.err | tee -a compile_membench.log
+echo -e "\nAArch64 latency/tlb:\n" | tee -a compile_membench.log
+echo -e "\nAArch64 latency/tlb:\n" >> compile_membench.err
+./COMPILE.SH kernel/AArch64/memory_latency/C/pthread/0/tlb/ 2>> compile_membench.err | tee -a compile_membench.log
 
 echo -e "\n Errors:\n"
 cat compile_membench.err
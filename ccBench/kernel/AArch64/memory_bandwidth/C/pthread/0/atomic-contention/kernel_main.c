@@ -0,0 +1,551 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *****************************************************************************************************/
+/* Kernel: measures throughput of atomic operations on shared and private cache lines for 1 to N threads.
+ *****************************************************************************************************/
+#define _GNU_SOURCE
+#include <sched.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <signal.h>
+#include <unistd.h>
+#include "interface.h"
+#include "tools/hw_detect/cpu.h"
+
+
+/*  Header for local functions */
+#include "work.h"
+
+
+/* number of functions (needed by BenchIT Framework, see bi_getinfo()) */
+int n_of_works;
+int n_of_sure_funcs_per_work;
+
+/* variables to store settings from PARAMETERS file
+ * parsed by evaluate_environment() function */
+int RUNS=0,NUM_RESULTS=0,TIMEOUT=0,NUM_THREADS=0;
+/* idle policy of the helper threads, spin time in ns before blocking (-1: spin only), derived from IDLE_POLICY and IDLE_SPIN_TIME in PARAMETERS file */
+long long IDLE_SPIN_TIME=-1;
+unsigned long long DURATION=0;
+
+/* selected atomic operations and counter placements, derived from INSTRUCTION and PLACEMENT in PARAMETERS file */
+int functions[NUM_FUNCS],NUM_FUNCTIONS=0;
+int placements[NUM_PLACEMENTS],NUM_PLACEMENTS_SELECTED=0;
+static const char *function_names[NUM_FUNCS]={"ldadd","cas","swp","ldxr/stxr"};
+static const char *placement_names[NUM_PLACEMENTS]={"shared line","private lines"};
+
+/* string used for error message */
+char *error_msg=NULL;
+
+/* CPU bindings of threads, derived from CPU_LIST in PARAMETERS file */
+cpu_set_t cpuset;
+unsigned long long *cpu_bind;
+
+/* memory affinity of threads, derived from MEM_BIND option in PARAMETERS file */
+unsigned long long *mem_bind;
+
+/* data structure for hardware detection */
+static cpu_info_t *cpuinfo=NULL;
+
+/* needed to derive elapsed time from clock cycles, determined by hw_detect */
+unsigned long long FREQUENCY=0;
+
+/* data structure that holds all relevant information for kernel execution */
+volatile mydata_t* mdp;
+
+/* data for watchdog timer */
+pthread_t watchdog;
+typedef struct watchdog_args{
+ pid_t pid;
+ int timeout;
+} watchdog_arg_t;
+watchdog_arg_t watchdog_arg;
+
+/* stops watchdog thread if benchmark finishes before timeout */
+static void sigusr1_handler (int signum) {
+ pthread_exit(0);
+}
+
+/** stops benchmark if timeout is reached
+ */
+static void *watchdog_timer(void *arg){
+  sigset_t  signal_mask;
+
+  /* ignore SIGTERM and SIGINT */
+  sigemptyset (&signal_mask);
+  sigaddset (&signal_mask, SIGINT);
+  sigaddset (&signal_mask, SIGTERM);
+  pthread_sigmask (SIG_BLOCK, &signal_mask, NULL);
+
+  /* watchdog thread will terminate after receiveing SIGUSR1 during bi_cleanup() */
+  signal(SIGUSR1,sigusr1_handler);
+
+  if (((watchdog_arg_t*)arg)->timeout>0){
+     /* sleep for specified timeout before terminating benchmark */
+     sleep(((watchdog_arg_t*)arg)->timeout);
+     kill(((watchdog_arg_t*)arg)->pid,SIGTERM);
+  }
+  pthread_exit(0);
+}
+
+/** function that parses the PARAMETERS file
+ */
+void evaluate_environment(bi_info * info);
+
+/**  The implementation of the bi_getinfo() from the BenchIT interface.
+ *   Infostruct is filled with informations about the kernel.
+ *   @param infostruct  a pointer to a structure filled with zero's
+ */
+void bi_getinfo( bi_info * infostruct )
+{
+   int i = 0, j = 0; /* loop var for n_of_works */
+   char buff[512];
+   (void) memset ( infostruct, 0, sizeof( bi_info ) );
+   /* get environment variables for the kernel */
+   evaluate_environment(infostruct);
+   infostruct->codesequence = bi_strdup( CODE_SEQUENCE );
+   infostruct->xaxistext = bi_strdup( X_AXIS_TEXT );
+   infostruct->base_xaxis=0;
+   /* one measurement for every number of threads */
+   infostruct->maxproblemsize=NUM_THREADS;
+   sprintf(buff, KERNEL_DESCRIPTION);
+   infostruct->kerneldescription = bi_strdup( buff );
+   infostruct->num_processes = 1;
+   infostruct->num_threads_per_process = NUM_THREADS;
+   infostruct->kernel_execs_mpi1 = 0;
+   infostruct->kernel_execs_mpi2 = 0;
+   infostruct->kernel_execs_pvm = 0;
+   infostruct->kernel_execs_omp = 0;
+   infostruct->kernel_execs_pthreads = 1;
+
+   /* operations per second and cycles per operation */
+   n_of_works = 2;
+
+   /* one curve for every combination of atomic operation and counter placement */
+   n_of_sure_funcs_per_work = NUM_RESULTS;
+
+   infostruct->numfunctions = n_of_works * n_of_sure_funcs_per_work;
+
+   /* allocating memory for y axis texts and properties */
+   infostruct->yaxistexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->yaxistexts == 0 ){
+     fprintf( stderr, "Allocation of yaxistexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->outlier_direction_upwards = malloc( infostruct->numfunctions * sizeof( int ));
+   if ( infostruct->outlier_direction_upwards == 0 ){
+     fprintf( stderr, "Allocation of outlier direction failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->legendtexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->legendtexts == 0 ){
+     fprintf( stderr, "Allocation of legendtexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->base_yaxis = malloc( infostruct->numfunctions * sizeof( double ));
+   if ( infostruct->base_yaxis == 0 ){
+     fprintf( stderr, "Allocation of base yaxis failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+
+   /* setting up y axis texts and properties */
+   for ( j = 0; j < n_of_works; j++ ){
+     int k,index;
+      for (k=0;k<n_of_sure_funcs_per_work;k++)
+      {
+
+        index= k + n_of_sure_funcs_per_work * j;
+        infostruct->base_yaxis[index] = 0;
+        switch ( j )
+        {
+          case 0: // operations per second
+            sprintf(buff,"%s, %s (operations per second)",function_names[functions[k/NUM_PLACEMENTS_SELECTED]],placement_names[placements[k%NUM_PLACEMENTS_SELECTED]]);
+            infostruct->legendtexts[index] = bi_strdup( buff );
+            infostruct->outlier_direction_upwards[index] = 0;  //report maximum of iterations
+            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_1 );
+            break;
+          case 1: // cycles per operation
+           sprintf(buff,"%s, %s (cycles per operation)",function_names[functions[k/NUM_PLACEMENTS_SELECTED]],placement_names[placements[k%NUM_PLACEMENTS_SELECTED]]);
+           infostruct->legendtexts[index] = bi_strdup( buff );
+           infostruct->outlier_direction_upwards[index] = 1;   //report minimum of iterations
+           infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_2 );
+           break;
+          default: break;
+        }
+      }
+   }
+}
+
+/** Implementation of the bi_init() of the BenchIT interface.
+ *  init data structures needed for kernel execution
+ */
+void* bi_init( int problemsizemax )
+{
+   int t;
+   unsigned long long i;
+   unsigned int numa_node;
+   struct bitmask *numa_bitmask;
+
+   cpu_set(cpu_bind[0]); /* first thread binds to first CPU in list */
+
+   mdp->cpuinfo=cpuinfo;
+
+   /* overwrite detected clockrate if specified in PARAMETERS file*/
+   if (FREQUENCY){
+      mdp->cpuinfo->clockrate=FREQUENCY;
+   }
+   else if (mdp->cpuinfo->clockrate==0){
+      fprintf( stderr, "Error: CPU-Clockrate could not be estimated\n" );
+      exit( 1 );
+   }
+
+   /* duration of each measurement in cycles */
+   mdp->duration=(unsigned long long)(((double)DURATION/1000.0)*(double)mdp->cpuinfo->clockrate);
+   mdp->runs=RUNS;
+   mdp->num_threads=NUM_THREADS;
+   mdp->threads=_mm_malloc(NUM_THREADS*sizeof(pthread_t),64);
+   mdp->mailbox=_mm_malloc(NUM_THREADS*sizeof(mailbox_t),sizeof(mailbox_t));
+   mdp->threaddata = _mm_malloc(mdp->num_threads*sizeof(threaddata_t),64);
+   if ((mdp->threads==NULL)||(mdp->mailbox==NULL)||(mdp->threaddata==NULL)){
+     fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   memset( mdp->threaddata,0,mdp->num_threads*sizeof(threaddata_t));
+   memset(mdp->mailbox,0,NUM_THREADS*sizeof(mailbox_t));
+   for (i=0;i<NUM_THREADS;i++) mdp->mailbox[i].spin_time=IDLE_SPIN_TIME;
+
+  /* create threads */
+  for (t=1;t<mdp->num_threads;t++){
+    mdp->threaddata[t].cpuinfo=(cpu_info_t*)_mm_malloc( sizeof( cpu_info_t ),64);
+    if ( mdp->threaddata[t].cpuinfo == 0 ){
+      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+      exit( 127 );
+    }
+    memcpy(mdp->threaddata[t].cpuinfo,mdp->cpuinfo,sizeof(cpu_info_t));
+    mdp->threaddata[t].thread_id=t;
+    mdp->threaddata[t].cpu_id=cpu_bind[t];
+    mdp->threaddata[t].mem_bind=mem_bind[t];
+    mdp->threaddata[t].data=mdp;
+    mailbox_post(&(mdp->mailbox[t]),THREAD_INIT);
+    pthread_create(&(mdp->threads[t]),NULL,thread,(void*)(&(mdp->threaddata[t])));
+  }
+
+  cpu_set(mem_bind[0]);
+  numa_node = numa_node_of_cpu(mem_bind[0]);
+  numa_bitmask = numa_bitmask_alloc((unsigned int) numa_max_possible_node());
+  numa_bitmask = numa_bitmask_clearall(numa_bitmask);
+  numa_bitmask = numa_bitmask_setbit(numa_bitmask, numa_node);
+  numa_set_membind(numa_bitmask);
+  numa_bitmask_free(numa_bitmask);
+
+  /* allocate shared counter and private counter of first thread */
+  mdp->shared_area = (char*) _mm_malloc(COUNTER_AREA,COUNTER_AREA);
+  mdp->private_area = (char*) _mm_malloc(COUNTER_AREA,COUNTER_AREA);
+  if ((mdp->shared_area == 0)||(mdp->private_area == 0)){
+     fprintf( stderr, "Error: Allocation of counter failed\n" ); fflush( stderr );
+     exit( 127 );
+  }
+  memset(mdp->shared_area,0,COUNTER_AREA);
+  memset(mdp->private_area,0,COUNTER_AREA);
+
+  cpu_set(cpu_bind[0]);
+  printf("  wait for threads memory initialization \n");fflush(stdout);
+  /* wait for threads to finish their initialization */
+  for (t=1;t<mdp->num_threads;t++) mailbox_wait(&(mdp->mailbox[t]));
+  printf("    ...done\n");
+  if ((num_packages()!=-1)&&(num_cores_per_package()!=-1)&&(num_threads_per_core()!=-1))  printf("  num_packages: %i, %i cores per package, %i threads per core\n",num_packages(),num_cores_per_package(),num_threads_per_core());
+  printf("  using %i threads\n",NUM_THREADS);
+  for (i=0;i<NUM_THREADS;i++) if ((get_pkg(cpu_bind[i])!=-1)&&(get_core_id(cpu_bind[i])!=-1)) printf("    - Thread %llu runs on CPU %llu, core %i in package: %i\n",i,cpu_bind[i],get_core_id(cpu_bind[i]),get_pkg(cpu_bind[i]));
+  fflush(stdout);
+
+
+  /* start watchdog thread */
+  watchdog_arg.pid=getpid();
+  watchdog_arg.timeout=TIMEOUT;
+  pthread_create(&watchdog,NULL,watchdog_timer,&watchdog_arg);
+
+  return (void*)mdp;
+}
+
+/** The central function within each kernel. This function
+ *  is called for each measurment step seperately.
+ *  @param  mdpv         a pointer to the structure created in bi_init,
+ *                       it is the pointer the bi_init returns
+ *  @param  problemsize  the actual problemsize
+ *  @param  results      a pointer to a field of doubles, the
+ *                       size of the field depends on the number
+ *                       of functions, there are #functions+1
+ *                       doubles
+ *  @return 0 if the measurment was sucessfull, something
+ *          else in the case of an error
+ */
+int inline bi_entry( void* mdpv, int problemsize, double* results )
+{
+  /* i,j,k are used for loop iterations */
+  int i = 0, j = 0, k = 0;
+  /* cast void* pointer */
+  mydata_t* mdp = (mydata_t*)mdpv;
+
+  /* results */
+  double *tmp_results;
+
+  /* check wether the pointer to store the results in is valid or not */
+  if ( results == NULL ) return 1;
+
+  tmp_results=_mm_malloc(sizeof(double),64);
+
+  /* the number of threads is used as x-value */
+  results[0] = (double)problemsize;
+
+  for (i=0;i<NUM_FUNCTIONS;i++)
+  {
+    for (j=0;j<NUM_PLACEMENTS_SELECTED;j++)
+    {
+      k=i*NUM_PLACEMENTS_SELECTED+j;
+
+      /* measure operations of all threads per cycle */
+      _work(problemsize,functions[i],placements[j],mdp->duration,RUNS,mdp,&tmp_results);
+
+      if (tmp_results[0]==INVALID_MEASUREMENT){
+        results[1+k]=INVALID_MEASUREMENT;
+        results[1+NUM_RESULTS+k]=INVALID_MEASUREMENT;
+      }
+      else {
+        /* operations per second of all threads */
+        results[1+k]=tmp_results[0]*(double)mdp->cpuinfo->clockrate;
+        /* average time between two operations of a single thread */
+        results[1+NUM_RESULTS+k]=(double)problemsize/tmp_results[0];
+      }
+    }
+  }
+  _mm_free(tmp_results);
+  return 0;
+}
+
+/** Clean up the memory
+ */
+void bi_cleanup( void* mdpv )
+{
+   int t;
+
+   mydata_t* mdp = (mydata_t*)mdpv;
+   /* terminate other threads */
+   for (t=1;t<mdp->num_threads;t++) mailbox_post(&(mdp->mailbox[t]),THREAD_STOP);
+   for (t=1;t<mdp->num_threads;t++) pthread_join((mdp->threads[t]),NULL);
+   if (mdp->mailbox) mailbox_report(mdp->mailbox,mdp->num_threads);
+   pthread_kill(watchdog,SIGUSR1);
+
+   /* free resources */
+   if (mdp->shared_area) _mm_free(mdp->shared_area);
+   if (mdp->private_area) _mm_free(mdp->private_area);
+   if (mdp->threaddata){
+     for (t=1;t<mdp->num_threads;t++){
+        if (mdp->threaddata[t].cpuinfo) _mm_free(mdp->threaddata[t].cpuinfo);
+     }
+     _mm_free(mdp->threaddata);
+   }
+   if (mdp->threads) _mm_free(mdp->threads);
+   if (mdp->mailbox) _mm_free(mdp->mailbox);
+   if (mdp->cpuinfo) _mm_free(mdp->cpuinfo);
+   _mm_free( mdp );
+   return;
+}
+
+/********************************************************************/
+/*************** End of interface implementations *******************/
+/********************************************************************/
+
+/* Reads the environment variables used by this kernel. */
+void evaluate_environment(bi_info * info)
+{
+   int i;
+   int errors = 0;
+   char * p = 0;
+
+   cpuinfo=(cpu_info_t*)_mm_malloc( sizeof( cpu_info_t ),64);memset((void*)cpuinfo,0,sizeof( cpu_info_t ));
+   if ( cpuinfo == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure cpuinfo_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+   init_cpuinfo(cpuinfo,1);
+
+   mdp = (mydata_t*)_mm_malloc( sizeof( mydata_t ),64);memset((void*)mdp,0, sizeof( mydata_t ));
+   if ( mdp == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+
+   error_msg=malloc(256);
+
+   CPU_ZERO(&cpuset);NUM_THREADS=0;
+   if (bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 ));else p=NULL;
+   if (p){
+     char *q,*r,*s;
+     i=0;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       s=strstr(p,"/");if (s) {*s='\0';s++;}
+       r=strstr(p,"-");if (r) {*r='\0';r++;}
+
+       if ((s)&&(r)) for (i=atoi(p);i<=atoi(r);i+=atoi(s)) {if (cpu_allowed(i)) {CPU_SET(i,&cpuset);NUM_THREADS++;}}
+       else if (r) for (i=atoi(p);i<=atoi(r);i++) {if (cpu_allowed(i)) {CPU_SET(i,&cpuset);NUM_THREADS++;}}
+       else if (cpu_allowed(atoi(p))) {CPU_SET(atoi(p),&cpuset);NUM_THREADS++;}
+       p=q;
+     }while(p!=NULL);
+   }
+   else { /* use all allowed CPUs if not defined otherwise */
+     for (i=0;i<CPU_SETSIZE;i++) {if (cpu_allowed(i)) {CPU_SET(i,&cpuset);NUM_THREADS++;}}
+   }
+
+   /* bind threads to available cores in specified order */
+   if (NUM_THREADS==0) {errors++;sprintf(error_msg,"no allowed CPUs in BENCHIT_KERNEL_CPU_LIST");}
+   else
+   {
+     int j=0;
+     cpu_bind=(unsigned long long*)malloc((NUM_THREADS+1)*sizeof(unsigned long long));
+     if (bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 ));else p=NULL;
+     if (p)
+     {
+       char *q,*r,*s;
+       i=0;
+       do
+       {
+         q=strstr(p,",");if (q) {*q='\0';q++;}
+         s=strstr(p,"/");if (s) {*s='\0';s++;}
+         r=strstr(p,"-");if (r) {*r='\0';r++;}
+
+         if ((s)&&(r)) for (i=atoi(p);i<=atoi(r);i+=atoi(s)) {if (cpu_allowed(i)) {cpu_bind[j]=i;j++;}}
+         else if (r) for (i=atoi(p);i<=atoi(r);i++) {if (cpu_allowed(i)) {cpu_bind[j]=i;j++;}}
+         else if (cpu_allowed(atoi(p))) {cpu_bind[j]=atoi(p);j++;}
+         p=q;
+       }
+       while(p!=NULL);
+     }
+     else { /* no order specified */
+       for(i=0;i<CPU_SETSIZE;i++){
+        if (CPU_ISSET(i,&cpuset)) {cpu_bind[j]=i;j++;}
+       }
+     }
+   }
+
+   p = bi_getenv( "BENCHIT_KERNEL_CPU_FREQUENCY", 0 );
+   if ( p != 0 ) FREQUENCY = atoll( p );
+
+   p = bi_getenv( "BENCHIT_KERNEL_DURATION", 0 );
+   if ( p != 0 ) DURATION = atoll( p );
+   if (DURATION==0) DURATION=10;
+
+   p = bi_getenv( "BENCHIT_KERNEL_RUNS", 0 );
+   if ( p != 0 ) RUNS = atoi( p );
+   if (RUNS<1) RUNS=1;
+
+   p=bi_getenv( "BENCHIT_KERNEL_ALLOC", 0 );
+   if (p==0) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_ALLOC not set");}
+   else {
+     mem_bind=(unsigned long long*)malloc((NUM_THREADS+1)*sizeof(unsigned long long));
+     if (!strcmp(p,"G")) for (i=0;i<NUM_THREADS;i++) mem_bind[i] = cpu_bind[0];
+     else if (!strcmp(p,"L")) for (i=0;i<NUM_THREADS;i++) mem_bind[i] = cpu_bind[i];
+     else if (!strcmp(p,"B")) {
+       int j=0;
+
+       if (bi_getenv( "BENCHIT_KERNEL_MEM_BIND", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_MEM_BIND", 0 ));else p=NULL;
+       if (p)
+       {
+         char *q,*r,*s;
+         i=0;
+         do
+         {
+           q=strstr(p,",");if (q) {*q='\0';q++;}
+           s=strstr(p,"/");if (s) {*s='\0';s++;}
+           r=strstr(p,"-");if (r) {*r='\0';r++;}
+
+           if ((s)&&(r)) for (i=atoi(p);i<=atoi(r);i+=atoi(s)) {if (cpu_allowed(i)) {if (j<=NUM_THREADS) mem_bind[j]=i;j++;} else {errors++;sprintf(error_msg,"selected CPU not allowed");}}
+           else if (r) for (i=atoi(p);i<=atoi(r);i++) {if (cpu_allowed(i)) {if (j<=NUM_THREADS) mem_bind[j]=i;j++;} else {errors++;sprintf(error_msg,"selected CPU not allowed");}}
+           else if (cpu_allowed(atoi(p))) {if (j<=NUM_THREADS) mem_bind[j]=atoi(p);j++;} else {errors++;sprintf(error_msg,"selected CPU not allowed");}
+           p=q;
+         }
+         while((p!=NULL)&&(j<NUM_THREADS));
+         if (j<NUM_THREADS) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MEM_BIND too short");}
+       }
+       else {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MEM_BIND not set, required by BENCHIT_KERNEL_ALLOC=\"B\"");}
+     }
+     else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_ALLOC");}
+   }
+
+   if (bi_getenv( "BENCHIT_KERNEL_INSTRUCTION", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_INSTRUCTION", 0 ));else p=NULL;
+   if (p==0) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_INSTRUCTION not set");}
+   else {
+     char *q;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       if (NUM_FUNCTIONS==NUM_FUNCS) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_INSTRUCTION");}
+       else if (!strcmp(p,"ldxr_stxr")) {functions[NUM_FUNCTIONS]=FUNC_LDXR_STXR;NUM_FUNCTIONS++;}
+       else if ((!strcmp(p,"ldadd"))||(!strcmp(p,"cas"))||(!strcmp(p,"swp"))) {
+         if (!strcmp(p,"ldadd")) functions[NUM_FUNCTIONS]=FUNC_LDADD;
+         else if (!strcmp(p,"cas")) functions[NUM_FUNCTIONS]=FUNC_CAS;
+         else functions[NUM_FUNCTIONS]=FUNC_SWP;
+         NUM_FUNCTIONS++;
+         #ifdef NO_LSE
+         errors++;sprintf(error_msg,"BENCHIT_KERNEL_INSTRUCTION=\"%s\" requires LSE support in the assembler (compiled with NO_LSE)",p);
+         #endif
+         if (!(cpuinfo->features&LSE)) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_INSTRUCTION=\"%s\" requires LSE atomics, which are not supported by this CPU",p);}
+       }
+       else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_INSTRUCTION");}
+       p=q;
+     }while(p!=NULL);
+   }
+
+   if (bi_getenv( "BENCHIT_KERNEL_PLACEMENT", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_PLACEMENT", 0 ));else p=NULL;
+   if (p==0) { /* measure both placements if not defined otherwise */
+     placements[0]=PLACEMENT_SHARED;
+     placements[1]=PLACEMENT_PRIVATE;
+     NUM_PLACEMENTS_SELECTED=2;
+   }
+   else {
+     char *q;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       if (NUM_PLACEMENTS_SELECTED==NUM_PLACEMENTS) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_PLACEMENT");}
+       else if (!strcmp(p,"shared")) {placements[NUM_PLACEMENTS_SELECTED]=PLACEMENT_SHARED;NUM_PLACEMENTS_SELECTED++;}
+       else if (!strcmp(p,"private")) {placements[NUM_PLACEMENTS_SELECTED]=PLACEMENT_PRIVATE;NUM_PLACEMENTS_SELECTED++;}
+       else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_PLACEMENT");}
+       p=q;
+     }while(p!=NULL);
+   }
+   NUM_RESULTS=NUM_FUNCTIONS*NUM_PLACEMENTS_SELECTED;
+
+   p=bi_getenv( "BENCHIT_KERNEL_TIMEOUT", 0 );
+   if (p!=0){
+     TIMEOUT=atoi(p);
+   }
+
+   /* helper threads spin while idle (default) or block after BENCHIT_KERNEL_IDLE_SPIN_TIME microseconds */
+   p=bi_getenv( "BENCHIT_KERNEL_IDLE_POLICY", 0 );
+   if ((p==0)||(!strcmp(p,"spin"))) IDLE_SPIN_TIME=-1;
+   else if (!strcmp(p,"block")){
+     p=bi_getenv( "BENCHIT_KERNEL_IDLE_SPIN_TIME", 0 );
+     if (p!=0) IDLE_SPIN_TIME=atoll(p)*1000;
+     else IDLE_SPIN_TIME=100000;
+     if (IDLE_SPIN_TIME<0) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_SPIN_TIME");}
+   }
+   else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_POLICY (spin|block)");}
+
+   if ( errors > 0 ) {
+      fprintf( stderr, "Error: There's an environment variable not set or invalid!\n" );
+      fprintf( stderr, "%s\n", error_msg);
+      exit( 1 );
+   }
+   free(error_msg);
+}
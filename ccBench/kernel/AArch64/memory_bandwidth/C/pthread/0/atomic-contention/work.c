@@ -0,0 +1,315 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures throughput of atomic operations on shared and private cache lines for 1 to N threads.
+ ******************************************************************************************************/
+
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+/* report average throughput instead of maximum */
+//#define AVERAGE
+
+/** read timestamp counter of the calling CPU
+ */
+static inline unsigned long long timestamp(void)
+{
+   unsigned long long ts;
+
+   __asm__ __volatile__(
+                TIMESTAMP
+		: "=r"(ts)
+   );
+   return ts;
+}
+
+/*
+ * all variants increment the counter at addr n times without memory ordering constraints
+ * (as used for statistics counters and reference count increments)
+ */
+
+/** LSE atomic add
+ */
+static void asm_atomic_ldadd(unsigned long long addr, unsigned long long n) __attribute__((noinline));
+static void asm_atomic_ldadd(unsigned long long addr, unsigned long long n)
+{
+   unsigned long long a,one=1;
+
+     /*
+      * Input:  %3: addr (pointer to the counter)
+      *         %2: increment
+      * Output: %0: temp (old value)
+      */
+     __asm__ __volatile__(
+                LSE_ARCH
+                ".align 6\n\t"
+                "_work_loop_ldadd:\n\t"
+                "ldadd %2,%0,[%3]\n\t"
+                "subs %1,%1,#1\n\t"
+                "bne _work_loop_ldadd\n\t"
+		: "=&r"(a),"+r"(n)
+                : "r"(one),"r"(addr)
+                : "cc","memory"
+     );
+}
+
+/** LSE compare and swap loop: read value, try to replace it by value+1, retry with the returned value on failure
+ */
+static void asm_atomic_cas(unsigned long long addr, unsigned long long n) __attribute__((noinline));
+static void asm_atomic_cas(unsigned long long addr, unsigned long long n)
+{
+   unsigned long long a,b,c;
+
+     /*
+      * Input:  %4: addr (pointer to the counter)
+      * Output: %0: temp (expected / returned value)
+      *         %1: temp (new value)
+      *         %2: temp (copy of expected value)
+      */
+     __asm__ __volatile__(
+                LSE_ARCH
+                "ldr %0,[%4]\n\t"
+                ".align 6\n\t"
+                "_work_loop_cas:\n\t"
+                "add %1,%0,#1\n\t"
+                "mov %2,%0\n\t"
+                "cas %0,%1,[%4]\n\t"
+                "cmp %0,%2\n\t"
+                "bne _work_loop_cas\n\t"
+                "mov %0,%1\n\t"
+                "subs %3,%3,#1\n\t"
+                "bne _work_loop_cas\n\t"
+		: "=&r"(a),"=&r"(b),"=&r"(c),"+r"(n)
+                : "r"(addr)
+                : "cc","memory"
+     );
+}
+
+/** LSE swap (stores the loop counter, the value of the counter is not preserved)
+ */
+static void asm_atomic_swp(unsigned long long addr, unsigned long long n) __attribute__((noinline));
+static void asm_atomic_swp(unsigned long long addr, unsigned long long n)
+{
+   unsigned long long a;
+
+     /*
+      * Input:  %2: addr (pointer to the counter)
+      * Output: %0: temp (old value)
+      */
+     __asm__ __volatile__(
+                LSE_ARCH
+                ".align 6\n\t"
+                "_work_loop_swp:\n\t"
+                "swp %1,%0,[%2]\n\t"
+                "subs %1,%1,#1\n\t"
+                "bne _work_loop_swp\n\t"
+		: "=&r"(a),"+r"(n)
+                : "r"(addr)
+                : "cc","memory"
+     );
+}
+
+/** load-exclusive / store-exclusive loop (LL/SC), retry if the exclusive store fails
+ */
+static void asm_atomic_ldxr_stxr(unsigned long long addr, unsigned long long n) __attribute__((noinline));
+static void asm_atomic_ldxr_stxr(unsigned long long addr, unsigned long long n)
+{
+   unsigned long long a,b;
+
+     /*
+      * Input:  %3: addr (pointer to the counter)
+      * Output: %0: temp (value)
+      *         %1: temp (status of exclusive store)
+      */
+     __asm__ __volatile__(
+                ".align 6\n\t"
+                "_work_loop_ldxr_stxr:\n\t"
+                "ldxr %0,[%3]\n\t"
+                "add %0,%0,#1\n\t"
+                "stxr %w1,%0,[%3]\n\t"
+                "cbnz %w1,_work_loop_ldxr_stxr\n\t"
+                "subs %2,%2,#1\n\t"
+                "bne _work_loop_ldxr_stxr\n\t"
+		: "=&r"(a),"=&r"(b),"+r"(n)
+                : "r"(addr)
+                : "cc","memory"
+     );
+}
+
+/** perform n operations of the selected variant
+ */
+static void atomic_ops(int function, unsigned long long addr, unsigned long long n)
+{
+   switch(function){
+     case FUNC_LDADD:     asm_atomic_ldadd(addr,n);break;
+     case FUNC_CAS:       asm_atomic_cas(addr,n);break;
+     case FUNC_SWP:       asm_atomic_swp(addr,n);break;
+     case FUNC_LDXR_STXR: asm_atomic_ldxr_stxr(addr,n);break;
+     default: break;
+   }
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - threads 0 to num_threads-1 perform atomic operations for duration cycles (measured by the master thread)
+ *   - PLACEMENT_SHARED: all threads use the same counter, located in memory of the master thread
+ *   - PLACEMENT_PRIVATE: every thread uses its own counter in a separate cache line
+ *   - (*results)[0]: operations of all threads per cycle
+ */
+void _work(int num_threads, int function, int placement, unsigned long long duration, int runs, volatile mydata_t* data, double **results)
+{
+  int i,t;
+  unsigned long long start,end,ops;
+  double tmax,tmp;
+
+  if (num_threads>data->num_threads) num_threads=data->num_threads;
+  data->active_threads=num_threads;
+  data->function=function;
+
+  tmax=0;
+
+  for (i=0;i<runs;i++)
+  {
+    /* arm the other threads, they receive THREAD_ATOMIC and wait for the go signal */
+    data->go=0;
+    for (t=1;t<num_threads;t++){
+       if (placement==PLACEMENT_SHARED) data->threaddata[t].counter_addr=(unsigned long long)(data->shared_area);
+       else data->threaddata[t].counter_addr=(unsigned long long)(data->threaddata[t].private_area);
+       data->threaddata[t].ops=0;
+       data->threaddata[t].running=0;
+    }
+    asm volatile ("dmb sy\n\t" : : : "memory");
+    for (t=1;t<num_threads;t++) mailbox_post(&(data->mailbox[t]),THREAD_ATOMIC);
+
+    ops=0;
+    start=timestamp();
+    data->go=1;
+    do{
+      if (placement==PLACEMENT_SHARED) atomic_ops(function,(unsigned long long)(data->shared_area),ATOMIC_CHUNK);
+      else atomic_ops(function,(unsigned long long)(data->private_area),ATOMIC_CHUNK);
+      ops+=ATOMIC_CHUNK;
+    } while ((timestamp()-start)<duration);
+
+    /* make sure that all threads have seen the go signal before stopping them */
+    for (t=1;t<num_threads;t++){
+       while (!data->threaddata[t].running);
+    }
+    data->go=0;
+    /* the threads finish their current chunk and store their operation count before they clear running,
+     * so all counted operations are completed before the end timestamp */
+    for (t=1;t<num_threads;t++){
+       while (data->threaddata[t].running);
+    }
+    end=timestamp();
+
+    for (t=1;t<num_threads;t++){
+       mailbox_wait(&(data->mailbox[t]));
+       ops+=data->threaddata[t].ops;
+    }
+
+    tmp=(double)ops/(double)(end-start);
+
+    // discard first iteration if more than 1 runs are performed
+    if ((i>0)||(runs==1))
+    {
+     #ifdef AVERAGE
+       tmax+=tmp;
+     #else
+       if (tmp>tmax) tmax=tmp;
+     #endif
+    }
+  }
+  #ifdef AVERAGE
+  if (runs>1) tmax/=(runs-1);
+  #endif
+
+  if (tmax>0) (*results)[0]=tmax;
+  else (*results)[0]=INVALID_MEASUREMENT;
+}
+
+
+/** loop for additional worker threads
+ *  communicating with master thread using the mailbox protocol (see membench.h)
+ */
+void *thread(void *threaddata)
+{
+  int id= ((threaddata_t *) threaddata)->thread_id;
+  unsigned int numa_node;
+  struct bitmask *numa_bitmask;
+  volatile mydata_t* global_data = ((threaddata_t *) threaddata)->data; //communication
+  threaddata_t* mydata = (threaddata_t*)threaddata;
+  unsigned long long ops;
+
+  mailbox_t *mailbox = &(global_data->mailbox[id]);
+  unsigned int seq=0;
+
+  //wait for THREAD_INIT, allocation is done by all threads in parallel, master waits for completion later on
+  while (mailbox_receive(mailbox,&seq)!=THREAD_INIT) mailbox_idle(mailbox,seq);
+
+  /* private counter is located in memory of the NUMA node selected by BENCHIT_KERNEL_ALLOC */
+  cpu_set(((threaddata_t *) threaddata)->mem_bind);
+  numa_node = numa_node_of_cpu(((threaddata_t *) threaddata)->mem_bind);
+  numa_bitmask = numa_bitmask_alloc((unsigned int) numa_max_possible_node());
+  numa_bitmask = numa_bitmask_clearall(numa_bitmask);
+  numa_bitmask = numa_bitmask_setbit(numa_bitmask, numa_node);
+  numa_set_membind(numa_bitmask);
+  numa_bitmask_free(numa_bitmask);
+
+  mydata->private_area = (char*) _mm_malloc(COUNTER_AREA,COUNTER_AREA);
+  if (mydata->private_area == NULL)
+  {
+    fprintf( stderr, "Error: Allocation of counter failed\n" ); fflush( stderr );
+    exit( 127 );
+  }
+  memset(mydata->private_area,0,COUNTER_AREA);
+
+  mailbox_complete(mailbox,seq);
+
+  cpu_set(((threaddata_t *) threaddata)->cpu_id);
+  while(1)
+  {
+     switch (mailbox_receive(mailbox,&seq)){
+       case THREAD_ATOMIC:
+         while (!global_data->go);
+         mydata->running=1;
+         ops=0;
+         while (global_data->go){
+           atomic_ops(global_data->function,mydata->counter_addr,ATOMIC_CHUNK);
+           ops+=ATOMIC_CHUNK;
+         }
+         mydata->ops=ops;
+         asm volatile ("dmb sy\n\t" : : : "memory");
+         mydata->running=0;
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_WAIT: // no new command
+         mailbox_idle(mailbox,seq);
+         break;
+       case THREAD_STOP: // exit
+       default:
+         if (mydata->private_area!=NULL) _mm_free(mydata->private_area);
+         mailbox_complete(mailbox,seq);
+         pthread_exit(NULL);
+    }
+  }
+}
@@ -0,0 +1,92 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures throughput of atomic operations on shared and private cache lines for 1 to N threads.
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "atomic operation throughput under contention"
+#define CODE_SEQUENCE       "atomic increment of a shared or private counter"
+#define X_AXIS_TEXT         "number of threads"
+#define Y_AXIS_TEXT_1       "operations per second [1/s]"
+#define Y_AXIS_TEXT_2       "cycles per operation per thread"
+
+/* kernel specific thread functions, see membench.h for the common ones */
+#define THREAD_ATOMIC          THREAD_KERNEL
+
+/* atomic operations (BENCHIT_KERNEL_INSTRUCTION) */
+#define FUNC_LDADD     0
+#define FUNC_CAS       1
+#define FUNC_SWP       2
+#define FUNC_LDXR_STXR 3
+#define NUM_FUNCS      4
+
+/* location of the counters (BENCHIT_KERNEL_PLACEMENT) */
+#define PLACEMENT_SHARED  0
+#define PLACEMENT_PRIVATE 1
+#define NUM_PLACEMENTS    2
+
+/* size of the memory area that contains a counter (one cache line, padded to avoid adjacent line prefetches) */
+#define COUNTER_AREA   256
+
+/* number of operations between two checks of the stop condition */
+#define ATOMIC_CHUNK   64
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* shared_area;
+   char* private_area;
+   pthread_t *threads;
+   struct threaddata *threaddata;
+   cpu_info_t *cpuinfo;                                 //40
+   unsigned long long duration;                         //+8
+   unsigned short num_threads;
+   unsigned short active_threads;                       //+4
+   unsigned char function;
+   unsigned char runs;                                  //+2
+   unsigned char padding1[74];                          //+74 = 128
+   unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
+   volatile unsigned short go;                          //+2, starts and stops the atomic operations
+   unsigned char padding2[54];                          //   8+2+54 = 64
+   unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
+} mydata_t;
+
+/* data needed by each thread */
+typedef struct threaddata
+{
+   volatile mydata_t *data;
+   char* private_area;
+   cpu_info_t *cpuinfo;                                 //24
+   volatile unsigned long long counter_addr;            //+8, counter used for the current measurement
+   volatile unsigned long long ops;                     //+8, number of completed operations
+   unsigned int thread_id;
+   unsigned int cpu_id;
+   unsigned int mem_bind;                               //+12
+   volatile unsigned char running;                      //+1, set from go until ops is stored
+   unsigned char padding1[75];                          //+75 = 128
+   unsigned long long end_dummy_cachelines[16];         //avoid prefetching following data
+} threaddata_t;
+
+/* function that performs the measurement for a certain number of threads
+ * (*results)[0]: operations of all threads per cycle */
+void _work(int num_threads, int function, int placement, unsigned long long duration, int runs, volatile mydata_t* data, double **results);
+
+/* loop executed by all threads, except the master thread */
+void *thread(void *threaddata);
+
+#endif
@@ -0,0 +1,228 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures the cost of false sharing depending on the distance between fields updated by different threads.
+ ******************************************************************************************************/
+
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+/* report average throughput instead of maximum */
+//#define AVERAGE
+
+/** read timestamp counter of the calling CPU
+ */
+static inline unsigned long long timestamp(void)
+{
+   unsigned long long ts;
+
+   __asm__ __volatile__(
+                TIMESTAMP
+		: "=r"(ts)
+   );
+   return ts;
+}
+
+/** writer: increments the field at addr n times using plain loads and stores (non-atomic counter update)
+ */
+static void asm_write_field(unsigned long long addr, unsigned long long n) __attribute__((noinline));
+static void asm_write_field(unsigned long long addr, unsigned long long n)
+{
+   unsigned long long a;
+
+     /*
+      * Input:  %2: addr (pointer to the field)
+      * Output: %0: temp (value)
+      */
+     __asm__ __volatile__(
+                ".align 6\n\t"
+                "_work_loop_write_field:\n\t"
+                "ldr %0,[%2]\n\t"
+                "add %0,%0,#1\n\t"
+                "str %0,[%2]\n\t"
+                "subs %1,%1,#1\n\t"
+                "bne _work_loop_write_field\n\t"
+		: "=&r"(a),"+r"(n)
+                : "r"(addr)
+                : "cc","memory"
+     );
+}
+
+/** reader: reads the field at addr n times
+ */
+static void asm_read_field(unsigned long long addr, unsigned long long n) __attribute__((noinline));
+static void asm_read_field(unsigned long long addr, unsigned long long n)
+{
+   unsigned long long a;
+
+     /*
+      * Input:  %2: addr (pointer to the field)
+      * Output: %0: temp (value)
+      */
+     __asm__ __volatile__(
+                ".align 6\n\t"
+                "_work_loop_read_field:\n\t"
+                "ldr %0,[%2]\n\t"
+                "subs %1,%1,#1\n\t"
+                "bne _work_loop_read_field\n\t"
+		: "=&r"(a),"+r"(n)
+                : "r"(addr)
+                : "cc","memory"
+     );
+}
+
+/** perform n accesses of the given role
+ */
+static void access_field(int role, unsigned long long addr, unsigned long long n)
+{
+   if (role==ROLE_WRITER) asm_write_field(addr,n);
+   else asm_read_field(addr,n);
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - thread t accesses the field at field_area+t*distance for duration cycles
+ *     (distance 0: all threads access the same field)
+ *   - every thread measures its own operations per cycle with the cycle counter of its CPU
+ *     (the cycle counters of different CPUs are not synchronized)
+ *   - (*results)[t]: operations of thread t per cycle (values of the run with the highest sum)
+ */
+void _work(unsigned long long distance, unsigned long long duration, int runs, volatile mydata_t* data, double **results)
+{
+  int i,t;
+  unsigned long long start,end,ops;
+  double sum,max_sum;
+
+  max_sum=0;
+  for (t=0;t<data->num_threads;t++) (*results)[t]=0;
+
+  for (i=0;i<runs;i++)
+  {
+    memset(data->field_area,0,data->field_area_size);
+
+    /* arm the other threads, they receive THREAD_ACCESS and wait for the go signal */
+    data->go=0;
+    for (t=1;t<data->num_threads;t++){
+       data->threaddata[t].field_addr=(unsigned long long)(data->field_area+t*distance);
+       data->threaddata[t].ops=0;
+       data->threaddata[t].cycles=0;
+       data->threaddata[t].running=0;
+    }
+    asm volatile ("dmb sy\n\t" : : : "memory");
+    for (t=1;t<data->num_threads;t++) mailbox_post(&(data->mailbox[t]),THREAD_ACCESS);
+
+    ops=0;
+    start=timestamp();
+    data->go=1;
+    do{
+      access_field(data->threaddata[0].role,(unsigned long long)(data->field_area),ACCESS_CHUNK);
+      ops+=ACCESS_CHUNK;
+    } while ((timestamp()-start)<duration);
+    end=timestamp();
+
+    /* make sure that all threads have seen the go signal before stopping them */
+    for (t=1;t<data->num_threads;t++){
+       while (!data->threaddata[t].running);
+    }
+    data->go=0;
+
+    data->threaddata[0].ops=ops;
+    data->threaddata[0].cycles=end-start;
+    for (t=1;t<data->num_threads;t++) mailbox_wait(&(data->mailbox[t]));
+
+    // discard first iteration if more than 1 runs are performed
+    if ((i>0)||(runs==1))
+    {
+     #ifdef AVERAGE
+       for (t=0;t<data->num_threads;t++){
+         if (data->threaddata[t].cycles) (*results)[t]+=(double)data->threaddata[t].ops/(double)data->threaddata[t].cycles;
+       }
+     #else
+       sum=0;
+       for (t=0;t<data->num_threads;t++){
+         if (data->threaddata[t].cycles) sum+=(double)data->threaddata[t].ops/(double)data->threaddata[t].cycles;
+       }
+       if (sum>max_sum){
+         max_sum=sum;
+         for (t=0;t<data->num_threads;t++){
+           if (data->threaddata[t].cycles) (*results)[t]=(double)data->threaddata[t].ops/(double)data->threaddata[t].cycles;
+           else (*results)[t]=INVALID_MEASUREMENT;
+         }
+       }
+     #endif
+    }
+  }
+  #ifdef AVERAGE
+  if (runs>1) for (t=0;t<data->num_threads;t++) (*results)[t]/=(runs-1);
+  #endif
+
+  for (t=0;t<data->num_threads;t++){
+    if ((*results)[t]<=0) (*results)[t]=INVALID_MEASUREMENT;
+  }
+}
+
+
+/** loop for additional worker threads
+ *  communicating with master thread using the mailbox protocol (see membench.h)
+ */
+void *thread(void *threaddata)
+{
+  int id= ((threaddata_t *) threaddata)->thread_id;
+  volatile mydata_t* global_data = ((threaddata_t *) threaddata)->data; //communication
+  threaddata_t* mydata = (threaddata_t*)threaddata;
+  unsigned long long ops,start;
+
+  mailbox_t *mailbox = &(global_data->mailbox[id]);
+  unsigned int seq=0;
+
+  while (mailbox_receive(mailbox,&seq)!=THREAD_INIT) mailbox_idle(mailbox,seq);
+
+  cpu_set(((threaddata_t *) threaddata)->cpu_id);
+  mailbox_complete(mailbox,seq);
+
+  while(1)
+  {
+     switch (mailbox_receive(mailbox,&seq)){
+       case THREAD_ACCESS:
+         while (!global_data->go);
+         mydata->running=1;
+         ops=0;
+         start=timestamp();
+         while (global_data->go){
+           access_field(mydata->role,mydata->field_addr,ACCESS_CHUNK);
+           ops+=ACCESS_CHUNK;
+         }
+         mydata->cycles=timestamp()-start;
+         mydata->ops=ops;
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_WAIT: // no new command
+         mailbox_idle(mailbox,seq);
+         break;
+       case THREAD_STOP: // exit
+       default:
+         mailbox_complete(mailbox,seq);
+         pthread_exit(NULL);
+    }
+  }
+}
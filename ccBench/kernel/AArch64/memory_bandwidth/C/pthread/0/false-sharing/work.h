@@ -0,0 +1,82 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures the cost of false sharing depending on the distance between fields updated by different threads.
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "false sharing cost"
+#define CODE_SEQUENCE       "increment (writers) or read (readers) field at thread_id*distance"
+#define X_AXIS_TEXT         "distance between fields [Byte]"
+#define Y_AXIS_TEXT_1       "operations per second [1/s]"
+
+/* kernel specific thread functions, see membench.h for the common ones */
+#define THREAD_ACCESS          THREAD_KERNEL
+
+/* role of a thread */
+#define ROLE_READER    0
+#define ROLE_WRITER    1
+
+/* size of the fields (64 Bit counters) */
+#define FIELD_SIZE     8
+
+/* number of operations between two checks of the stop condition */
+#define ACCESS_CHUNK   64
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* field_area;
+   pthread_t *threads;
+   struct threaddata *threaddata;
+   cpu_info_t *cpuinfo;                                 //32
+   unsigned long long duration;                         //+8
+   unsigned long long field_area_size;                  //+8
+   unsigned short num_threads;
+   unsigned short num_writers;                          //+4
+   unsigned char runs;                                  //+1
+   unsigned char padding1[75];                          //+75 = 128
+   unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
+   volatile unsigned short go;                          //+2, starts and stops the accesses
+   unsigned char padding2[54];                          //   8+2+54 = 64
+   unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
+} mydata_t;
+
+/* data needed by each thread */
+typedef struct threaddata
+{
+   volatile mydata_t *data;
+   cpu_info_t *cpuinfo;                                 //16
+   volatile unsigned long long field_addr;              //+8, field used for the current measurement
+   volatile unsigned long long ops;                     //+8, number of completed operations
+   volatile unsigned long long cycles;                  //+8, duration of the measurement on this CPU
+   unsigned int thread_id;
+   unsigned int cpu_id;                                 //+8
+   unsigned char role;
+   volatile unsigned char running;                      //+2
+   unsigned char padding1[78];                          //+78 = 128
+   unsigned long long end_dummy_cachelines[16];         //avoid prefetching following data
+} threaddata_t;
+
+/* function that performs the measurement for a certain distance between the fields
+ * (*results)[t]: operations of thread t per cycle */
+void _work(unsigned long long distance, unsigned long long duration, int runs, volatile mydata_t* data, double **results);
+
+/* loop executed by all threads, except the master thread */
+void *thread(void *threaddata);
+
+#endif
@@ -0,0 +1,550 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *****************************************************************************************************/
+/* Kernel: measures random read-modify-write update rate (RandomAccess / GUPS) for different table sizes.
+ *****************************************************************************************************/
+#define _GNU_SOURCE
+#include <sched.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <signal.h>
+#include <unistd.h>
+#include "interface.h"
+#include "tools/hw_detect/cpu.h"
+
+
+/*  Header for local functions */
+#include "work.h"
+
+
+/* number of functions (needed by BenchIT Framework, see bi_getinfo()) */
+int n_of_works;
+int n_of_sure_funcs_per_work;
+
+/* variables to store settings from PARAMETERS file
+ * parsed by evaluate_environment() function */
+int RUNS=0,NUM_RESULTS=0,TIMEOUT=0,NUM_THREADS=0;
+/* idle policy of the helper threads, spin time in ns before blocking (-1: spin only), derived from IDLE_POLICY and IDLE_SPIN_TIME in PARAMETERS file */
+long long IDLE_SPIN_TIME=-1;
+unsigned long long UPDATES=0,MAX=0;
+
+/* selected thread counts, batch sizes, and table placements, derived from THREADS, BATCH, and PLACEMENT in PARAMETERS file */
+int thread_counts[MAX_THREAD_COUNTS],NUM_THREAD_COUNTS=0;
+int batches[MAX_BATCHES],NUM_BATCHES=0;
+int placements[MAX_PLACEMENTS],NUM_PLACEMENTS=0;
+
+/* list of table sizes */
+bi_list_t * problemlist;
+unsigned long long problemlistsize;
+double *problemarray1;
+
+/* string used for error message */
+char *error_msg=NULL;
+
+/* CPU bindings of threads, derived from CPU_LIST in PARAMETERS file */
+cpu_set_t cpuset;
+unsigned long long *cpu_bind;
+
+/* data structure for hardware detection */
+static cpu_info_t *cpuinfo=NULL;
+
+/* needed to derive elapsed time from clock cycles, determined by hw_detect */
+unsigned long long FREQUENCY=0;
+
+/* data structure that holds all relevant information for kernel execution */
+volatile mydata_t* mdp;
+
+/* data for watchdog timer */
+pthread_t watchdog;
+typedef struct watchdog_args{
+ pid_t pid;
+ int timeout;
+} watchdog_arg_t;
+watchdog_arg_t watchdog_arg;
+
+/* stops watchdog thread if benchmark finishes before timeout */
+static void sigusr1_handler (int signum) {
+ pthread_exit(0);
+}
+
+/** stops benchmark if timeout is reached
+ */
+static void *watchdog_timer(void *arg){
+  sigset_t  signal_mask;
+
+  /* ignore SIGTERM and SIGINT */
+  sigemptyset (&signal_mask);
+  sigaddset (&signal_mask, SIGINT);
+  sigaddset (&signal_mask, SIGTERM);
+  pthread_sigmask (SIG_BLOCK, &signal_mask, NULL);
+
+  /* watchdog thread will terminate after receiveing SIGUSR1 during bi_cleanup() */
+  signal(SIGUSR1,sigusr1_handler);
+
+  if (((watchdog_arg_t*)arg)->timeout>0){
+     /* sleep for specified timeout before terminating benchmark */
+     sleep(((watchdog_arg_t*)arg)->timeout);
+     kill(((watchdog_arg_t*)arg)->pid,SIGTERM);
+  }
+  pthread_exit(0);
+}
+
+/** function that parses the PARAMETERS file
+ */
+void evaluate_environment(bi_info * info);
+
+/**  The implementation of the bi_getinfo() from the BenchIT interface.
+ *   Infostruct is filled with informations about the kernel.
+ *   @param infostruct  a pointer to a structure filled with zero's
+ */
+void bi_getinfo( bi_info * infostruct )
+{
+   int i = 0, j = 0; /* loop var for n_of_works */
+   char buff[512];
+   (void) memset ( infostruct, 0, sizeof( bi_info ) );
+   /* get environment variables for the kernel */
+   evaluate_environment(infostruct);
+   infostruct->codesequence = bi_strdup( CODE_SEQUENCE );
+   infostruct->xaxistext = bi_strdup( X_AXIS_TEXT );
+   infostruct->base_xaxis=10.0;
+   infostruct->maxproblemsize=problemlistsize;
+   sprintf(buff, KERNEL_DESCRIPTION);
+   infostruct->kerneldescription = bi_strdup( buff );
+   infostruct->num_processes = 1;
+   infostruct->num_threads_per_process = NUM_THREADS;
+   infostruct->kernel_execs_mpi1 = 0;
+   infostruct->kernel_execs_mpi2 = 0;
+   infostruct->kernel_execs_pvm = 0;
+   infostruct->kernel_execs_omp = 0;
+   infostruct->kernel_execs_pthreads = 1;
+
+   /* updates per second */
+   n_of_works = 1;
+
+   /* one curve for every combination of thread count, batch size, and placement */
+   n_of_sure_funcs_per_work = NUM_RESULTS;
+
+   infostruct->numfunctions = n_of_works * n_of_sure_funcs_per_work;
+
+   /* allocating memory for y axis texts and properties */
+   infostruct->yaxistexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->yaxistexts == 0 ){
+     fprintf( stderr, "Allocation of yaxistexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->outlier_direction_upwards = malloc( infostruct->numfunctions * sizeof( int ));
+   if ( infostruct->outlier_direction_upwards == 0 ){
+     fprintf( stderr, "Allocation of outlier direction failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->legendtexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->legendtexts == 0 ){
+     fprintf( stderr, "Allocation of legendtexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->base_yaxis = malloc( infostruct->numfunctions * sizeof( double ));
+   if ( infostruct->base_yaxis == 0 ){
+     fprintf( stderr, "Allocation of base yaxis failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+
+   /* setting up y axis texts and properties */
+   for ( j = 0; j < n_of_works; j++ ){
+     int k,index;
+      for (k=0;k<n_of_sure_funcs_per_work;k++)
+      {
+
+        int c,b,l;
+        char placement[64];
+
+        index= k + n_of_sure_funcs_per_work * j;
+        c = k / (NUM_BATCHES*NUM_PLACEMENTS);
+        b = (k / NUM_PLACEMENTS) % NUM_BATCHES;
+        l = k % NUM_PLACEMENTS;
+        if (placements[l]==PLACEMENT_LOCAL) sprintf(placement,"local");
+        else if (placements[l]==PLACEMENT_INTERLEAVE) sprintf(placement,"interleaved");
+        else sprintf(placement,"node %i",placements[l]);
+        infostruct->base_yaxis[index] = 0;
+        sprintf(buff,"%i thread%s, batch %i, %s (updates per second)",thread_counts[c],(thread_counts[c]>1)?"s":"",batches[b],placement);
+        infostruct->legendtexts[index] = bi_strdup( buff );
+        infostruct->outlier_direction_upwards[index] = 0;  //report maximum of iterations
+        infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_1 );
+      }
+   }
+}
+
+/** Implementation of the bi_init() of the BenchIT interface.
+ *  init data structures needed for kernel execution
+ */
+void* bi_init( int problemsizemax )
+{
+   int t;
+   unsigned long long i;
+
+   cpu_set(cpu_bind[0]); /* first thread binds to first CPU in list */
+
+   mdp->cpuinfo=cpuinfo;
+
+   /* overwrite detected clockrate if specified in PARAMETERS file*/
+   if (FREQUENCY){
+      mdp->cpuinfo->clockrate=FREQUENCY;
+   }
+   else if (mdp->cpuinfo->clockrate==0){
+      fprintf( stderr, "Error: CPU-Clockrate could not be estimated\n" );
+      exit( 1 );
+   }
+
+   mdp->updates=UPDATES;
+   mdp->runs=RUNS;
+   mdp->num_threads=NUM_THREADS;
+   mdp->threads=_mm_malloc(NUM_THREADS*sizeof(pthread_t),64);
+   mdp->mailbox=_mm_malloc(NUM_THREADS*sizeof(mailbox_t),sizeof(mailbox_t));
+   mdp->threaddata = _mm_malloc(mdp->num_threads*sizeof(threaddata_t),64);
+   if ((mdp->threads==NULL)||(mdp->mailbox==NULL)||(mdp->threaddata==NULL)){
+     fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   memset( mdp->threaddata,0,mdp->num_threads*sizeof(threaddata_t));
+   memset(mdp->mailbox,0,NUM_THREADS*sizeof(mailbox_t));
+   for (i=0;i<NUM_THREADS;i++) mdp->mailbox[i].spin_time=IDLE_SPIN_TIME;
+
+  /* create threads */
+  for (t=1;t<mdp->num_threads;t++){
+    mdp->threaddata[t].cpuinfo=(cpu_info_t*)_mm_malloc( sizeof( cpu_info_t ),64);
+    if ( mdp->threaddata[t].cpuinfo == 0 ){
+      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+      exit( 127 );
+    }
+    memcpy(mdp->threaddata[t].cpuinfo,mdp->cpuinfo,sizeof(cpu_info_t));
+    mdp->threaddata[t].thread_id=t;
+    mdp->threaddata[t].cpu_id=cpu_bind[t];
+    mdp->threaddata[t].data=mdp;
+    mailbox_post(&(mdp->mailbox[t]),THREAD_INIT);
+    pthread_create(&(mdp->threads[t]),NULL,thread,(void*)(&(mdp->threaddata[t])));
+  }
+
+  /* allocate tables, the largest table size is used for all placements */
+  mdp->table_size=(MAX+sizeof(unsigned long long)-1)&~(sizeof(unsigned long long)-1);
+  for (t=0;t<NUM_PLACEMENTS;t++){
+     if (placements[t]==PLACEMENT_INTERLEAVE) mdp->table[t] = (char*) numa_alloc_interleaved(mdp->table_size);
+     else if (placements[t]==PLACEMENT_LOCAL) mdp->table[t] = (char*) numa_alloc_onnode(mdp->table_size,numa_node_of_cpu(cpu_bind[0]));
+     else mdp->table[t] = (char*) numa_alloc_onnode(mdp->table_size,placements[t]);
+     if (mdp->table[t] == 0){
+        fprintf( stderr, "Error: Allocation of table failed\n" ); fflush( stderr );
+        exit( 127 );
+     }
+     /* touch all pages */
+     memset(mdp->table[t],0,mdp->table_size);
+  }
+
+  cpu_set(cpu_bind[0]);
+  printf("  wait for threads initialization \n");fflush(stdout);
+  /* wait for threads to finish their initialization */
+  for (t=1;t<mdp->num_threads;t++) mailbox_wait(&(mdp->mailbox[t]));
+  printf("    ...done\n");
+  if ((num_packages()!=-1)&&(num_cores_per_package()!=-1)&&(num_threads_per_core()!=-1))  printf("  num_packages: %i, %i cores per package, %i threads per core\n",num_packages(),num_cores_per_package(),num_threads_per_core());
+  printf("  using up to %i threads, %llu updates per thread\n",NUM_THREADS,UPDATES);
+  for (i=0;i<NUM_THREADS;i++) if ((get_pkg(cpu_bind[i])!=-1)&&(get_core_id(cpu_bind[i])!=-1)) printf("    - Thread %llu runs on CPU %llu, core %i in package: %i\n",i,cpu_bind[i],get_core_id(cpu_bind[i]),get_pkg(cpu_bind[i]));
+  fflush(stdout);
+
+
+  /* start watchdog thread */
+  watchdog_arg.pid=getpid();
+  watchdog_arg.timeout=TIMEOUT;
+  pthread_create(&watchdog,NULL,watchdog_timer,&watchdog_arg);
+
+  return (void*)mdp;
+}
+
+/** The central function within each kernel. This function
+ *  is called for each measurment step seperately.
+ *  @param  mdpv         a pointer to the structure created in bi_init,
+ *                       it is the pointer the bi_init returns
+ *  @param  problemsize  the actual problemsize
+ *  @param  results      a pointer to a field of doubles, the
+ *                       size of the field depends on the number
+ *                       of functions, there are #functions+1
+ *                       doubles
+ *  @return 0 if the measurment was sucessfull, something
+ *          else in the case of an error
+ */
+int inline bi_entry( void* mdpv, int problemsize, double* results )
+{
+  /* c,b,l are used for loop iterations */
+  int c = 0, b = 0, l = 0, k = 0;
+  /* table size */
+  unsigned long long table_size;
+  /* cast void* pointer */
+  mydata_t* mdp = (mydata_t*)mdpv;
+
+  /* results */
+  double *tmp_results;
+
+  /* check wether the pointer to store the results in is valid or not */
+  if ( results == NULL ) return 1;
+
+  tmp_results=_mm_malloc(sizeof(double),64);
+
+  table_size = ((unsigned long long) problemarray1[problemsize-1])&~(sizeof(unsigned long long)-1);
+  if (table_size<sizeof(unsigned long long)) table_size=sizeof(unsigned long long);
+  results[0] = (double)table_size;
+
+  for (c=0;c<NUM_THREAD_COUNTS;c++)
+  {
+    for (b=0;b<NUM_BATCHES;b++)
+    {
+      for (l=0;l<NUM_PLACEMENTS;l++)
+      {
+        k=(c*NUM_BATCHES+b)*NUM_PLACEMENTS+l;
+
+        /* measure updates of all threads per cycle */
+        _work(table_size,thread_counts[c],batches[b],l,RUNS,mdp,&tmp_results);
+
+        if (tmp_results[0]==INVALID_MEASUREMENT) results[1+k]=INVALID_MEASUREMENT;
+        else results[1+k]=tmp_results[0]*(double)mdp->cpuinfo->clockrate;
+      }
+    }
+  }
+
+  _mm_free(tmp_results);
+  return 0;
+}
+
+/** Clean up the memory
+ */
+void bi_cleanup( void* mdpv )
+{
+   int t;
+
+   mydata_t* mdp = (mydata_t*)mdpv;
+   /* terminate other threads */
+   for (t=1;t<mdp->num_threads;t++) mailbox_post(&(mdp->mailbox[t]),THREAD_STOP);
+   for (t=1;t<mdp->num_threads;t++) pthread_join((mdp->threads[t]),NULL);
+   if (mdp->mailbox) mailbox_report(mdp->mailbox,mdp->num_threads);
+   pthread_kill(watchdog,SIGUSR1);
+
+   /* free resources */
+   for (t=0;t<NUM_PLACEMENTS;t++){
+      if (mdp->table[t]) numa_free(mdp->table[t],mdp->table_size);
+   }
+   if (mdp->threaddata){
+     for (t=1;t<mdp->num_threads;t++){
+        if (mdp->threaddata[t].cpuinfo) _mm_free(mdp->threaddata[t].cpuinfo);
+     }
+     _mm_free(mdp->threaddata);
+   }
+   if (mdp->threads) _mm_free(mdp->threads);
+   if (mdp->mailbox) _mm_free(mdp->mailbox);
+   if (mdp->cpuinfo) _mm_free(mdp->cpuinfo);
+   _mm_free( mdp );
+   return;
+}
+
+/********************************************************************/
+/*************** End of interface implementations *******************/
+/********************************************************************/
+
+/* Reads the environment variables used by this kernel. */
+void evaluate_environment(bi_info * info)
+{
+   int i;
+   int errors = 0;
+   char * p = 0;
+
+   cpuinfo=(cpu_info_t*)_mm_malloc( sizeof( cpu_info_t ),64);memset((void*)cpuinfo,0,sizeof( cpu_info_t ));
+   if ( cpuinfo == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure cpuinfo_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+   init_cpuinfo(cpuinfo,1);
+
+   mdp = (mydata_t*)_mm_malloc( sizeof( mydata_t ),64);memset((void*)mdp,0, sizeof( mydata_t ));
+   if ( mdp == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+
+   error_msg=malloc(256);
+
+   /* generate ordered list of table sizes in problemarray1*/
+   p = bi_getenv( "BENCHIT_KERNEL_PROBLEMLIST", 0 );
+   if ( p == 0 ){
+     unsigned long long MIN;
+     int STEPS;
+     double MemFactor;
+     p = bi_getenv("BENCHIT_KERNEL_MIN",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MIN not set");}
+     else MIN=atoll(p);
+     p = bi_getenv("BENCHIT_KERNEL_MAX",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MAX not set");}
+     else MAX=atoll(p);
+     p = bi_getenv("BENCHIT_KERNEL_STEPS",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_STEPS not set");}
+     else STEPS=atoi(p);
+     if ( errors == 0){
+       problemarray1=malloc(STEPS*sizeof(double));
+       MemFactor =((double)MAX)/((double)MIN);
+       MemFactor = pow(MemFactor, 1.0/((double)STEPS-1));
+       for (i=0;i<STEPS;i++){
+          problemarray1[i] = ((double)MIN)*pow(MemFactor, i);
+       }
+       problemlistsize=STEPS;
+       problemarray1[STEPS-1]=(double)MAX;
+     }
+   }
+   else{
+     fflush(stdout);printf("BenchIT: parsing list of problemsizes: ");
+     bi_parselist(p);
+     problemlist = info->list;
+     problemlistsize = info->listsize;
+     problemarray1=malloc(problemlistsize*sizeof(double));
+     for (i=0;i<problemlistsize;i++){
+        problemarray1[i]=problemlist->dnumber;
+        if (problemlist->pnext!=NULL) problemlist=problemlist->pnext;
+        if (problemarray1[i]>MAX) MAX=problemarray1[i];
+     }
+   }
+
+   CPU_ZERO(&cpuset);NUM_THREADS=0;
+   if (bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 ));else p=NULL;
+   if (p){
+     char *q,*r,*s;
+     i=0;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       s=strstr(p,"/");if (s) {*s='\0';s++;}
+       r=strstr(p,"-");if (r) {*r='\0';r++;}
+
+       if ((s)&&(r)) for (i=atoi(p);i<=atoi(r);i+=atoi(s)) {if (cpu_allowed(i)) {CPU_SET(i,&cpuset);NUM_THREADS++;}}
+       else if (r) for (i=atoi(p);i<=atoi(r);i++) {if (cpu_allowed(i)) {CPU_SET(i,&cpuset);NUM_THREADS++;}}
+       else if (cpu_allowed(atoi(p))) {CPU_SET(atoi(p),&cpuset);NUM_THREADS++;}
+       p=q;
+     }while(p!=NULL);
+   }
+   else { /* use all allowed CPUs if not defined otherwise */
+     for (i=0;i<CPU_SETSIZE;i++) {if (cpu_allowed(i)) {CPU_SET(i,&cpuset);NUM_THREADS++;}}
+   }
+
+   /* bind threads to available cores in specified order */
+   if (NUM_THREADS==0) {errors++;sprintf(error_msg,"no allowed CPUs in BENCHIT_KERNEL_CPU_LIST");}
+   else
+   {
+     int j=0;
+     cpu_bind=(unsigned long long*)malloc((NUM_THREADS+1)*sizeof(unsigned long long));
+     if (bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 ));else p=NULL;
+     if (p)
+     {
+       char *q,*r,*s;
+       i=0;
+       do
+       {
+         q=strstr(p,",");if (q) {*q='\0';q++;}
+         s=strstr(p,"/");if (s) {*s='\0';s++;}
+         r=strstr(p,"-");if (r) {*r='\0';r++;}
+
+         if ((s)&&(r)) for (i=atoi(p);i<=atoi(r);i+=atoi(s)) {if (cpu_allowed(i)) {cpu_bind[j]=i;j++;}}
+         else if (r) for (i=atoi(p);i<=atoi(r);i++) {if (cpu_allowed(i)) {cpu_bind[j]=i;j++;}}
+         else if (cpu_allowed(atoi(p))) {cpu_bind[j]=atoi(p);j++;}
+         p=q;
+       }
+       while(p!=NULL);
+     }
+     else { /* no order specified */
+       for(i=0;i<CPU_SETSIZE;i++){
+        if (CPU_ISSET(i,&cpuset)) {cpu_bind[j]=i;j++;}
+       }
+     }
+   }
+
+   p = bi_getenv( "BENCHIT_KERNEL_CPU_FREQUENCY", 0 );
+   if ( p != 0 ) FREQUENCY = atoll( p );
+
+   if (bi_getenv( "BENCHIT_KERNEL_THREADS", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_THREADS", 0 ));else p=NULL;
+   if (p==0) { /* single-threaded and all CPUs if not defined otherwise */
+     thread_counts[NUM_THREAD_COUNTS++]=1;
+     if (NUM_THREADS>1) thread_counts[NUM_THREAD_COUNTS++]=NUM_THREADS;
+   }
+   else {
+     char *q;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       if (NUM_THREAD_COUNTS==MAX_THREAD_COUNTS) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_THREADS");}
+       else if ((atoi(p)<1)||(atoi(p)>NUM_THREADS)) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_THREADS (1 to number of CPUs)");}
+       else thread_counts[NUM_THREAD_COUNTS++]=atoi(p);
+       p=q;
+     }while(p!=NULL);
+   }
+
+   if (bi_getenv( "BENCHIT_KERNEL_BATCH", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_BATCH", 0 ));else p=NULL;
+   if (p==0) batches[NUM_BATCHES++]=1;
+   else {
+     char *q;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       i=atoi(p);
+       if (NUM_BATCHES==MAX_BATCHES) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_BATCH");}
+       else if ((i==1)||(i==2)||(i==4)||(i==8)||(i==16)) batches[NUM_BATCHES++]=i;
+       else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_BATCH (supported: 1,2,4,8,16)");}
+       p=q;
+     }while(p!=NULL);
+   }
+
+   if (bi_getenv( "BENCHIT_KERNEL_PLACEMENT", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_PLACEMENT", 0 ));else p=NULL;
+   if (p==0) placements[NUM_PLACEMENTS++]=PLACEMENT_LOCAL;
+   else {
+     char *q;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       if (NUM_PLACEMENTS==MAX_PLACEMENTS) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_PLACEMENT");}
+       else if (!strcmp(p,"local")) placements[NUM_PLACEMENTS++]=PLACEMENT_LOCAL;
+       else if (!strcmp(p,"interleave")) placements[NUM_PLACEMENTS++]=PLACEMENT_INTERLEAVE;
+       else if ((*p>='0')&&(*p<='9')&&(atoi(p)<=numa_max_node())) placements[NUM_PLACEMENTS++]=atoi(p);
+       else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_PLACEMENT");}
+       p=q;
+     }while(p!=NULL);
+   }
+   NUM_RESULTS=NUM_THREAD_COUNTS*NUM_BATCHES*NUM_PLACEMENTS;
+
+   p = bi_getenv( "BENCHIT_KERNEL_UPDATES", 0 );
+   if ( p != 0 ) UPDATES = atoll( p );
+   if (UPDATES==0) UPDATES=1048576;
+
+   p = bi_getenv( "BENCHIT_KERNEL_RUNS", 0 );
+   if ( p != 0 ) RUNS = atoi( p );
+   if (RUNS<1) RUNS=1;
+
+   p=bi_getenv( "BENCHIT_KERNEL_TIMEOUT", 0 );
+   if (p!=0){
+     TIMEOUT=atoi(p);
+   }
+
+   /* helper threads spin while idle (default) or block after BENCHIT_KERNEL_IDLE_SPIN_TIME microseconds */
+   p=bi_getenv( "BENCHIT_KERNEL_IDLE_POLICY", 0 );
+   if ((p==0)||(!strcmp(p,"spin"))) IDLE_SPIN_TIME=-1;
+   else if (!strcmp(p,"block")){
+     p=bi_getenv( "BENCHIT_KERNEL_IDLE_SPIN_TIME", 0 );
+     if (p!=0) IDLE_SPIN_TIME=atoll(p)*1000;
+     else IDLE_SPIN_TIME=100000;
+     if (IDLE_SPIN_TIME<0) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_SPIN_TIME");}
+   }
+   else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_POLICY (spin|block)");}
+
+   if ( errors > 0 ) {
+      fprintf( stderr, "Error: There's an environment variable not set or invalid!\n" );
+      fprintf( stderr, "%s\n", error_msg);
+      exit( 1 );
+   }
+   free(error_msg);
+}
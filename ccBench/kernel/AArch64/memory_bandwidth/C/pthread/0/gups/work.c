@@ -0,0 +1,411 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures random read-modify-write update rate (RandomAccess / GUPS) for different table sizes.
+ ******************************************************************************************************/
+
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+/* report average update rate instead of maximum */
+//#define AVERAGE
+
+/** read timestamp counter of the calling CPU
+ */
+static inline unsigned long long timestamp(void)
+{
+   unsigned long long ts;
+
+   __asm__ __volatile__(
+                TIMESTAMP
+		: "=r"(ts)
+   );
+   return ts;
+}
+
+/*
+ * one update of lane xR (HPCC RandomAccess):
+ *   ran = (ran << 1) ^ ((long long) ran < 0 ? POLY : 0)
+ *   table[(ran * elements) >> 64] ^= ran
+ * register usage: x1-x16: lanes (independent random number generators), x19: temp (index), x20: POLY,
+ *                 x21: number of elements, x22: temp (value), x23: table, x24: lanes, x25: iterations
+ */
+#define GUPS_UPDATE(r) \
+                "asr x19,x" #r ",#63\n\t" \
+                "and x19,x19,x20\n\t" \
+                "eor x" #r ",x19,x" #r ",lsl #1\n\t" \
+                "umulh x19,x" #r ",x21\n\t" \
+                "ldr x22,[x23,x19,lsl #3]\n\t" \
+                "eor x22,x22,x" #r "\n\t" \
+                "str x22,[x23,x19,lsl #3]\n\t"
+
+/* load / store state of lane xR from / to lanes[r-1] */
+#define LANE_LOAD(r,offset)  "ldr x" #r ",[x24,#" #offset "]\n\t"
+#define LANE_STORE(r,offset) "str x" #r ",[x24,#" #offset "]\n\t"
+
+#define GUPS_SETUP \
+                "mov x23,%0\n\t" \
+                "mov x21,%1\n\t" \
+                "mov x24,%2\n\t" \
+                "mov x25,%3\n\t" \
+                "mov x20,#7\n\t"
+
+/** 1 independent update stream per loop iteration
+ */
+static void asm_gups_1(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations) __attribute__((noinline));
+static void asm_gups_1(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations)
+{
+   if (!iterations) return;
+     /*
+      * Input:  %0: table, %1: number of elements, %2: lanes, %3: iterations
+      */
+     __asm__ __volatile__(
+                GUPS_SETUP
+                LANE_LOAD(1,0)
+                ".align 6\n\t"
+                "_work_loop_gups_1:\n\t"
+                GUPS_UPDATE(1)
+                "subs x25,x25,#1\n\t"
+                "bne _work_loop_gups_1\n\t"
+                LANE_STORE(1,0)
+                :
+                : "r"(table),"r"(elements),"r"(lanes),"r"(iterations)
+                : "x1","x19","x20","x21","x22","x23","x24","x25","cc","memory"
+     );
+}
+
+/** 2 independent update streams per loop iteration
+ */
+static void asm_gups_2(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations) __attribute__((noinline));
+static void asm_gups_2(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations)
+{
+   if (!iterations) return;
+     /*
+      * Input:  %0: table, %1: number of elements, %2: lanes, %3: iterations
+      */
+     __asm__ __volatile__(
+                GUPS_SETUP
+                LANE_LOAD(1,0)
+                LANE_LOAD(2,8)
+                ".align 6\n\t"
+                "_work_loop_gups_2:\n\t"
+                GUPS_UPDATE(1)
+                GUPS_UPDATE(2)
+                "subs x25,x25,#1\n\t"
+                "bne _work_loop_gups_2\n\t"
+                LANE_STORE(1,0)
+                LANE_STORE(2,8)
+                :
+                : "r"(table),"r"(elements),"r"(lanes),"r"(iterations)
+                : "x1","x2","x19","x20","x21","x22","x23","x24","x25","cc","memory"
+     );
+}
+
+/** 4 independent update streams per loop iteration
+ */
+static void asm_gups_4(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations) __attribute__((noinline));
+static void asm_gups_4(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations)
+{
+   if (!iterations) return;
+     /*
+      * Input:  %0: table, %1: number of elements, %2: lanes, %3: iterations
+      */
+     __asm__ __volatile__(
+                GUPS_SETUP
+                LANE_LOAD(1,0)
+                LANE_LOAD(2,8)
+                LANE_LOAD(3,16)
+                LANE_LOAD(4,24)
+                ".align 6\n\t"
+                "_work_loop_gups_4:\n\t"
+                GUPS_UPDATE(1)
+                GUPS_UPDATE(2)
+                GUPS_UPDATE(3)
+                GUPS_UPDATE(4)
+                "subs x25,x25,#1\n\t"
+                "bne _work_loop_gups_4\n\t"
+                LANE_STORE(1,0)
+                LANE_STORE(2,8)
+                LANE_STORE(3,16)
+                LANE_STORE(4,24)
+                :
+                : "r"(table),"r"(elements),"r"(lanes),"r"(iterations)
+                : "x1","x2","x3","x4","x19","x20","x21","x22","x23","x24","x25","cc","memory"
+     );
+}
+
+/** 8 independent update streams per loop iteration
+ */
+static void asm_gups_8(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations) __attribute__((noinline));
+static void asm_gups_8(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations)
+{
+   if (!iterations) return;
+     /*
+      * Input:  %0: table, %1: number of elements, %2: lanes, %3: iterations
+      */
+     __asm__ __volatile__(
+                GUPS_SETUP
+                LANE_LOAD(1,0)
+                LANE_LOAD(2,8)
+                LANE_LOAD(3,16)
+                LANE_LOAD(4,24)
+                LANE_LOAD(5,32)
+                LANE_LOAD(6,40)
+                LANE_LOAD(7,48)
+                LANE_LOAD(8,56)
+                ".align 6\n\t"
+                "_work_loop_gups_8:\n\t"
+                GUPS_UPDATE(1)
+                GUPS_UPDATE(2)
+                GUPS_UPDATE(3)
+                GUPS_UPDATE(4)
+                GUPS_UPDATE(5)
+                GUPS_UPDATE(6)
+                GUPS_UPDATE(7)
+                GUPS_UPDATE(8)
+                "subs x25,x25,#1\n\t"
+                "bne _work_loop_gups_8\n\t"
+                LANE_STORE(1,0)
+                LANE_STORE(2,8)
+                LANE_STORE(3,16)
+                LANE_STORE(4,24)
+                LANE_STORE(5,32)
+                LANE_STORE(6,40)
+                LANE_STORE(7,48)
+                LANE_STORE(8,56)
+                :
+                : "r"(table),"r"(elements),"r"(lanes),"r"(iterations)
+                : "x1","x2","x3","x4","x5","x6","x7","x8","x19","x20","x21","x22","x23","x24","x25","cc","memory"
+     );
+}
+
+/** 16 independent update streams per loop iteration
+ */
+static void asm_gups_16(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations) __attribute__((noinline));
+static void asm_gups_16(unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations)
+{
+   if (!iterations) return;
+     /*
+      * Input:  %0: table, %1: number of elements, %2: lanes, %3: iterations
+      */
+     __asm__ __volatile__(
+                GUPS_SETUP
+                LANE_LOAD(1,0)
+                LANE_LOAD(2,8)
+                LANE_LOAD(3,16)
+                LANE_LOAD(4,24)
+                LANE_LOAD(5,32)
+                LANE_LOAD(6,40)
+                LANE_LOAD(7,48)
+                LANE_LOAD(8,56)
+                LANE_LOAD(9,64)
+                LANE_LOAD(10,72)
+                LANE_LOAD(11,80)
+                LANE_LOAD(12,88)
+                LANE_LOAD(13,96)
+                LANE_LOAD(14,104)
+                LANE_LOAD(15,112)
+                LANE_LOAD(16,120)
+                ".align 6\n\t"
+                "_work_loop_gups_16:\n\t"
+                GUPS_UPDATE(1)
+                GUPS_UPDATE(2)
+                GUPS_UPDATE(3)
+                GUPS_UPDATE(4)
+                GUPS_UPDATE(5)
+                GUPS_UPDATE(6)
+                GUPS_UPDATE(7)
+                GUPS_UPDATE(8)
+                GUPS_UPDATE(9)
+                GUPS_UPDATE(10)
+                GUPS_UPDATE(11)
+                GUPS_UPDATE(12)
+                GUPS_UPDATE(13)
+                GUPS_UPDATE(14)
+                GUPS_UPDATE(15)
+                GUPS_UPDATE(16)
+                "subs x25,x25,#1\n\t"
+                "bne _work_loop_gups_16\n\t"
+                LANE_STORE(1,0)
+                LANE_STORE(2,8)
+                LANE_STORE(3,16)
+                LANE_STORE(4,24)
+                LANE_STORE(5,32)
+                LANE_STORE(6,40)
+                LANE_STORE(7,48)
+                LANE_STORE(8,56)
+                LANE_STORE(9,64)
+                LANE_STORE(10,72)
+                LANE_STORE(11,80)
+                LANE_STORE(12,88)
+                LANE_STORE(13,96)
+                LANE_STORE(14,104)
+                LANE_STORE(15,112)
+                LANE_STORE(16,120)
+                :
+                : "r"(table),"r"(elements),"r"(lanes),"r"(iterations)
+                : "x1","x2","x3","x4","x5","x6","x7","x8","x9","x10","x11","x12","x13","x14","x15","x16","x19","x20","x21","x22","x23","x24","x25","cc","memory"
+     );
+}
+
+/** perform iterations*batch updates
+ */
+static void gups(int batch, unsigned long long *lanes, unsigned long long table, unsigned long long elements, unsigned long long iterations)
+{
+   switch(batch){
+     case 1:  asm_gups_1(lanes,table,elements,iterations);break;
+     case 2:  asm_gups_2(lanes,table,elements,iterations);break;
+     case 4:  asm_gups_4(lanes,table,elements,iterations);break;
+     case 8:  asm_gups_8(lanes,table,elements,iterations);break;
+     case 16: asm_gups_16(lanes,table,elements,iterations);break;
+     default: break;
+   }
+}
+
+/** initialize random number generators of a thread (any value != 0 is a valid state)
+ */
+static void init_lanes(threaddata_t *threaddata, unsigned long long seed)
+{
+   int i;
+
+   for (i=0;i<MAX_BATCH;i++){
+     threaddata->lanes[i]=(seed+(unsigned long long)(threaddata->thread_id*MAX_BATCH+i+1))*0x9E3779B97F4A7C15ULL;
+     if (threaddata->lanes[i]==0) threaddata->lanes[i]=1;
+   }
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - threads 0 to num_threads-1 perform data->updates random updates each, using the first table_size Bytes of table[placement]
+ *   - every thread measures its own time with the cycle counter of its CPU (the cycle counters of different CPUs
+ *     are not synchronized), the update rates of the threads are summed up
+ *   - updates of different threads are not synchronized (as in HPCC RandomAccess, conflicting updates can get lost)
+ *   - (*results)[0]: updates of all threads per cycle
+ */
+void _work(unsigned long long table_size, int num_threads, int batch, int placement, int runs, volatile mydata_t* data, double **results)
+{
+  int i,t;
+  unsigned long long iterations,start,end;
+  double sum,tmax;
+
+  if (num_threads>data->num_threads) num_threads=data->num_threads;
+  data->active_threads=num_threads;
+
+  iterations=data->updates/batch;
+  if (iterations==0) iterations=1;
+
+  tmax=0;
+  for (i=0;i<runs;i++)
+  {
+    /* arm the other threads, they receive THREAD_UPDATE and wait for the go signal */
+    data->go=0;
+    for (t=0;t<num_threads;t++){
+       init_lanes((threaddata_t*)&(data->threaddata[t]),(unsigned long long)i);
+       data->threaddata[t].table=(unsigned long long)(data->table[placement]);
+       data->threaddata[t].elements=table_size/sizeof(unsigned long long);
+       data->threaddata[t].batch=batch;
+       data->threaddata[t].cycles=0;
+       data->threaddata[t].running=0;
+    }
+    asm volatile ("dmb sy\n\t" : : : "memory");
+    for (t=1;t<num_threads;t++) mailbox_post(&(data->mailbox[t]),THREAD_UPDATE);
+
+    data->go=1;
+    /* start the own updates only after all threads have seen the go signal */
+    for (t=1;t<num_threads;t++){
+       while (!data->threaddata[t].running);
+    }
+    start=timestamp();
+    gups(batch,(unsigned long long*)data->threaddata[0].lanes,data->threaddata[0].table,data->threaddata[0].elements,iterations);
+    end=timestamp();
+    data->threaddata[0].cycles=end-start;
+
+    for (t=1;t<num_threads;t++) mailbox_wait(&(data->mailbox[t]));
+    data->go=0;
+
+    sum=0;
+    for (t=0;t<num_threads;t++){
+      if (data->threaddata[t].cycles) sum+=(double)(iterations*batch)/(double)data->threaddata[t].cycles;
+    }
+
+    // discard first iteration if more than 1 runs are performed
+    if ((i>0)||(runs==1))
+    {
+     #ifdef AVERAGE
+       tmax+=sum;
+     #else
+       if (sum>tmax) tmax=sum;
+     #endif
+    }
+  }
+  #ifdef AVERAGE
+  if (runs>1) tmax/=(runs-1);
+  #endif
+
+  if (tmax>0) (*results)[0]=tmax;
+  else (*results)[0]=INVALID_MEASUREMENT;
+}
+
+
+/** loop for additional worker threads
+ *  communicating with master thread using the mailbox protocol (see membench.h)
+ */
+void *thread(void *threaddata)
+{
+  int id= ((threaddata_t *) threaddata)->thread_id;
+  volatile mydata_t* global_data = ((threaddata_t *) threaddata)->data; //communication
+  threaddata_t* mydata = (threaddata_t*)threaddata;
+  unsigned long long start,iterations;
+
+  mailbox_t *mailbox = &(global_data->mailbox[id]);
+  unsigned int seq=0;
+
+  while (mailbox_receive(mailbox,&seq)!=THREAD_INIT) mailbox_idle(mailbox,seq);
+
+  cpu_set(((threaddata_t *) threaddata)->cpu_id);
+  mailbox_complete(mailbox,seq);
+
+  while(1)
+  {
+     switch (mailbox_receive(mailbox,&seq)){
+       case THREAD_UPDATE:
+         iterations=global_data->updates/mydata->batch;
+         if (iterations==0) iterations=1;
+
+         while (!global_data->go);
+         mydata->running=1;
+         start=timestamp();
+         gups(mydata->batch,mydata->lanes,mydata->table,mydata->elements,iterations);
+         mydata->cycles=timestamp()-start;
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_WAIT: // no new command
+         mailbox_idle(mailbox,seq);
+         break;
+       case THREAD_STOP: // exit
+       default:
+         mailbox_complete(mailbox,seq);
+         pthread_exit(NULL);
+    }
+  }
+}
@@ -0,0 +1,88 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures random read-modify-write update rate (RandomAccess / GUPS) for different table sizes.
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "random access updates (GUPS)"
+#define CODE_SEQUENCE       "table[random]^=random"
+#define X_AXIS_TEXT         "table size [Byte]"
+#define Y_AXIS_TEXT_1       "updates per second [1/s]"
+
+/* kernel specific thread functions, see membench.h for the common ones */
+#define THREAD_UPDATE          THREAD_KERNEL
+
+/* primitive polynomial of the random number generator (HPCC RandomAccess) */
+#define POLY           0x0000000000000007ULL
+
+/* supported numbers of independent update streams per batch: 1,2,4,8,16 */
+#define MAX_BATCH      16
+
+/* maximal number of entries in BENCHIT_KERNEL_THREADS, BENCHIT_KERNEL_BATCH, and BENCHIT_KERNEL_PLACEMENT */
+#define MAX_THREAD_COUNTS 16
+#define MAX_BATCHES       5
+#define MAX_PLACEMENTS    8
+
+/* table placement: NUMA node number or one of the following */
+#define PLACEMENT_LOCAL      -1
+#define PLACEMENT_INTERLEAVE -2
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* table[MAX_PLACEMENTS];                         // one table per placement
+   pthread_t *threads;
+   struct threaddata *threaddata;
+   cpu_info_t *cpuinfo;
+   unsigned long long table_size;                       // allocated size of each table
+   unsigned long long updates;                          // updates per thread and measurement
+   unsigned short num_threads;
+   unsigned short active_threads;
+   unsigned char runs;
+   unsigned char padding1[19];                          //64+24+8+8+4+1+19 = 128
+   unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
+   volatile unsigned short go;                          //+2, starts the updates
+   unsigned char padding2[54];                          //   8+2+54 = 64
+   unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
+} mydata_t;
+
+/* data needed by each thread */
+typedef struct threaddata
+{
+   unsigned long long lanes[MAX_BATCH];                 //128, state of the independent random number generators
+   volatile mydata_t *data;
+   cpu_info_t *cpuinfo;                                 //+16
+   volatile unsigned long long table;                   //+8, table used for the current measurement
+   volatile unsigned long long elements;                //+8, number of 8 Byte elements in the table
+   volatile unsigned long long cycles;                  //+8, duration of the measurement on this CPU
+   unsigned int thread_id;
+   unsigned int cpu_id;                                 //+8
+   unsigned char batch;
+   volatile unsigned char running;                      //+2
+   unsigned char padding1[78];                          //+78 = 256
+   unsigned long long end_dummy_cachelines[16];         //avoid prefetching following data
+} threaddata_t;
+
+/* function that performs the measurement for a certain table size
+ * (*results)[0]: updates of all threads per cycle */
+void _work(unsigned long long table_size, int num_threads, int batch, int placement, int runs, volatile mydata_t* data, double **results);
+
+/* loop executed by all threads, except the master thread */
+void *thread(void *threaddata);
+
+#endif
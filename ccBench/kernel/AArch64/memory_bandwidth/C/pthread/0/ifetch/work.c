@@ -0,0 +1,146 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures instruction fetch bandwidth for generated code blocks of different size.
+ ******************************************************************************************************/
+
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+/* report average throughput instead of maximum */
+//#define AVERAGE
+
+/* instruction encodings */
+#define INSN_NOP          0xd503201fU                   // nop
+#define INSN_ADD(r)       (0x91000400U|((r)<<5)|(r))    // add xr,xr,#1
+#define INSN_B(off)       (0x14000000U|(((off)>>2)&0x3ffffffU))  // b .+off
+#define INSN_SUBS_X0      0xf1000400U                   // subs x0,x0,#1
+#define INSN_BEQ_8        0x54000040U                   // b.eq .+8
+#define INSN_RET          0xd65f03c0U                   // ret
+
+/* add instructions rotate through x9-x16 (temporary registers), so that up to 8 of them can be executed in parallel */
+#define ADD_FIRST_REG 9
+#define ADD_NUM_REGS  8
+
+/* generated code: void code(unsigned long long passes) */
+typedef void (*code_t)(unsigned long long);
+
+/** read timestamp counter
+ */
+static inline unsigned long long timestamp(void)
+{
+   unsigned long long ts;
+
+   __asm__ __volatile__(
+                TIMESTAMP
+		: "=r"(ts)
+   );
+   return ts;
+}
+
+/** writes a code block of code_size Byte to buffer
+ *  - code_size/4-LOOP_INSTRUCTIONS instructions of the selected type, followed by the loop:
+ *      subs x0,x0,#1; b.eq .+8; b <start>; ret
+ *  - CODE_BRANCH: add instructions, every distance Byte the last instruction is a taken branch to the next instruction
+ *  - the whole buffer is remapped, as hugetlb mappings can only be changed in multiples of the page size
+ *  returns the number of instructions executed per pass
+ */
+static unsigned long long generate_code(char *buffer, unsigned long long buffersize, unsigned long long code_size, int code, unsigned long long distance)
+{
+  unsigned int *insn=(unsigned int*)buffer;
+  unsigned long long i,n;
+
+  n=code_size/4-LOOP_INSTRUCTIONS;
+
+  mprotect(buffer,buffersize,PROT_READ|PROT_WRITE);
+  for (i=0;i<n;i++){
+    switch (code){
+      case CODE_NOP:
+        insn[i]=INSN_NOP;
+        break;
+      case CODE_BRANCH:
+        if (((i+1)*4)%distance==0) {insn[i]=INSN_B(4);break;}
+        /* fall through */
+      case CODE_ADD:
+      default:
+        insn[i]=INSN_ADD(ADD_FIRST_REG+(i%ADD_NUM_REGS));
+        break;
+    }
+  }
+  insn[n]=INSN_SUBS_X0;
+  insn[n+1]=INSN_BEQ_8;
+  insn[n+2]=INSN_B(-(long long)(n+2)*4);
+  insn[n+3]=INSN_RET;
+  mprotect(buffer,buffersize,PROT_READ|PROT_EXEC);
+  __builtin___clear_cache(buffer,buffer+code_size);
+
+  /* ret is only executed once */
+  return n+LOOP_INSTRUCTIONS-1;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - for every curve a code block of code_size Byte is generated and executed in a loop
+ *     until at least data->instructions instructions have been executed
+ *   - the first run warms up caches, TLBs and branch predictors and is discarded (unless only 1 run is performed)
+ */
+void _work(unsigned long long code_size, volatile mydata_t* data, double **results)
+{
+  int i,j;
+  unsigned long long insn_per_pass,passes,start,end;
+  code_t code=(code_t)data->buffer;
+  double ipc,max_ipc;
+
+  code_size&=~3ULL;
+  for (j=0;j<data->num_curves;j++)
+  {
+    if ((code_size<4*(LOOP_INSTRUCTIONS+1))||(code_size>data->buffersize)) {(*results)[j]=INVALID_MEASUREMENT;continue;}
+
+    insn_per_pass=generate_code(data->buffer,data->buffersize,code_size,data->code[j],data->distance[j]);
+    passes=data->instructions/insn_per_pass+1;
+
+    max_ipc=0;
+    for (i=0;i<data->runs;i++)
+    {
+      if ((i==0)&&(data->runs>1)){
+        code(passes);
+        continue;
+      }
+      start=timestamp();
+      code(passes);
+      end=timestamp();
+      ipc=(double)(insn_per_pass*passes)/(double)(end-start);
+      #ifdef AVERAGE
+        max_ipc+=ipc;
+      #else
+        if (ipc>max_ipc) max_ipc=ipc;
+      #endif
+    }
+    #ifdef AVERAGE
+    if (data->runs>1) max_ipc/=(data->runs-1);
+    #endif
+
+    if (max_ipc>0) (*results)[j]=max_ipc;
+    else (*results)[j]=INVALID_MEASUREMENT;
+  }
+}
@@ -0,0 +1,60 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures instruction fetch bandwidth for generated code blocks of different size.
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "instruction fetch bandwidth"
+#define CODE_SEQUENCE       "generated straight-line code (nop|add|add+b)"
+#define X_AXIS_TEXT         "code size [Byte]"
+#define Y_AXIS_TEXT_1       "instructions per cycle"
+#define Y_AXIS_TEXT_2       "instruction fetch bandwidth [Byte/s]"
+
+/* code block types */
+#define CODE_NOP     1
+#define CODE_ADD     2
+#define CODE_BRANCH  3
+
+/* maximal number of curves (entries in BENCHIT_KERNEL_CODE, one per entry in BENCHIT_KERNEL_BRANCH_DISTANCE for branch) */
+#define MAX_CURVES   16
+
+/* instructions of the loop at the end of every code block (subs, b.eq, b, ret) */
+#define LOOP_INSTRUCTIONS 4
+
+/* the loop branch (b) reaches +-128 MiB */
+#define MAX_CODE_SIZE (128ULL<<20)
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* buffer;                                        // executable memory for the generated code
+   unsigned long long buffersize;
+   unsigned long long pagesize;
+   cpu_info_t *cpuinfo;
+   unsigned long long instructions;                     // minimal number of instructions per measurement
+   int code[MAX_CURVES];                                // block type of every curve
+   unsigned long long distance[MAX_CURVES];             // distance between taken branches in Byte (CODE_BRANCH only)
+   int num_curves;
+   int runs;
+} mydata_t;
+
+/** function that performs the measurement
+ *  - (*results)[i]: instructions per cycle for a code block of size code_size and type data->code[i]
+ */
+void _work(unsigned long long code_size, volatile mydata_t* data, double **results);
+
+#endif
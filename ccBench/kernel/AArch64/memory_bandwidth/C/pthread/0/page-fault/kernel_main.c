@@ -0,0 +1,551 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *****************************************************************************************************/
+/* Kernel: measures page fault rate and first-touch bandwidth of new mappings with concurrently faulting threads.
+ *****************************************************************************************************/
+#define _GNU_SOURCE
+#include <sched.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <signal.h>
+#include <unistd.h>
+#include "interface.h"
+#include "tools/hw_detect/cpu.h"
+
+
+/*  Header for local functions */
+#include "work.h"
+
+
+/* number of functions (needed by BenchIT Framework, see bi_getinfo()) */
+int n_of_works;
+int n_of_sure_funcs_per_work;
+
+/* variables to store settings from PARAMETERS file
+ * parsed by evaluate_environment() function */
+int RUNS=0,NUM_RESULTS=0,TIMEOUT=0,NUM_THREADS=0;
+/* idle policy of the helper threads, spin time in ns before blocking (-1: spin only), derived from IDLE_POLICY and IDLE_SPIN_TIME in PARAMETERS file */
+long long IDLE_SPIN_TIME=-1;
+unsigned long long HUGEPAGE_SIZE=0,MAX=0;
+
+/* selected thread counts and mapping types, derived from THREADS and MODES in PARAMETERS file */
+int thread_counts[MAX_THREAD_COUNTS],NUM_THREAD_COUNTS=0;
+int modes[MAX_MODES],NUM_MODES=0;
+
+/* list of memory sizes per thread */
+bi_list_t * problemlist;
+unsigned long long problemlistsize;
+double *problemarray1;
+
+/* string used for error message */
+char *error_msg=NULL;
+
+/* CPU bindings of threads, derived from CPU_LIST in PARAMETERS file */
+cpu_set_t cpuset;
+unsigned long long *cpu_bind;
+
+/* data structure for hardware detection */
+static cpu_info_t *cpuinfo=NULL;
+
+/* needed to derive elapsed time from clock cycles, determined by hw_detect */
+unsigned long long FREQUENCY=0;
+
+/* data structure that holds all relevant information for kernel execution */
+volatile mydata_t* mdp;
+
+/* data for watchdog timer */
+pthread_t watchdog;
+typedef struct watchdog_args{
+ pid_t pid;
+ int timeout;
+} watchdog_arg_t;
+watchdog_arg_t watchdog_arg;
+
+/* stops watchdog thread if benchmark finishes before timeout */
+static void sigusr1_handler (int signum) {
+ pthread_exit(0);
+}
+
+/** stops benchmark if timeout is reached
+ */
+static void *watchdog_timer(void *arg){
+  sigset_t  signal_mask;
+
+  /* ignore SIGTERM and SIGINT */
+  sigemptyset (&signal_mask);
+  sigaddset (&signal_mask, SIGINT);
+  sigaddset (&signal_mask, SIGTERM);
+  pthread_sigmask (SIG_BLOCK, &signal_mask, NULL);
+
+  /* watchdog thread will terminate after receiveing SIGUSR1 during bi_cleanup() */
+  signal(SIGUSR1,sigusr1_handler);
+
+  if (((watchdog_arg_t*)arg)->timeout>0){
+     /* sleep for specified timeout before terminating benchmark */
+     sleep(((watchdog_arg_t*)arg)->timeout);
+     kill(((watchdog_arg_t*)arg)->pid,SIGTERM);
+  }
+  pthread_exit(0);
+}
+
+/** function that parses the PARAMETERS file
+ */
+void evaluate_environment(bi_info * info);
+
+/**  The implementation of the bi_getinfo() from the BenchIT interface.
+ *   Infostruct is filled with informations about the kernel.
+ *   @param infostruct  a pointer to a structure filled with zero's
+ */
+void bi_getinfo( bi_info * infostruct )
+{
+   int i = 0, j = 0; /* loop var for n_of_works */
+   char buff[512];
+   (void) memset ( infostruct, 0, sizeof( bi_info ) );
+   /* get environment variables for the kernel */
+   evaluate_environment(infostruct);
+   infostruct->codesequence = bi_strdup( CODE_SEQUENCE );
+   infostruct->xaxistext = bi_strdup( X_AXIS_TEXT );
+   infostruct->base_xaxis=10.0;
+   infostruct->maxproblemsize=problemlistsize;
+   sprintf(buff, KERNEL_DESCRIPTION);
+   infostruct->kerneldescription = bi_strdup( buff );
+   infostruct->num_processes = 1;
+   infostruct->num_threads_per_process = NUM_THREADS;
+   infostruct->kernel_execs_mpi1 = 0;
+   infostruct->kernel_execs_mpi2 = 0;
+   infostruct->kernel_execs_pvm = 0;
+   infostruct->kernel_execs_omp = 0;
+   infostruct->kernel_execs_pthreads = 1;
+
+   /* page faults per second, first-touch bandwidth */
+   n_of_works = 2;
+
+   /* one curve for every combination of thread count and mapping type */
+   n_of_sure_funcs_per_work = NUM_RESULTS;
+
+   infostruct->numfunctions = n_of_works * n_of_sure_funcs_per_work;
+
+   /* allocating memory for y axis texts and properties */
+   infostruct->yaxistexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->yaxistexts == 0 ){
+     fprintf( stderr, "Allocation of yaxistexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->outlier_direction_upwards = malloc( infostruct->numfunctions * sizeof( int ));
+   if ( infostruct->outlier_direction_upwards == 0 ){
+     fprintf( stderr, "Allocation of outlier direction failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->legendtexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->legendtexts == 0 ){
+     fprintf( stderr, "Allocation of legendtexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->base_yaxis = malloc( infostruct->numfunctions * sizeof( double ));
+   if ( infostruct->base_yaxis == 0 ){
+     fprintf( stderr, "Allocation of base yaxis failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+
+   /* setting up y axis texts and properties */
+   for ( j = 0; j < n_of_works; j++ ){
+     int k,index;
+      for (k=0;k<n_of_sure_funcs_per_work;k++)
+      {
+
+        int c,m;
+        char mode[64];
+
+        index= k + n_of_sure_funcs_per_work * j;
+        c = k / NUM_MODES;
+        m = k % NUM_MODES;
+        switch (modes[m]){
+          case MODE_ANONYMOUS: sprintf(mode,"anonymous"); break;
+          case MODE_POPULATE: sprintf(mode,"MADV_POPULATE_WRITE"); break;
+          case MODE_THP: sprintf(mode,"THP"); break;
+          case MODE_HUGETLB: sprintf(mode,"hugetlb"); break;
+          default: break;
+        }
+        infostruct->base_yaxis[index] = 0;
+        sprintf(buff,"%s, %i thread%s",mode,thread_counts[c],(thread_counts[c]>1)?"s":"");
+        switch ( j )
+        {
+          case 0: // page faults
+            strcat(buff," (page faults per second)");
+            infostruct->legendtexts[index] = bi_strdup( buff );
+            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_1 );
+            break;
+          case 1: // bandwidth
+            strcat(buff," (bandwidth)");
+            infostruct->legendtexts[index] = bi_strdup( buff );
+            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_2 );
+            break;
+          default: break;
+        }
+        infostruct->outlier_direction_upwards[index] = 0;  //report maximum of iterations
+      }
+   }
+}
+
+/** Implementation of the bi_init() of the BenchIT interface.
+ *  init data structures needed for kernel execution
+ */
+void* bi_init( int problemsizemax )
+{
+   int t;
+   unsigned long long i;
+
+   cpu_set(cpu_bind[0]); /* first thread binds to first CPU in list */
+
+   mdp->cpuinfo=cpuinfo;
+
+   /* overwrite detected clockrate if specified in PARAMETERS file*/
+   if (FREQUENCY){
+      mdp->cpuinfo->clockrate=FREQUENCY;
+   }
+   else if (mdp->cpuinfo->clockrate==0){
+      fprintf( stderr, "Error: CPU-Clockrate could not be estimated\n" );
+      exit( 1 );
+   }
+
+   mdp->pagesize=(unsigned long long)sysconf(_SC_PAGESIZE);
+   mdp->hugepage_size=HUGEPAGE_SIZE;
+   mdp->thp_size=0;
+   {
+     FILE *f=fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size","r");
+     if (f){
+       if (fscanf(f,"%llu",&(mdp->thp_size))!=1) mdp->thp_size=0;
+       fclose(f);
+     }
+   }
+   if (mdp->thp_size==0) mdp->thp_size=2ULL<<20;
+   mdp->runs=RUNS;
+   mdp->num_threads=NUM_THREADS;
+   mdp->threads=_mm_malloc(NUM_THREADS*sizeof(pthread_t),64);
+   mdp->mailbox=_mm_malloc(NUM_THREADS*sizeof(mailbox_t),sizeof(mailbox_t));
+   mdp->threaddata = _mm_malloc(mdp->num_threads*sizeof(threaddata_t),64);
+   if ((mdp->threads==NULL)||(mdp->mailbox==NULL)||(mdp->threaddata==NULL)){
+     fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   memset( mdp->threaddata,0,mdp->num_threads*sizeof(threaddata_t));
+   memset(mdp->mailbox,0,NUM_THREADS*sizeof(mailbox_t));
+   for (i=0;i<NUM_THREADS;i++) mdp->mailbox[i].spin_time=IDLE_SPIN_TIME;
+
+  /* create threads */
+  for (t=1;t<mdp->num_threads;t++){
+    mdp->threaddata[t].cpuinfo=(cpu_info_t*)_mm_malloc( sizeof( cpu_info_t ),64);
+    if ( mdp->threaddata[t].cpuinfo == 0 ){
+      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+      exit( 127 );
+    }
+    memcpy(mdp->threaddata[t].cpuinfo,mdp->cpuinfo,sizeof(cpu_info_t));
+    mdp->threaddata[t].thread_id=t;
+    mdp->threaddata[t].cpu_id=cpu_bind[t];
+    mdp->threaddata[t].data=mdp;
+    mailbox_post(&(mdp->mailbox[t]),THREAD_INIT);
+    pthread_create(&(mdp->threads[t]),NULL,thread,(void*)(&(mdp->threaddata[t])));
+  }
+
+  cpu_set(cpu_bind[0]);
+  printf("  wait for threads initialization \n");fflush(stdout);
+  /* wait for threads to finish their initialization */
+  for (t=1;t<mdp->num_threads;t++) mailbox_wait(&(mdp->mailbox[t]));
+  printf("    ...done\n");
+  if ((num_packages()!=-1)&&(num_cores_per_package()!=-1)&&(num_threads_per_core()!=-1))  printf("  num_packages: %i, %i cores per package, %i threads per core\n",num_packages(),num_cores_per_package(),num_threads_per_core());
+  printf("  using up to %i threads, page sizes: %llu KiB (base), %llu KiB (THP), %llu KiB (hugetlb)\n",NUM_THREADS,mdp->pagesize>>10,mdp->thp_size>>10,mdp->hugepage_size>>10);
+  for (i=0;i<NUM_THREADS;i++) if ((get_pkg(cpu_bind[i])!=-1)&&(get_core_id(cpu_bind[i])!=-1)) printf("    - Thread %llu runs on CPU %llu, core %i in package: %i\n",i,cpu_bind[i],get_core_id(cpu_bind[i]),get_pkg(cpu_bind[i]));
+  fflush(stdout);
+
+
+  /* start watchdog thread */
+  watchdog_arg.pid=getpid();
+  watchdog_arg.timeout=TIMEOUT;
+  pthread_create(&watchdog,NULL,watchdog_timer,&watchdog_arg);
+
+  return (void*)mdp;
+}
+
+/** The central function within each kernel. This function
+ *  is called for each measurment step seperately.
+ *  @param  mdpv         a pointer to the structure created in bi_init,
+ *                       it is the pointer the bi_init returns
+ *  @param  problemsize  the actual problemsize
+ *  @param  results      a pointer to a field of doubles, the
+ *                       size of the field depends on the number
+ *                       of functions, there are #functions+1
+ *                       doubles
+ *  @return 0 if the measurment was sucessfull, something
+ *          else in the case of an error
+ */
+int inline bi_entry( void* mdpv, int problemsize, double* results )
+{
+  /* c,m are used for loop iterations */
+  int c = 0, m = 0, k = 0;
+  /* memory per thread */
+  unsigned long long size;
+  /* cast void* pointer */
+  mydata_t* mdp = (mydata_t*)mdpv;
+
+  /* results */
+  double *tmp_results;
+
+  /* check wether the pointer to store the results in is valid or not */
+  if ( results == NULL ) return 1;
+
+  tmp_results=_mm_malloc(2*sizeof(double),64);
+
+  size = (unsigned long long) problemarray1[problemsize-1];
+  if (size<mdp->pagesize) size=mdp->pagesize;
+  results[0] = (double)size;
+
+  for (c=0;c<NUM_THREAD_COUNTS;c++)
+  {
+    for (m=0;m<NUM_MODES;m++)
+    {
+      k=c*NUM_MODES+m;
+
+      /* measure page faults and touched Bytes of all threads per cycle */
+      _work(size,thread_counts[c],modes[m],RUNS,mdp,&tmp_results);
+
+      if (tmp_results[0]==INVALID_MEASUREMENT) {results[1+k]=INVALID_MEASUREMENT;results[1+NUM_RESULTS+k]=INVALID_MEASUREMENT;}
+      else {
+        results[1+k]=tmp_results[0]*(double)mdp->cpuinfo->clockrate;
+        results[1+NUM_RESULTS+k]=tmp_results[1]*(double)mdp->cpuinfo->clockrate;
+      }
+    }
+  }
+
+  _mm_free(tmp_results);
+  return 0;
+}
+
+/** Clean up the memory
+ */
+void bi_cleanup( void* mdpv )
+{
+   int t;
+
+   mydata_t* mdp = (mydata_t*)mdpv;
+   /* terminate other threads */
+   for (t=1;t<mdp->num_threads;t++) mailbox_post(&(mdp->mailbox[t]),THREAD_STOP);
+   for (t=1;t<mdp->num_threads;t++) pthread_join((mdp->threads[t]),NULL);
+   if (mdp->mailbox) mailbox_report(mdp->mailbox,mdp->num_threads);
+   pthread_kill(watchdog,SIGUSR1);
+
+   /* free resources */
+   if (mdp->threaddata){
+     for (t=1;t<mdp->num_threads;t++){
+        if (mdp->threaddata[t].cpuinfo) _mm_free(mdp->threaddata[t].cpuinfo);
+     }
+     _mm_free(mdp->threaddata);
+   }
+   if (mdp->threads) _mm_free(mdp->threads);
+   if (mdp->mailbox) _mm_free(mdp->mailbox);
+   if (mdp->cpuinfo) _mm_free(mdp->cpuinfo);
+   _mm_free( mdp );
+   return;
+}
+
+/********************************************************************/
+/*************** End of interface implementations *******************/
+/********************************************************************/
+
+/* Reads the environment variables used by this kernel. */
+void evaluate_environment(bi_info * info)
+{
+   int i;
+   int errors = 0;
+   char * p = 0;
+
+   cpuinfo=(cpu_info_t*)_mm_malloc( sizeof( cpu_info_t ),64);memset((void*)cpuinfo,0,sizeof( cpu_info_t ));
+   if ( cpuinfo == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure cpuinfo_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+   init_cpuinfo(cpuinfo,1);
+
+   mdp = (mydata_t*)_mm_malloc( sizeof( mydata_t ),64);memset((void*)mdp,0, sizeof( mydata_t ));
+   if ( mdp == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+
+   error_msg=malloc(256);
+
+   /* generate ordered list of memory sizes per thread in problemarray1*/
+   p = bi_getenv( "BENCHIT_KERNEL_PROBLEMLIST", 0 );
+   if ( p == 0 ){
+     unsigned long long MIN;
+     int STEPS;
+     double MemFactor;
+     p = bi_getenv("BENCHIT_KERNEL_MIN",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MIN not set");}
+     else MIN=atoll(p);
+     p = bi_getenv("BENCHIT_KERNEL_MAX",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MAX not set");}
+     else MAX=atoll(p);
+     p = bi_getenv("BENCHIT_KERNEL_STEPS",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_STEPS not set");}
+     else STEPS=atoi(p);
+     if ( errors == 0){
+       problemarray1=malloc(STEPS*sizeof(double));
+       MemFactor =((double)MAX)/((double)MIN);
+       MemFactor = pow(MemFactor, 1.0/((double)STEPS-1));
+       for (i=0;i<STEPS;i++){
+          problemarray1[i] = ((double)MIN)*pow(MemFactor, i);
+       }
+       problemlistsize=STEPS;
+       problemarray1[STEPS-1]=(double)MAX;
+     }
+   }
+   else{
+     fflush(stdout);printf("BenchIT: parsing list of problemsizes: ");
+     bi_parselist(p);
+     problemlist = info->list;
+     problemlistsize = info->listsize;
+     problemarray1=malloc(problemlistsize*sizeof(double));
+     for (i=0;i<problemlistsize;i++){
+        problemarray1[i]=problemlist->dnumber;
+        if (problemlist->pnext!=NULL) problemlist=problemlist->pnext;
+        if (problemarray1[i]>MAX) MAX=problemarray1[i];
+     }
+   }
+
+   CPU_ZERO(&cpuset);NUM_THREADS=0;
+   if (bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 ));else p=NULL;
+   if (p){
+     char *q,*r,*s;
+     i=0;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       s=strstr(p,"/");if (s) {*s='\0';s++;}
+       r=strstr(p,"-");if (r) {*r='\0';r++;}
+
+       if ((s)&&(r)) for (i=atoi(p);i<=atoi(r);i+=atoi(s)) {if (cpu_allowed(i)) {CPU_SET(i,&cpuset);NUM_THREADS++;}}
+       else if (r) for (i=atoi(p);i<=atoi(r);i++) {if (cpu_allowed(i)) {CPU_SET(i,&cpuset);NUM_THREADS++;}}
+       else if (cpu_allowed(atoi(p))) {CPU_SET(atoi(p),&cpuset);NUM_THREADS++;}
+       p=q;
+     }while(p!=NULL);
+   }
+   else { /* use all allowed CPUs if not defined otherwise */
+     for (i=0;i<CPU_SETSIZE;i++) {if (cpu_allowed(i)) {CPU_SET(i,&cpuset);NUM_THREADS++;}}
+   }
+
+   /* bind threads to available cores in specified order */
+   if (NUM_THREADS==0) {errors++;sprintf(error_msg,"no allowed CPUs in BENCHIT_KERNEL_CPU_LIST");}
+   else
+   {
+     int j=0;
+     cpu_bind=(unsigned long long*)malloc((NUM_THREADS+1)*sizeof(unsigned long long));
+     if (bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_CPU_LIST", 0 ));else p=NULL;
+     if (p)
+     {
+       char *q,*r,*s;
+       i=0;
+       do
+       {
+         q=strstr(p,",");if (q) {*q='\0';q++;}
+         s=strstr(p,"/");if (s) {*s='\0';s++;}
+         r=strstr(p,"-");if (r) {*r='\0';r++;}
+
+         if ((s)&&(r)) for (i=atoi(p);i<=atoi(r);i+=atoi(s)) {if (cpu_allowed(i)) {cpu_bind[j]=i;j++;}}
+         else if (r) for (i=atoi(p);i<=atoi(r);i++) {if (cpu_allowed(i)) {cpu_bind[j]=i;j++;}}
+         else if (cpu_allowed(atoi(p))) {cpu_bind[j]=atoi(p);j++;}
+         p=q;
+       }
+       while(p!=NULL);
+     }
+     else { /* no order specified */
+       for(i=0;i<CPU_SETSIZE;i++){
+        if (CPU_ISSET(i,&cpuset)) {cpu_bind[j]=i;j++;}
+       }
+     }
+   }
+
+   p = bi_getenv( "BENCHIT_KERNEL_CPU_FREQUENCY", 0 );
+   if ( p != 0 ) FREQUENCY = atoll( p );
+
+   if (bi_getenv( "BENCHIT_KERNEL_THREADS", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_THREADS", 0 ));else p=NULL;
+   if (p==0) { /* single-threaded and all CPUs if not defined otherwise */
+     thread_counts[NUM_THREAD_COUNTS++]=1;
+     if (NUM_THREADS>1) thread_counts[NUM_THREAD_COUNTS++]=NUM_THREADS;
+   }
+   else {
+     char *q;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       if (NUM_THREAD_COUNTS==MAX_THREAD_COUNTS) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_THREADS");}
+       else if ((atoi(p)<1)||(atoi(p)>NUM_THREADS)) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_THREADS (1 to number of CPUs)");}
+       else thread_counts[NUM_THREAD_COUNTS++]=atoi(p);
+       p=q;
+     }while(p!=NULL);
+   }
+
+   if (bi_getenv( "BENCHIT_KERNEL_MODES", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_MODES", 0 ));else p=NULL;
+   if (p==0) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MODES not set");}
+   else {
+     char *q;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       if (NUM_MODES==MAX_MODES) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_MODES");}
+       else if (!strcmp(p,"anonymous")) modes[NUM_MODES++]=MODE_ANONYMOUS;
+       else if (!strcmp(p,"populate")) modes[NUM_MODES++]=MODE_POPULATE;
+       else if (!strcmp(p,"thp")) modes[NUM_MODES++]=MODE_THP;
+       else if (!strcmp(p,"hugetlb")) modes[NUM_MODES++]=MODE_HUGETLB;
+       else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_MODES (anonymous|populate|thp|hugetlb)");}
+       p=q;
+     }while(p!=NULL);
+   }
+   NUM_RESULTS=NUM_THREAD_COUNTS*NUM_MODES;
+
+   p = bi_getenv( "BENCHIT_KERNEL_HUGEPAGE_SIZE", 0 );
+   if ( p != 0 ) {
+     char *r;
+     HUGEPAGE_SIZE=strtoull(p,&r,10);
+     if ((*r=='K')||(*r=='k')) HUGEPAGE_SIZE<<=10;
+     else if ((*r=='M')||(*r=='m')) HUGEPAGE_SIZE<<=20;
+     else if ((*r=='G')||(*r=='g')) HUGEPAGE_SIZE<<=30;
+     if ((HUGEPAGE_SIZE<4096)||(HUGEPAGE_SIZE&(HUGEPAGE_SIZE-1))) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_HUGEPAGE_SIZE (power of 2, at least 4K)");}
+   }
+   else HUGEPAGE_SIZE=2ULL<<20;
+
+   p = bi_getenv( "BENCHIT_KERNEL_RUNS", 0 );
+   if ( p != 0 ) RUNS = atoi( p );
+   if (RUNS<1) RUNS=1;
+
+   p=bi_getenv( "BENCHIT_KERNEL_TIMEOUT", 0 );
+   if (p!=0){
+     TIMEOUT=atoi(p);
+   }
+
+   /* helper threads spin while idle (default) or block after BENCHIT_KERNEL_IDLE_SPIN_TIME microseconds */
+   p=bi_getenv( "BENCHIT_KERNEL_IDLE_POLICY", 0 );
+   if ((p==0)||(!strcmp(p,"spin"))) IDLE_SPIN_TIME=-1;
+   else if (!strcmp(p,"block")){
+     p=bi_getenv( "BENCHIT_KERNEL_IDLE_SPIN_TIME", 0 );
+     if (p!=0) IDLE_SPIN_TIME=atoll(p)*1000;
+     else IDLE_SPIN_TIME=100000;
+     if (IDLE_SPIN_TIME<0) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_SPIN_TIME");}
+   }
+   else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_POLICY (spin|block)");}
+
+   if ( errors > 0 ) {
+      fprintf( stderr, "Error: There's an environment variable not set or invalid!\n" );
+      fprintf( stderr, "%s\n", error_msg);
+      exit( 1 );
+   }
+   free(error_msg);
+}
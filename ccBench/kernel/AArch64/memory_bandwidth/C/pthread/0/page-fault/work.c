@@ -0,0 +1,236 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures page fault rate and first-touch bandwidth of new mappings with concurrently faulting threads.
+ ******************************************************************************************************/
+
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+/* report average throughput instead of maximum */
+//#define AVERAGE
+
+/** read timestamp counter of the calling CPU
+ */
+static inline unsigned long long timestamp(void)
+{
+   unsigned long long ts;
+
+   __asm__ __volatile__(
+                TIMESTAMP
+		: "=r"(ts)
+   );
+   return ts;
+}
+
+/** maps size Bytes of new memory that is faulted in by fault_touch()
+ *  - MODE_THP: the mapping is aligned to fault_size, so that every fault can be served with a transparent hugepage
+ *  - *buffer and *mapsize describe the mapping for munmap()
+ *  returns the start of the memory to touch, NULL if mmap() failed
+ */
+static char* fault_map(int mode, unsigned long long size, unsigned long long fault_size, char **buffer, unsigned long long *mapsize)
+{
+  int flags=MAP_PRIVATE|MAP_ANONYMOUS,shift=0;
+  char *addr;
+
+  *mapsize=size;
+  if (mode==MODE_THP) *mapsize+=fault_size;
+  if (mode==MODE_HUGETLB){
+    while ((1ULL<<shift)<fault_size) shift++;
+    flags|=MAP_HUGETLB|(shift<<MAP_HUGE_SHIFT);
+  }
+
+  *buffer=(char*) mmap(NULL,*mapsize,PROT_READ|PROT_WRITE,flags,-1,0);
+  if (*buffer==MAP_FAILED) return NULL;
+  addr=*buffer;
+  #ifdef MADV_NOHUGEPAGE
+  if ((mode==MODE_ANONYMOUS)||(mode==MODE_POPULATE)) madvise(*buffer,*mapsize,MADV_NOHUGEPAGE);
+  #endif
+  #ifdef MADV_HUGEPAGE
+  if (mode==MODE_THP){
+    addr=(char*)(((unsigned long long)*buffer+fault_size-1)&~(fault_size-1));
+    madvise(addr,size,MADV_HUGEPAGE);
+  }
+  #endif
+
+  return addr;
+}
+
+/** faults in every page (fault_size) of size Bytes mapped by fault_map()
+ *  - one store per page, MODE_POPULATE: madvise(MADV_POPULATE_WRITE) (one store per page if not supported by the kernel)
+ *  returns the number of cycles for the page faults
+ */
+static unsigned long long fault_touch(int mode, char *addr, unsigned long long size, unsigned long long fault_size)
+{
+  unsigned long long start,end,off;
+
+  start=timestamp();
+  if ((mode!=MODE_POPULATE)||(madvise(addr,size,MADV_POPULATE_WRITE)))
+    for (off=0;off<size;off+=fault_size) *((volatile unsigned long long*)(addr+off))=off;
+  end=timestamp();
+
+  return end-start;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - threads 0 to num_threads-1 concurrently touch size Bytes of new memory each
+ *   - all threads map their memory before the go signal and unmap it after all threads are done, so that
+ *     mmap(), madvise() and munmap() of one thread are not part of the measurement of another thread
+ *   - every thread measures its own time with the cycle counter of its CPU (the cycle counters of different CPUs
+ *     are not synchronized), the rates of the threads are summed up
+ *   - (*results)[0]: page faults of all threads per cycle
+ *   - (*results)[1]: Bytes touched by all threads per cycle
+ */
+void _work(unsigned long long size, int num_threads, int mode, int runs, volatile mydata_t* data, double **results)
+{
+  int i,t,failed;
+  unsigned long long fault_size,mapsize;
+  char *buffer,*addr;
+  double sum,tmax;
+
+  if (num_threads>data->num_threads) num_threads=data->num_threads;
+  data->active_threads=num_threads;
+
+  switch (mode){
+    case MODE_THP: fault_size=data->thp_size; break;
+    case MODE_HUGETLB: fault_size=data->hugepage_size; break;
+    default: fault_size=data->pagesize; break;
+  }
+  size=((size+fault_size-1)/fault_size)*fault_size;
+
+  tmax=0;failed=0;
+  for (i=0;i<runs;i++)
+  {
+    /* arm the other threads, they receive THREAD_FAULT, map their memory and wait for the go signal */
+    data->go=0;
+    for (t=0;t<num_threads;t++){
+       data->threaddata[t].size=size;
+       data->threaddata[t].fault_size=fault_size;
+       data->threaddata[t].mode=mode;
+       data->threaddata[t].cycles=0;
+       data->threaddata[t].failed=0;
+       data->threaddata[t].ready=0;
+       data->threaddata[t].done=0;
+    }
+    asm volatile ("dmb sy\n\t" : : : "memory");
+    for (t=1;t<num_threads;t++) mailbox_post(&(data->mailbox[t]),THREAD_FAULT);
+
+    addr=fault_map(mode,size,fault_size,&buffer,&mapsize);
+    for (t=1;t<num_threads;t++){
+       while (!data->threaddata[t].ready);
+    }
+    data->go=1;
+    if (addr) data->threaddata[0].cycles=fault_touch(mode,addr,size,fault_size);
+    else data->threaddata[0].failed=1;
+
+    /* unmap only after all threads have touched their memory */
+    for (t=1;t<num_threads;t++){
+       while (!data->threaddata[t].done);
+    }
+    data->go=0;
+    if (addr) munmap(buffer,mapsize);
+    for (t=1;t<num_threads;t++) mailbox_wait(&(data->mailbox[t]));
+
+    sum=0;
+    for (t=0;t<num_threads;t++){
+      if (data->threaddata[t].failed) failed=1;
+      else sum+=(double)(size/fault_size)/(double)data->threaddata[t].cycles;
+    }
+
+    // discard first iteration if more than 1 runs are performed
+    if ((i>0)||(runs==1))
+    {
+     #ifdef AVERAGE
+       tmax+=sum;
+     #else
+       if (sum>tmax) tmax=sum;
+     #endif
+    }
+  }
+  #ifdef AVERAGE
+  if (runs>1) tmax/=(runs-1);
+  #endif
+
+  /* not enough pages available (e.g. hugetlb pages not reserved) */
+  if ((failed)||(tmax<=0)) {(*results)[0]=INVALID_MEASUREMENT;(*results)[1]=INVALID_MEASUREMENT;}
+  else {
+    (*results)[0]=tmax;
+    (*results)[1]=tmax*(double)fault_size;
+  }
+}
+
+
+/** loop for additional worker threads
+ *  communicating with master thread using the mailbox protocol (see membench.h)
+ */
+void *thread(void *threaddata)
+{
+  int id= ((threaddata_t *) threaddata)->thread_id;
+  volatile mydata_t* global_data = ((threaddata_t *) threaddata)->data; //communication
+  threaddata_t* mydata = (threaddata_t*)threaddata;
+  unsigned long long mapsize;
+  char *buffer,*addr;
+
+  mailbox_t *mailbox = &(global_data->mailbox[id]);
+  unsigned int seq=0;
+
+  while (mailbox_receive(mailbox,&seq)!=THREAD_INIT) mailbox_idle(mailbox,seq);
+
+  cpu_set(((threaddata_t *) threaddata)->cpu_id);
+  mailbox_complete(mailbox,seq);
+
+  while(1)
+  {
+     switch (mailbox_receive(mailbox,&seq)){
+       case THREAD_FAULT:
+         addr=fault_map(mydata->mode,mydata->size,mydata->fault_size,&buffer,&mapsize);
+         if (!addr) mydata->failed=1;
+         mydata->ready=1;
+         while (!global_data->go);
+         if (addr) mydata->cycles=fault_touch(mydata->mode,addr,mydata->size,mydata->fault_size);
+         mydata->done=1;
+         while (global_data->go);
+         if (addr) munmap(buffer,mapsize);
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_WAIT: // no new command
+         mailbox_idle(mailbox,seq);
+         break;
+       case THREAD_STOP: // exit
+       default:
+         mailbox_complete(mailbox,seq);
+         pthread_exit(NULL);
+    }
+  }
+}
@@ -0,0 +1,86 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures page fault rate and first-touch bandwidth of new mappings with concurrently faulting threads.
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "page fault and first-touch throughput"
+#define CODE_SEQUENCE       "one store per page of a new mapping"
+#define X_AXIS_TEXT         "memory per thread [Byte]"
+#define Y_AXIS_TEXT_1       "page faults per second [1/s]"
+#define Y_AXIS_TEXT_2       "first-touch bandwidth [Byte/s]"
+
+/* kernel specific thread functions, see membench.h for the common ones */
+#define THREAD_FAULT           THREAD_KERNEL
+
+/* mapping types */
+#define MODE_ANONYMOUS  1                               // anonymous memory, transparent hugepages disabled
+#define MODE_POPULATE   2                               // anonymous memory, transparent hugepages disabled, MADV_POPULATE_WRITE
+#define MODE_THP        3                               // anonymous memory, transparent hugepages (MADV_HUGEPAGE)
+#define MODE_HUGETLB    4                               // hugetlb pages (MAP_HUGETLB)
+
+/* maximal number of entries in BENCHIT_KERNEL_THREADS and BENCHIT_KERNEL_MODES */
+#define MAX_THREAD_COUNTS 16
+#define MAX_MODES         4
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   pthread_t *threads;
+   struct threaddata *threaddata;
+   cpu_info_t *cpuinfo;
+   unsigned long long pagesize;                         // base page size
+   unsigned long long thp_size;                         // size of transparent hugepages
+   unsigned long long hugepage_size;                    // size of hugetlb pages
+   unsigned short num_threads;
+   unsigned short active_threads;
+   unsigned char runs;
+   unsigned char padding1[11];                          //24+24+4+1+11 = 64
+   unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
+   volatile unsigned short go;                          //+2, starts faulting
+   unsigned char padding2[54];                          //   8+2+54 = 64
+   unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
+} mydata_t;
+
+/* data needed by each thread */
+typedef struct threaddata
+{
+   volatile mydata_t *data;
+   cpu_info_t *cpuinfo;                                 //16
+   volatile unsigned long long size;                    //+8, size of the mapping
+   volatile unsigned long long fault_size;              //+8, memory per page fault (page size of the mapping)
+   volatile unsigned long long cycles;                  //+8, duration of the page faults on this CPU
+   unsigned int thread_id;
+   unsigned int cpu_id;                                 //+8
+   int mode;                                            //+4
+   volatile unsigned char failed;                       //+1, mmap() failed
+   volatile unsigned char ready;                        //+1, memory mapped, waiting for the go signal
+   volatile unsigned char done;                         //+1, all pages touched, waiting for the end of the run
+   unsigned char padding1[73];                          //+73 = 128
+   unsigned long long end_dummy_cachelines[16];         //avoid prefetching following data
+} threaddata_t;
+
+/* function that performs the measurement for a certain amount of memory per thread
+ * (*results)[0]: page faults of all threads per cycle
+ * (*results)[1]: Bytes touched by all threads per cycle */
+void _work(unsigned long long size, int num_threads, int mode, int runs, volatile mydata_t* data, double **results);
+
+/* loop executed by all threads, except the master thread */
+void *thread(void *threaddata);
+
+#endif
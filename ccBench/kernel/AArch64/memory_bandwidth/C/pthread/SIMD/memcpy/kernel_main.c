@@ -0,0 +1,659 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *****************************************************************************************************/
+/* Kernel: compares memcpy/memmove/memset implementations for different sizes, alignments, and cache states.
+ *****************************************************************************************************/
+#define _GNU_SOURCE
+#include <sched.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <signal.h>
+#include <unistd.h>
+#include "interface.h"
+#include "tools/hw_detect/cpu.h"
+
+
+/*  Header for local functions */
+#include "work.h"
+
+/* number of functions (needed by BenchIT Framework, see bi_getinfo()) */
+int n_of_works;
+int n_of_sure_funcs_per_work;
+
+/* variables to store settings from PARAMETERS file
+ * parsed by evaluate_environment() function */
+int RUNS=0,TIMEOUT=0,NUM_RESULTS=0,CPU=0,LOOP_OVERHEAD_COMPENSATION=0,SRC_NODE=-1,DST_NODE=-1;
+int EXTRA_FLUSH_SIZE=0,DISABLE_CLFLUSH=1,NUM_FLUSHES=0,NUM_USES=0,FLUSH_MODE=0,USE_MODE=0,USE_DIRECTION=0;
+unsigned long long MAX=0,REPEAT_BYTES=0;
+long long CACHEFLUSHSIZE=0,L1_SIZE=-1,L2_SIZE=-1,L3_SIZE=-1,L4_SIZE=-1;
+int CACHELINE=0,CACHELEVELS=0;
+
+/* selected implementations, offsets, and cache states, derived from FUNCTIONS, OFFSETS, and CACHE_STATES in PARAMETERS file */
+int functions[MAX_FUNCTIONS],NUM_FUNCTIONS=0;
+int src_offsets[MAX_OFFSETS],dst_offsets[MAX_OFFSETS],NUM_OFFSETS=0;
+int states[MAX_STATES],NUM_STATES=0;
+
+/* string used for error message */
+char *error_msg=NULL;
+
+/* sizes for each measurement */
+bi_list_t * problemlist;
+unsigned long long problemlistsize;
+double *problemarray1;
+
+/* data structure for hardware detection */
+static cpu_info_t *cpuinfo=NULL;
+
+/* needed to derive elapsed time from clock cycles, determined by hw_detect */
+unsigned long long FREQUENCY=0;
+
+/* data structure that holds all relevant information for kernel execution */
+volatile mydata_t* mdp;
+
+/* data for watchdog timer */
+pthread_t watchdog;
+typedef struct watchdog_args{
+ pid_t pid;
+ int timeout;
+} watchdog_arg_t;
+watchdog_arg_t watchdog_arg;
+
+/* stops watchdog thread if benchmark finishes before timeout */
+static void sigusr1_handler (int signum) {
+ pthread_exit(0);
+}
+
+/** stops benchmark if timeout is reached
+ */
+static void *watchdog_timer(void *arg){
+  sigset_t  signal_mask;
+
+  /* ignore SIGTERM and SIGINT */
+  sigemptyset (&signal_mask);
+  sigaddset (&signal_mask, SIGINT);
+  sigaddset (&signal_mask, SIGTERM);
+  pthread_sigmask (SIG_BLOCK, &signal_mask, NULL);
+
+  /* watchdog thread will terminate after receiveing SIGUSR1 during bi_cleanup() */
+  signal(SIGUSR1,sigusr1_handler);
+
+  if (((watchdog_arg_t*)arg)->timeout>0){
+     /* sleep for specified timeout before terminating benchmark */
+     sleep(((watchdog_arg_t*)arg)->timeout);
+     kill(((watchdog_arg_t*)arg)->pid,SIGTERM);
+  }
+  pthread_exit(0);
+}
+
+/** names of implementations and cache states used in legends
+ */
+static const char *function_name(int function)
+{
+   switch (function){
+     case FUNC_MEMCPY: return "memcpy";
+     case FUNC_MEMMOVE: return "memmove";
+     case FUNC_NEON_COPY: return "ldp q/stp q";
+     case FUNC_MEMSET: return "memset";
+     case FUNC_NEON_SET: return "stp q";
+     case FUNC_DC_ZVA: return "dc zva";
+     default: return "";
+   }
+}
+static const char *state_name(int state)
+{
+   switch (state){
+     case STATE_L1: return "L1";
+     case STATE_L2: return "L2";
+     case STATE_LLC: return "LLC";
+     case STATE_COLD: return "cold";
+     default: return "";
+   }
+}
+
+/** function that parses the PARAMETERS file
+ */
+void evaluate_environment(bi_info * info);
+
+/**  The implementation of the bi_getinfo() from the BenchIT interface.
+ *   Infostruct is filled with informations about the kernel.
+ *   @param infostruct  a pointer to a structure filled with zero's
+ */
+void bi_getinfo( bi_info * infostruct )
+{
+   int i = 0, j = 0; /* loop var for n_of_works */
+   char buff[512];
+   (void) memset ( infostruct, 0, sizeof( bi_info ) );
+   /* get environment variables for the kernel */
+   evaluate_environment(infostruct);
+   infostruct->codesequence = bi_strdup( CODE_SEQUENCE );
+   infostruct->xaxistext = bi_strdup( X_AXIS_TEXT );
+   infostruct->base_xaxis=10.0;
+   infostruct->maxproblemsize=problemlistsize;
+   sprintf(buff, KERNEL_DESCRIPTION);
+   infostruct->kerneldescription = bi_strdup( buff );
+   infostruct->num_processes = 1;
+   infostruct->num_threads_per_process = 1;
+   infostruct->kernel_execs_mpi1 = 0;
+   infostruct->kernel_execs_mpi2 = 0;
+   infostruct->kernel_execs_pvm = 0;
+   infostruct->kernel_execs_omp = 0;
+   infostruct->kernel_execs_pthreads = 0;
+
+   /* bandwidth, cycles per call */
+   n_of_works = 2;
+
+   /* one curve for every combination of implementation, offsets, and cache state */
+   n_of_sure_funcs_per_work = NUM_RESULTS;
+
+   infostruct->numfunctions = n_of_works * n_of_sure_funcs_per_work;
+
+   /* allocating memory for y axis texts and properties */
+   infostruct->yaxistexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->yaxistexts == 0 ){
+     fprintf( stderr, "Allocation of yaxistexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->outlier_direction_upwards = malloc( infostruct->numfunctions * sizeof( int ));
+   if ( infostruct->outlier_direction_upwards == 0 ){
+     fprintf( stderr, "Allocation of outlier direction failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->legendtexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->legendtexts == 0 ){
+     fprintf( stderr, "Allocation of legendtexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->base_yaxis = malloc( infostruct->numfunctions * sizeof( double ));
+   if ( infostruct->base_yaxis == 0 ){
+     fprintf( stderr, "Allocation of base yaxis failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+
+   /* setting up y axis texts and properties */
+   for ( j = 0; j < n_of_works; j++ ){
+     int k,index;
+      for (k=0;k<n_of_sure_funcs_per_work;k++)
+      {
+        int f,o,l;
+
+        index= k + n_of_sure_funcs_per_work * j;
+        f = k / (NUM_OFFSETS*NUM_STATES);
+        o = (k / NUM_STATES) % NUM_OFFSETS;
+        l = k % NUM_STATES;
+        infostruct->base_yaxis[index] = 0;
+        if (IS_COPY(functions[f])) sprintf(buff,"%s, src+%i dst+%i, %s",function_name(functions[f]),src_offsets[o],dst_offsets[o],state_name(states[l]));
+        else sprintf(buff,"%s, dst+%i, %s",function_name(functions[f]),dst_offsets[o],state_name(states[l]));
+        switch ( j )
+        {
+          case 0: // bandwidth
+            strcat(buff," (bandwidth)");
+            infostruct->legendtexts[index] = bi_strdup( buff );
+            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_1 );
+            infostruct->outlier_direction_upwards[index] = 0;  //report maximum of iterations
+            break;
+          case 1: // cycles
+            strcat(buff," (CPU cycles)");
+            infostruct->legendtexts[index] = bi_strdup( buff );
+            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_2 );
+            infostruct->outlier_direction_upwards[index] = 1;  //report minimum of iterations
+            break;
+          default: break;
+        }
+      }
+   }
+}
+
+/** Implementation of the bi_init() of the BenchIT interface.
+ *  init data structures needed for kernel execution
+ */
+void* bi_init( int problemsizemax )
+{
+   unsigned long long i;
+   int src_node,dst_node;
+
+   /* measuring CPU allocates all buffers (in its local memory unless specified otherwise) */
+   cpu_set(CPU);
+
+   mdp->cpuinfo=cpuinfo;
+
+   /* overwrite detected clockrate if specified in PARAMETERS file*/
+   if (FREQUENCY){
+      mdp->cpuinfo->clockrate=FREQUENCY;
+   }
+   else if (mdp->cpuinfo->clockrate==0){
+      fprintf( stderr, "Error: CPU-Clockrate could not be estimated\n" );
+      exit( 1 );
+   }
+
+   /* overwrite cache parameters from hw_detection if specified in PARAMETERS file*/
+   if(L1_SIZE>=0){
+      mdp->cpuinfo->Cacheflushsize-=mdp->cpuinfo->U_Cache_Size[0];
+      mdp->cpuinfo->Cacheflushsize-=mdp->cpuinfo->D_Cache_Size[0];
+      mdp->cpuinfo->Cacheflushsize+=L1_SIZE;
+      mdp->cpuinfo->Cache_unified[0]=0;
+      mdp->cpuinfo->Cache_shared[0]=0;
+      mdp->cpuinfo->U_Cache_Size[0]=0;
+      mdp->cpuinfo->I_Cache_Size[0]=L1_SIZE;
+      mdp->cpuinfo->D_Cache_Size[0]=L1_SIZE;
+      CACHELEVELS=1;
+   }
+   if(L2_SIZE>=0){
+      mdp->cpuinfo->Cacheflushsize-=mdp->cpuinfo->U_Cache_Size[1];
+      mdp->cpuinfo->Cacheflushsize-=mdp->cpuinfo->D_Cache_Size[1];
+      mdp->cpuinfo->Cacheflushsize+=L2_SIZE;
+      mdp->cpuinfo->Cache_unified[1]=0;
+      mdp->cpuinfo->Cache_shared[1]=0;
+      mdp->cpuinfo->U_Cache_Size[1]=0;
+      mdp->cpuinfo->I_Cache_Size[1]=L2_SIZE;
+      mdp->cpuinfo->D_Cache_Size[1]=L2_SIZE;
+      CACHELEVELS=2;
+   }
+   if(L3_SIZE>=0){
+      mdp->cpuinfo->Cacheflushsize-=mdp->cpuinfo->U_Cache_Size[2];
+      mdp->cpuinfo->Cacheflushsize-=mdp->cpuinfo->D_Cache_Size[2];
+      mdp->cpuinfo->Cacheflushsize+=L3_SIZE;
+      mdp->cpuinfo->Cache_unified[2]=0;
+      mdp->cpuinfo->Cache_shared[2]=0;
+      mdp->cpuinfo->U_Cache_Size[2]=0;
+      mdp->cpuinfo->I_Cache_Size[2]=L3_SIZE;
+      mdp->cpuinfo->D_Cache_Size[2]=L3_SIZE;
+      CACHELEVELS=3;
+   }
+   if(L4_SIZE>=0){
+      mdp->cpuinfo->Cacheflushsize-=mdp->cpuinfo->U_Cache_Size[3];
+      mdp->cpuinfo->Cacheflushsize-=mdp->cpuinfo->D_Cache_Size[3];
+      mdp->cpuinfo->Cacheflushsize+=L4_SIZE;
+      mdp->cpuinfo->Cache_unified[3]=0;
+      mdp->cpuinfo->Cache_shared[3]=0;
+      mdp->cpuinfo->U_Cache_Size[3]=0;
+      mdp->cpuinfo->I_Cache_Size[3]=L4_SIZE;
+      mdp->cpuinfo->D_Cache_Size[3]=L4_SIZE;
+      CACHELEVELS=4;
+   }
+   if (CACHELINE){
+      mdp->cpuinfo->Cacheline_size[0]=CACHELINE;
+      mdp->cpuinfo->Cacheline_size[1]=CACHELINE;
+      mdp->cpuinfo->Cacheline_size[2]=CACHELINE;
+      mdp->cpuinfo->Cacheline_size[3]=CACHELINE;
+   }
+
+   mdp->NUM_FLUSHES=NUM_FLUSHES;
+   mdp->NUM_USES=NUM_USES;
+   mdp->FLUSH_MODE=FLUSH_MODE;
+   mdp->USE_MODE=USE_MODE;
+   mdp->USE_DIRECTION=USE_DIRECTION;
+   mdp->loop_overhead=LOOP_OVERHEAD_COMPENSATION;
+   mdp->repeat_bytes=REPEAT_BYTES;
+   mdp->runs=RUNS;
+   mdp->zva_size=zva_block_size();
+
+   /* calculate required memory for flushes (always allocate enough for LLC flush) */
+   CACHEFLUSHSIZE=mdp->cpuinfo->U_Cache_Size[3]+cpuinfo->U_Cache_Size[2]+mdp->cpuinfo->U_Cache_Size[1]+mdp->cpuinfo->U_Cache_Size[0];
+   CACHEFLUSHSIZE+=mdp->cpuinfo->D_Cache_Size[3]+mdp->cpuinfo->D_Cache_Size[2]+mdp->cpuinfo->D_Cache_Size[1]+mdp->cpuinfo->D_Cache_Size[0];
+   CACHEFLUSHSIZE*=100+EXTRA_FLUSH_SIZE;
+   CACHEFLUSHSIZE/=50; // double buffer size for implicit increase for LLC flushes
+
+   if (CACHEFLUSHSIZE>mdp->cpuinfo->Cacheflushsize){
+      mdp->cpuinfo->Cacheflushsize=CACHEFLUSHSIZE;
+   }
+   mdp->cache_flush_area=(char*)_mm_malloc(mdp->cpuinfo->Cacheflushsize,STRIDE);
+   if (mdp->cache_flush_area == 0){
+      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+   //fill cacheflush-area
+   for (i=0;i<mdp->cpuinfo->Cacheflushsize;i+=sizeof(unsigned long long)){
+      *((unsigned long long*)((unsigned long long)mdp->cache_flush_area+i))=(unsigned long long)i;
+   }
+   clflush(mdp->cache_flush_area,mdp->cpuinfo->Cacheflushsize,*(mdp->cpuinfo));
+
+   if (CACHELEVELS>mdp->cpuinfo->Cachelevels){
+      mdp->cpuinfo->Cachelevels=CACHELEVELS;
+   }
+
+   /* source and destination buffer, offsets are smaller than 4 KiB */
+   mdp->buffersize=(MAX+4096+STRIDE-1)&~(STRIDE-1);
+   src_node=(SRC_NODE<0)?numa_node_of_cpu(CPU):SRC_NODE;
+   dst_node=(DST_NODE<0)?numa_node_of_cpu(CPU):DST_NODE;
+   mdp->buffer=(char*) numa_alloc_onnode(mdp->buffersize,src_node);
+   mdp->dst_buffer=(char*) numa_alloc_onnode(mdp->buffersize,dst_node);
+   if ((mdp->buffer==NULL)||(mdp->dst_buffer==NULL)){
+      fprintf( stderr, "Error: Allocation of buffers failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+   for (i=0;i<mdp->buffersize;i+=sizeof(unsigned long long)){
+      *((unsigned long long*)((unsigned long long)mdp->buffer+i))=(unsigned long long)i;
+      *((unsigned long long*)((unsigned long long)mdp->dst_buffer+i))=(unsigned long long)i;
+   }
+   clflush(mdp->buffer,mdp->buffersize,*(mdp->cpuinfo));
+   clflush(mdp->dst_buffer,mdp->buffersize,*(mdp->cpuinfo));
+
+   printf("\n  measuring on CPU %i, source buffer in NUMA node %i, destination buffer in NUMA node %i\n",CPU,src_node,dst_node);
+   if (mdp->zva_size) printf("  dc zva block size: %llu Byte\n",mdp->zva_size);
+   else printf("  dc zva prohibited, dc zva results will be invalid\n");
+   fflush(stdout);
+
+  /* start watchdog thread */
+  watchdog_arg.pid=getpid();
+  watchdog_arg.timeout=TIMEOUT;
+  pthread_create(&watchdog,NULL,watchdog_timer,&watchdog_arg);
+
+  return (void*)mdp;
+}
+
+/** The central function within each kernel. This function
+ *  is called for each measurment step seperately.
+ *  @param  mdpv         a pointer to the structure created in bi_init,
+ *                       it is the pointer the bi_init returns
+ *  @param  problemsize  the actual problemsize
+ *  @param  results      a pointer to a field of doubles, the
+ *                       size of the field depends on the number
+ *                       of functions, there are #functions+1
+ *                       doubles
+ *  @return 0 if the measurment was sucessfull, something
+ *          else in the case of an error
+ */
+int inline bi_entry( void* mdpv, int problemsize, double* results )
+{
+  /* f,o,l are used for loop iterations */
+  int f = 0, o = 0, l = 0, k = 0;
+  /* size */
+  unsigned long long size;
+  /* cast void* pointer */
+  mydata_t* mdp = (mydata_t*)mdpv;
+
+  /* results */
+  double *tmp_results;
+
+  /* check wether the pointer to store the results in is valid or not */
+  if ( results == NULL ) return 1;
+
+  tmp_results=_mm_malloc(sizeof(double),64);
+
+  size = (unsigned long long) problemarray1[problemsize-1];
+  if (size==0) size=1;
+  results[0] = (double)size;
+
+  for (f=0;f<NUM_FUNCTIONS;f++)
+  {
+    for (o=0;o<NUM_OFFSETS;o++)
+    {
+      for (l=0;l<NUM_STATES;l++)
+      {
+        k=(f*NUM_OFFSETS+o)*NUM_STATES+l;
+
+        /* measure cycles per call */
+        _work(size,functions[f],src_offsets[o],dst_offsets[o],states[l],mdp,&tmp_results);
+
+        if (tmp_results[0]==INVALID_MEASUREMENT) {results[1+k]=INVALID_MEASUREMENT;results[1+NUM_RESULTS+k]=INVALID_MEASUREMENT;}
+        else {
+          results[1+k]=((double)size/(tmp_results[0]/(double)mdp->cpuinfo->clockrate))*0.000000001;
+          results[1+NUM_RESULTS+k]=tmp_results[0];
+        }
+      }
+    }
+  }
+  _mm_free(tmp_results);
+  return 0;
+}
+
+/** Clean up the memory
+ */
+void bi_cleanup( void* mdpv )
+{
+   mydata_t* mdp = (mydata_t*)mdpv;
+   pthread_kill(watchdog,SIGUSR1);
+
+   /* free resources */
+   if (mdp->buffer) numa_free(mdp->buffer,mdp->buffersize);
+   if (mdp->dst_buffer) numa_free(mdp->dst_buffer,mdp->buffersize);
+   if (mdp->cache_flush_area) _mm_free(mdp->cache_flush_area);
+   if (mdp->cpuinfo) _mm_free(mdp->cpuinfo);
+   _mm_free( mdp );
+   return;
+}
+
+/********************************************************************/
+/*************** End of interface implementations *******************/
+/********************************************************************/
+
+/* Reads the environment variables used by this kernel. */
+void evaluate_environment(bi_info * info)
+{
+   int i;
+   int errors = 0;
+   char * p = 0;
+
+   cpuinfo=(cpu_info_t*)_mm_malloc( sizeof( cpu_info_t ),64);memset((void*)cpuinfo,0,sizeof( cpu_info_t ));
+   if ( cpuinfo == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure cpuinfo_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+   init_cpuinfo(cpuinfo,1);
+
+   mdp = (mydata_t*)_mm_malloc( sizeof( mydata_t ),64);memset((void*)mdp,0, sizeof( mydata_t ));
+   if ( mdp == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+
+   error_msg=malloc(256);
+
+   /* generate ordered list of sizes in problemarray1*/
+   p = bi_getenv( "BENCHIT_KERNEL_PROBLEMLIST", 0 );
+   if ( p == 0 ){
+     unsigned long long MIN;
+     int STEPS;
+     double MemFactor;
+     p = bi_getenv("BENCHIT_KERNEL_MIN",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MIN not set");}
+     else MIN=atoll(p);
+     p = bi_getenv("BENCHIT_KERNEL_MAX",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MAX not set");}
+     else MAX=atoll(p);
+     p = bi_getenv("BENCHIT_KERNEL_STEPS",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_STEPS not set");}
+     else STEPS=atoi(p);
+     if ( errors == 0){
+       problemarray1=malloc(STEPS*sizeof(double));
+       MemFactor =((double)MAX)/((double)MIN);
+       MemFactor = pow(MemFactor, 1.0/((double)STEPS-1));
+       for (i=0;i<STEPS;i++){
+          problemarray1[i] = floor(((double)MIN)*pow(MemFactor, i));
+       }
+       problemlistsize=STEPS;
+       problemarray1[STEPS-1]=(double)MAX;
+     }
+   }
+   else{
+     fflush(stdout);printf("BenchIT: parsing list of problemsizes: ");
+     bi_parselist(p);
+     problemlist = info->list;
+     problemlistsize = info->listsize;
+     problemarray1=malloc(problemlistsize*sizeof(double));
+     for (i=0;i<problemlistsize;i++){
+        problemarray1[i]=problemlist->dnumber;
+        if (problemlist->pnext!=NULL) problemlist=problemlist->pnext;
+        if (problemarray1[i]>MAX) MAX=problemarray1[i];
+     }
+   }
+
+   p = bi_getenv( "BENCHIT_KERNEL_CPU", 0 );
+   if ( p != 0 ) CPU = atoi( p );
+   else {
+     for (CPU=0;CPU<CPU_SETSIZE;CPU++) if (cpu_allowed(CPU)) break;
+   }
+   if (!cpu_allowed(CPU)) {errors++;sprintf(error_msg,"selected CPU not allowed");}
+
+   p = bi_getenv( "BENCHIT_KERNEL_SRC_NODE", 0 );
+   if ( p != 0 ) SRC_NODE = atoi( p );
+   p = bi_getenv( "BENCHIT_KERNEL_DST_NODE", 0 );
+   if ( p != 0 ) DST_NODE = atoi( p );
+   if ((SRC_NODE>numa_max_node())||(DST_NODE>numa_max_node())) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_SRC_NODE or BENCHIT_KERNEL_DST_NODE");}
+
+   if (bi_getenv( "BENCHIT_KERNEL_FUNCTIONS", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_FUNCTIONS", 0 ));else p=NULL;
+   if (p==0) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_FUNCTIONS not set");}
+   else {
+     char *q;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       if (NUM_FUNCTIONS==MAX_FUNCTIONS) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_FUNCTIONS");}
+       else if (!strcmp(p,"memcpy")) functions[NUM_FUNCTIONS++]=FUNC_MEMCPY;
+       else if (!strcmp(p,"memmove")) functions[NUM_FUNCTIONS++]=FUNC_MEMMOVE;
+       else if (!strcmp(p,"ldp_stp")) functions[NUM_FUNCTIONS++]=FUNC_NEON_COPY;
+       else if (!strcmp(p,"memset")) functions[NUM_FUNCTIONS++]=FUNC_MEMSET;
+       else if (!strcmp(p,"stp")) functions[NUM_FUNCTIONS++]=FUNC_NEON_SET;
+       else if (!strcmp(p,"dc_zva")) functions[NUM_FUNCTIONS++]=FUNC_DC_ZVA;
+       else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_FUNCTIONS (memcpy|memmove|ldp_stp|memset|stp|dc_zva)");}
+       p=q;
+     }while(p!=NULL);
+   }
+
+   if (bi_getenv( "BENCHIT_KERNEL_OFFSETS", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_OFFSETS", 0 ));else p=NULL;
+   if (p==0) {src_offsets[0]=0;dst_offsets[0]=0;NUM_OFFSETS=1;}
+   else {
+     char *q,*r;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       r=strstr(p,":");if (r) {*r='\0';r++;}
+       if (NUM_OFFSETS==MAX_OFFSETS) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_OFFSETS");}
+       else {
+         src_offsets[NUM_OFFSETS]=atoi(p);
+         dst_offsets[NUM_OFFSETS]=(r)?atoi(r):atoi(p);
+         if ((src_offsets[NUM_OFFSETS]<0)||(src_offsets[NUM_OFFSETS]>=4096)||(dst_offsets[NUM_OFFSETS]<0)||(dst_offsets[NUM_OFFSETS]>=4096)) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_OFFSETS (0-4095)");}
+         NUM_OFFSETS++;
+       }
+       p=q;
+     }while(p!=NULL);
+   }
+
+   if (bi_getenv( "BENCHIT_KERNEL_CACHE_STATES", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_CACHE_STATES", 0 ));else p=NULL;
+   if (p==0) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_CACHE_STATES not set");}
+   else {
+     char *q;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       if (NUM_STATES==MAX_STATES) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_CACHE_STATES");}
+       else if (!strcmp(p,"L1")) states[NUM_STATES++]=STATE_L1;
+       else if (!strcmp(p,"L2")) states[NUM_STATES++]=STATE_L2;
+       else if (!strcmp(p,"LLC")) states[NUM_STATES++]=STATE_LLC;
+       else if (!strcmp(p,"cold")) states[NUM_STATES++]=STATE_COLD;
+       else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_CACHE_STATES (L1|L2|LLC|cold)");}
+       p=q;
+     }while(p!=NULL);
+   }
+   NUM_RESULTS=NUM_FUNCTIONS*NUM_OFFSETS*NUM_STATES;
+
+   p = bi_getenv( "BENCHIT_KERNEL_REPEAT_BYTES", 0 );
+   if ( p != 0 ) REPEAT_BYTES = atoll( p );
+   if (REPEAT_BYTES==0) REPEAT_BYTES=65536;
+
+   p = bi_getenv( "BENCHIT_KERNEL_CPU_FREQUENCY", 0 );
+   if ( p != 0 ) FREQUENCY = atoll( p );
+   p = bi_getenv( "BENCHIT_KERNEL_L1_SIZE", 0 );
+   if ( p != 0 ) L1_SIZE = atoll( p );
+   p = bi_getenv( "BENCHIT_KERNEL_L2_SIZE", 0 );
+   if ( p != 0 ) L2_SIZE = atoll( p );
+   p = bi_getenv( "BENCHIT_KERNEL_L3_SIZE", 0 );
+   if ( p != 0 ) L3_SIZE = atoll( p );
+   p = bi_getenv( "BENCHIT_KERNEL_L4_SIZE", 0 );
+   if ( p != 0 ) L4_SIZE = atoll( p );
+   p = bi_getenv( "BENCHIT_KERNEL_CACHELINE_SIZE", 0 );
+   if ( p != 0 ) CACHELINE = atoi( p );
+
+   p = bi_getenv( "BENCHIT_KERNEL_FLUSH_ACCESSES", 0 );
+   if ( p != 0 ) NUM_FLUSHES = atoi( p );
+   else NUM_FLUSHES=1;
+
+   p = bi_getenv( "BENCHIT_KERNEL_FLUSH_MODE", 0 );
+   if ( p == 0 ) FLUSH_MODE=MODE_EXCLUSIVE;
+   else{
+     if (!strcmp(p,"M")) FLUSH_MODE=MODE_MODIFIED;
+     else if (!strcmp(p,"E")) FLUSH_MODE=MODE_EXCLUSIVE;
+     else if (!strcmp(p,"I")) FLUSH_MODE=MODE_INVALID;
+     else if (!strcmp(p,"R")) FLUSH_MODE=MODE_RDONLY;
+     else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_FLUSH_MODE");};
+   }
+
+   p = bi_getenv( "BENCHIT_KERNEL_FLUSH_EXTRA", 0 );
+   if ( p != 0 ) EXTRA_FLUSH_SIZE = atoi( p );
+   if ((EXTRA_FLUSH_SIZE < 0) || (EXTRA_FLUSH_SIZE > 1000)){
+     errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_FLUSH_EXTRA");
+   }
+   else{
+     cpuinfo->EXTRA_FLUSH_SIZE=100+EXTRA_FLUSH_SIZE;
+   }
+
+   p=bi_getenv( "BENCHIT_KERNEL_DISABLE_CLFLUSH", 0 );
+   if (p!=0) DISABLE_CLFLUSH=atoi(p);
+   cpuinfo->disable_clflush=DISABLE_CLFLUSH;
+
+   p = bi_getenv( "BENCHIT_KERNEL_USE_ACCESSES", 0 );
+   if ( p != 0 ) NUM_USES = atoi( p );
+   else NUM_USES=1;
+
+   p = bi_getenv( "BENCHIT_KERNEL_USE_MODE", 0 );
+   if ( p == 0 ) USE_MODE=MODE_EXCLUSIVE;
+   else{
+     if (!strcmp(p,"M")) USE_MODE=MODE_MODIFIED;
+     else if (!strcmp(p,"E")) USE_MODE=MODE_EXCLUSIVE;
+     else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_USE_MODE (M|E)");}
+   }
+
+   p = bi_getenv( "BENCHIT_KERNEL_USE_DIRECTION", 0 );
+   if ( p == 0 ) USE_DIRECTION=FIFO;
+   else {
+     if (!strcmp(p,"LIFO")) USE_DIRECTION=LIFO;
+     else if (!strcmp(p,"FIFO")) USE_DIRECTION=FIFO;
+     else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_USE_DIRECTION");}
+   }
+
+   p = bi_getenv( "BENCHIT_KERNEL_RUNS", 0 );
+   if ( p != 0 ) RUNS = atoi( p );
+   if (RUNS<1) RUNS=1;
+
+   p=bi_getenv( "BENCHIT_KERNEL_LOOP_OVERHEAD_COMPENSATION", 0 );
+   if (p!=0)
+   {
+     if (!strcmp(p,"enabled")) {
+       int tmp_ovrhd;
+       LOOP_OVERHEAD_COMPENSATION=asm_loop_overhead(10000);
+       for (i=0;i<1000;i++){
+         tmp_ovrhd=asm_loop_overhead(10000);
+         if (tmp_ovrhd<LOOP_OVERHEAD_COMPENSATION){
+           i=0;
+           LOOP_OVERHEAD_COMPENSATION=tmp_ovrhd;
+         }
+       }
+     }
+     else if (!strcmp(p,"disabled")) {LOOP_OVERHEAD_COMPENSATION=0;}
+     else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_LOOP_OVERHEAD_COMPENSATION");}
+   }
+
+   p=bi_getenv( "BENCHIT_KERNEL_TIMEOUT", 0 );
+   if (p!=0){
+     TIMEOUT=atoi(p);
+   }
+
+   p=bi_getenv( "BENCHIT_KERNEL_SERIALIZATION", 0 );
+   if ((p!=0)&&(strcmp(p,"mfence"))&&(strcmp(p,"cpuid"))&&(strcmp(p,"disabled"))) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_SERIALIZATION");}
+
+   if ( errors > 0 ) {
+      fprintf( stderr, "Error: There's an environment variable not set or invalid!\n" );
+      fprintf( stderr, "%s\n", error_msg);
+      exit( 1 );
+   }
+   free(error_msg);
+}
@@ -0,0 +1,306 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: compares memcpy/memmove/memset implementations for different sizes, alignments, and cache states.
+ ******************************************************************************************************/
+
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+/* report average instead of best result */
+//#define AVERAGE
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: %0: stop timestamp
+         *         %1: start timestamp
+         */
+          __asm__ __volatile__(
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+        if ((a-b)<ret) ret=(a-b);
+   }
+  return (int)ret;
+}
+
+/** read block size of dc zva
+ *  returns 0 if dc zva is prohibited (DZP bit set)
+ */
+unsigned long long zva_block_size(void)
+{
+   unsigned long long dczid=0x10;
+
+   #if defined(__aarch64__)
+   __asm__ __volatile__("mrs %0,dczid_el0\n\t" : "=r"(dczid));
+   #endif
+   if (dczid&0x10) return 0;
+   return 4ULL<<(dczid&0xf);
+}
+
+/** copy using ldp q/stp q (64 Byte per iteration), remaining Bytes with ldr q/str q and ldrb/strb
+ */
+static void neon_copy(char *dst, char *src, unsigned long long n) __attribute__((noinline));
+static void neon_copy(char *dst, char *src, unsigned long long n)
+{
+     /*
+      * Input:  %0: dst (pointer to the destination buffer)
+      *         %1: src (pointer to the source buffer)
+      *         %2: n (number of Bytes)
+      */
+     __asm__ __volatile__(
+                "cmp %2,#64\n\t"
+                "b.lo 2f\n\t"
+                ".align 6\n\t"
+                "1:\n\t"
+                "ldp q0,q1,[%1]\n\t"
+                "ldp q2,q3,[%1,#32]\n\t"
+                "stp q0,q1,[%0]\n\t"
+                "stp q2,q3,[%0,#32]\n\t"
+                "add %1,%1,#64\n\t"
+                "add %0,%0,#64\n\t"
+                "sub %2,%2,#64\n\t"
+                "cmp %2,#64\n\t"
+                "b.hs 1b\n\t"
+                "2:\n\t"
+                "cmp %2,#16\n\t"
+                "b.lo 3f\n\t"
+                "ldr q0,[%1],#16\n\t"
+                "str q0,[%0],#16\n\t"
+                "sub %2,%2,#16\n\t"
+                "b 2b\n\t"
+                "3:\n\t"
+                "cbz %2,4f\n\t"
+                "ldrb w9,[%1],#1\n\t"
+                "strb w9,[%0],#1\n\t"
+                "sub %2,%2,#1\n\t"
+                "b 3b\n\t"
+                "4:\n\t"
+		: "+r"(dst),"+r"(src),"+r"(n)
+                :
+                : "cc","memory","x9","v0","v1","v2","v3"
+     );
+}
+
+/** set to zero using stp q (64 Byte per iteration), remaining Bytes with str q and strb
+ */
+static void neon_set(char *dst, unsigned long long n) __attribute__((noinline));
+static void neon_set(char *dst, unsigned long long n)
+{
+     /*
+      * Input:  %0: dst (pointer to the destination buffer)
+      *         %1: n (number of Bytes)
+      */
+     __asm__ __volatile__(
+                "movi v0.16b,#0\n\t"
+                "cmp %1,#64\n\t"
+                "b.lo 2f\n\t"
+                ".align 6\n\t"
+                "1:\n\t"
+                "stp q0,q0,[%0]\n\t"
+                "stp q0,q0,[%0,#32]\n\t"
+                "add %0,%0,#64\n\t"
+                "sub %1,%1,#64\n\t"
+                "cmp %1,#64\n\t"
+                "b.hs 1b\n\t"
+                "2:\n\t"
+                "cmp %1,#16\n\t"
+                "b.lo 3f\n\t"
+                "str q0,[%0],#16\n\t"
+                "sub %1,%1,#16\n\t"
+                "b 2b\n\t"
+                "3:\n\t"
+                "cbz %1,4f\n\t"
+                "strb wzr,[%0],#1\n\t"
+                "sub %1,%1,#1\n\t"
+                "b 3b\n\t"
+                "4:\n\t"
+		: "+r"(dst),"+r"(n)
+                :
+                : "cc","memory","v0"
+     );
+}
+
+/** set to zero using dc zva for all complete blocks of zva_size Bytes, neon_set() for the unaligned head and tail
+ */
+static void dc_zva(char *dst, unsigned long long n, unsigned long long zva_size) __attribute__((noinline));
+static void dc_zva(char *dst, unsigned long long n, unsigned long long zva_size)
+{
+   unsigned long long head;
+
+   head=(zva_size-((unsigned long long)dst&(zva_size-1)))&(zva_size-1);
+   if (head>n) head=n;
+   if (head) {neon_set(dst,head);dst+=head;n-=head;}
+   if (n>=zva_size){
+     /*
+      * Input:  %0: dst (pointer to the destination buffer, aligned to zva_size)
+      *         %1: n (number of Bytes, decremented until less than zva_size Bytes remain)
+      *         %2: zva_size
+      */
+     __asm__ __volatile__(
+                ".align 6\n\t"
+                "1:\n\t"
+                "dc zva,%0\n\t"
+                "add %0,%0,%2\n\t"
+                "sub %1,%1,%2\n\t"
+                "cmp %1,%2\n\t"
+                "b.hs 1b\n\t"
+		: "+r"(dst),"+r"(n)
+                : "r"(zva_size)
+                : "cc","memory"
+     );
+   }
+   if (n) neon_set(dst,n);
+}
+
+/** calls the selected implementation calls times
+ */
+static void call_function(int function, char *dst, char *src, unsigned long long size, unsigned long long calls, unsigned long long zva_size)
+{
+  unsigned long long i;
+
+  for (i=0;i<calls;i++){
+    switch (function){
+      case FUNC_MEMCPY: memcpy(dst,src,size); break;
+      case FUNC_MEMMOVE: memmove(dst,src,size); break;
+      case FUNC_NEON_COPY: neon_copy(dst,src,size); break;
+      case FUNC_MEMSET: memset(dst,0,size); break;
+      case FUNC_NEON_SET: neon_set(dst,size); break;
+      case FUNC_DC_ZVA: dc_zva(dst,size,zva_size); break;
+      default: break;
+    }
+  }
+}
+
+/** read timestamp counter
+ */
+static inline unsigned long long timestamp(void)
+{
+   unsigned long long ts;
+
+   __asm__ __volatile__(
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(ts)
+                :
+                : "memory"
+   );
+   return ts;
+}
+
+/** size of the memory area that is prepared, use_memory() accesses complete cache lines starting at the buffer
+ */
+static inline unsigned long long prep_size(unsigned long long size)
+{
+  return (size+STRIDE-1)&~(STRIDE-1);
+}
+
+/** brings a buffer into the requested cache state
+ *  - STATE_L1:   buffer is used with mode USE_MODE
+ *  - STATE_L2:   buffer is used, afterwards L1 is flushed
+ *  - STATE_LLC:  buffer is used, afterwards the level above the last level cache is flushed
+ *  - STATE_COLD: buffer is invalidated in all caches
+ *  buffers that are larger than the selected cache level are partially in the next level
+ *  returns -1 if the cache state is not supported by the detected cache hierarchy
+ */
+static int prepare_buffer(char *buffer, unsigned long long size, int state, volatile mydata_t *data)
+{
+  int level;
+
+  if (state==STATE_COLD){
+    use_memory(buffer,data->cache_flush_area,size,MODE_INVALID,data->USE_DIRECTION,0,*(data->cpuinfo));
+    return 0;
+  }
+  use_memory(buffer,data->cache_flush_area,size,data->USE_MODE,data->USE_DIRECTION,data->NUM_USES,*(data->cpuinfo));
+  switch (state){
+    case STATE_L2: level=1; break;
+    case STATE_LLC: level=data->cpuinfo->Cachelevels-1; break;
+    default: level=0; break;
+  }
+  if ((state!=STATE_L1)&&(level<1)) return -1;
+  if (level) if (cacheflush(level,data->NUM_FLUSHES,data->FLUSH_MODE,data->cache_flush_area,*(data->cpuinfo))<0) return -1;
+  return 0;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - source (copy functions only) and destination buffer are prepared in the requested cache state before every run
+ *   - STATE_L1: calls for small sizes are repeated until data->repeat_bytes Bytes are processed,
+ *     all other states measure a single call, as repeated calls would find the data in L1
+ *   - (*results)[0]: cycles per call (minimum of all runs)
+ */
+void _work(unsigned long long size, int function, int src_offset, int dst_offset, int state, volatile mydata_t* data, double **results)
+{
+  int i;
+  unsigned long long calls,start,end,tmp;
+  char *src,*dst;
+  double t,tmin;
+
+  src=data->buffer+src_offset;
+  dst=data->dst_buffer+dst_offset;
+
+  if ((function==FUNC_DC_ZVA)&&(data->zva_size==0)) {(*results)[0]=INVALID_MEASUREMENT;return;}
+
+  calls=1;
+  if ((state==STATE_L1)&&(size<data->repeat_bytes)) calls=data->repeat_bytes/size;
+
+  #ifdef AVERAGE
+   tmin=0;
+  #else
+   tmin=(double)ULLONG_MAX;
+  #endif
+
+  for (i=0;i<data->runs;i++)
+  {
+    if (IS_COPY(function)) if (prepare_buffer(data->buffer,prep_size(size+src_offset),state,data)<0) {(*results)[0]=INVALID_MEASUREMENT;return;}
+    if (prepare_buffer(data->dst_buffer,prep_size(size+dst_offset),state,data)<0) {(*results)[0]=INVALID_MEASUREMENT;return;}
+
+    start=timestamp();
+    call_function(function,dst,src,size,calls,data->zva_size);
+    end=timestamp();
+
+    tmp=end-start;
+    if (tmp>data->loop_overhead) tmp-=data->loop_overhead;
+    t=(double)tmp/(double)calls;
+    #ifdef AVERAGE
+      tmin+=t;
+    #else
+      if (t<tmin) tmin=t;
+    #endif
+  }
+  #ifdef AVERAGE
+  tmin/=data->runs;
+  #endif
+
+  if (tmin>0) (*results)[0]=tmin;
+  else (*results)[0]=INVALID_MEASUREMENT;
+}
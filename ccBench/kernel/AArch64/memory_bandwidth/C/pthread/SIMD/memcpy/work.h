@@ -0,0 +1,78 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: compares memcpy/memmove/memset implementations for different sizes, alignments, and cache states.
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "memcpy/memset implementation comparison"
+#define CODE_SEQUENCE       "memcpy/memmove/memset (glibc), ldp q/stp q, stp q, dc zva"
+#define X_AXIS_TEXT         "size [Byte]"
+#define Y_AXIS_TEXT_1       "bandwidth [GB/s]"
+#define Y_AXIS_TEXT_2       "cycles per call"
+
+/* implementations */
+#define FUNC_MEMCPY     0                               // glibc memcpy()
+#define FUNC_MEMMOVE    1                               // glibc memmove()
+#define FUNC_NEON_COPY  2                               // ldp q/stp q loop
+#define FUNC_MEMSET     3                               // glibc memset()
+#define FUNC_NEON_SET   4                               // stp q loop
+#define FUNC_DC_ZVA     5                               // dc zva loop
+#define IS_COPY(f)      ((f)<FUNC_MEMSET)
+
+/* cache state of the buffers before each call */
+#define STATE_L1        1                               // used by the measuring CPU
+#define STATE_L2        2                               // used, L1 flushed
+#define STATE_LLC       3                               // used, all levels except the last level cache flushed
+#define STATE_COLD      4                               // invalidated in all caches
+
+/* maximal number of entries in BENCHIT_KERNEL_FUNCTIONS, BENCHIT_KERNEL_OFFSETS, and BENCHIT_KERNEL_CACHE_STATES */
+#define MAX_FUNCTIONS   6
+#define MAX_OFFSETS     16
+#define MAX_STATES      4
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* buffer;                                        // source buffer
+   char* dst_buffer;                                    // destination buffer
+   char* cache_flush_area;
+   cpu_info_t *cpuinfo;
+   unsigned long long buffersize;
+   unsigned long long repeat_bytes;                     // L1 state: small calls are repeated until this many Bytes are processed
+   unsigned long long zva_size;                         // block size of dc zva, 0 if prohibited
+   unsigned int loop_overhead;
+   int runs;
+   unsigned char NUM_FLUSHES;
+   unsigned char NUM_USES;
+   unsigned char FLUSH_MODE;
+   unsigned char USE_DIRECTION;
+   unsigned char USE_MODE;
+} mydata_t;
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n);
+
+/* read block size of dc zva (0 if dc zva is prohibited) */
+unsigned long long zva_block_size(void);
+
+/** function that performs the measurement
+ *  - (*results)[0]: cycles per call of function for size Bytes with the given source and destination offsets
+ *                   in the given cache state
+ */
+void _work(unsigned long long size, int function, int src_offset, int dst_offset, int state, volatile mydata_t* data, double **results);
+
+#endif
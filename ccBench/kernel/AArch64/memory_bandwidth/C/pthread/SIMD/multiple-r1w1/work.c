@@ -0,0 +1,1687 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures aggregate copy (read+write) bandwidth of multiple CPUs accessing data in their own caches or memory concurrently,
+ *         source and destination buffers can be placed in different NUMA nodes.
+ ******************************************************************************************************/
+ 
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+#ifdef USE_PAPI
+#include <papi.h>
+#endif
+
+
+/*
+ * THREAD_INIT_DST: allocates and initializes the destination buffer of a helper thread in the NUMA node of dst_mem_bind
+ */
+static void init_dst_buffer(volatile mydata_t *global_data,threaddata_t *mydata)
+{
+  unsigned int numa_node;
+  struct bitmask *numa_bitmask;
+  char* filename=NULL;
+  int fd;
+
+  if(!mydata->buffersize)
+  {
+    mydata->dst_aligned_addr=(unsigned long long)(global_data->dst_buffer) + mydata->offset;
+    return;
+  }
+
+  cpu_set(mydata->dst_mem_bind);
+  numa_node = numa_node_of_cpu(mydata->dst_mem_bind);
+  numa_bitmask = numa_bitmask_alloc((unsigned int) numa_max_possible_node());
+  numa_bitmask = numa_bitmask_clearall(numa_bitmask);
+  numa_bitmask = numa_bitmask_setbit(numa_bitmask, numa_node);
+  numa_set_membind(numa_bitmask);
+  numa_bitmask_free(numa_bitmask);
+
+  if (global_data->hugepages==HUGEPAGES_OFF) mydata->dst_buffer = (void *) _mm_malloc( mydata->buffersize,mydata->alignment);
+  if (global_data->hugepages==HUGEPAGES_ON)
+  {
+    char *dir;
+    dir=bi_getenv("BENCHIT_KERNEL_HUGEPAGE_DIR",0);
+    filename=(char*)malloc((strlen(dir)+20)*sizeof(char));
+    sprintf(filename,"%s/thread_dst_%i",dir,mydata->thread_id);
+    mydata->dst_buffer=NULL;
+    fd=open(filename,O_CREAT|O_RDWR,0664);
+    if (fd == -1)
+    {
+      fprintf( stderr, "Allocation of buffer failed\n" ); fflush( stderr );
+      perror("open");
+      exit( 127 );
+    } 
+    mydata->dst_buffer=(char*) mmap(NULL,mydata->buffersize,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+    close(fd);unlink(filename);
+  } 
+  init_buffer(mydata->dst_buffer,0,mydata->buffersize);
+  clflush(mydata->dst_buffer,mydata->buffersize,*(mydata->cpuinfo));
+  mydata->dst_aligned_addr=(unsigned long long)(mydata->dst_buffer) + mydata->offset;
+
+  cpu_set(mydata->cpu_id);
+}
+
+/* concurrent measurement of the helper threads, defined after the assembler routines */
+static void thread_work(volatile mydata_t *global_data,threaddata_t *mydata);
+
+/* accesses of the code prefetch runs of the measurement routines, enough for one loop iteration (64 accesses) */
+#define CODE_PREFETCH_ACCESSES 64
+
+/* accesses of the measuring CPU and the helper threads in USE MODE ADAPTION and thread() */
+#define LOCAL_USE_MEMORY(data,addr,memsize,mode) use_memory((void*)(addr),data->cache_flush_area,memsize,mode,data->USE_DIRECTION,data->NUM_USES,*(data->cpuinfo))
+#define HELPER_USE_MEMORY(global_data,mydata) use_memory((void*)mydata->aligned_addr,mydata->cache_flush_area,mydata->memsize,mydata->USE_MODE,mydata->USE_DIRECTION,mydata->NUM_USES,*(mydata->cpuinfo))
+#define HELPER_COMMAND(global_data,mydata,cmd) if (cmd==THREAD_INIT_DST) init_dst_buffer(global_data,mydata); \
+                                               else if (cmd==THREAD_WORK) thread_work(global_data,mydata)
+/* memsize is the size of one buffer, source and destination are flushed */
+#define FLUSH_SIZE(memsize) (2*(memsize))
+#include "membench_thread.h"
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,c,d,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: RAX: stop timestamp 
+         *         RBX: start timestamp
+         */
+        __asm__ __volatile__(
+               //"mov $1,%%rcx;"
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+//                "jmp _work_loop_overhead;"
+//                ".align 64,0x0;"
+//                "_work_loop_overhead:"
+//                "sub $1,%%rcx;"
+//                "jnz _work_loop_overhead;"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+	if ((a-b)<ret) ret=(a-b);
+   }			
+  return (int)ret;
+}
+
+/** assembler implementation of copy bandwidth measurement using ldr/str (128 bit) instructions
+ *  data==NULL disables PAPI measurements (used by helper threads)
+ */
+static double asm_work_ldr128(unsigned long long addr, unsigned long long dst_addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_ldr128(unsigned long long addr, unsigned long long dst_addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   #ifdef USE_PAPI
+    if ((data)&&(data->num_events)) PAPI_reset(data->Eventset);
+   #endif
+   switch (burst_length)
+   {
+    case 1:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the source buffer)
+       *         %2: dst_addr (pointer to the destination buffer)
+       *         %3: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_ldr128_1\n\t"
+                ".align 6\n\t"
+                "_work_loop_ldr128_1:\n\t"
+//ldr 128 -> str 128
+		"ldr q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#0]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#16]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#32]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#48]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#48]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#64]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#80]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#96]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#112]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#112]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#128]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#144]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#160]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#176]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#176]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#192]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#208]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#224]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#240]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#240]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#256]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#272]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#288]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#304]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#304]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#320]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#336]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#352]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#368]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#368]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#384]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#400]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#416]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#432]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#432]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#448]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#464]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#480]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#496]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#496]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#512]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#528]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#544]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#560]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#560]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#576]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#592]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#608]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#624]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#624]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#640]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#656]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#672]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#688]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#688]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#704]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#720]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#736]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#752]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#752]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#768]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#784]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#800]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#816]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#816]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#832]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#848]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#864]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#880]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#880]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#896]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#912]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#928]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#944]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#944]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#960]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#976]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#992]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#1008]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+
+		"subs %3,%3,#1\n\t"
+                "bne _work_loop_ldr128_1\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r"(dst_addr), "r" (passes)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"
+      );
+      /* 1024 Byte read and 1024 Byte written per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 2:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the source buffer)
+       *         %2: dst_addr (pointer to the destination buffer)
+       *         %3: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_ldr128_2\n\t"
+                ".align 6\n\t"
+                "_work_loop_ldr128_2:\n\t"
+//ldr 128 -> str 128
+		"ldr q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#16]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#48]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#32]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#48]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#64]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#80]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#112]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#96]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#112]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#144]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#176]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#160]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#176]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#192]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#208]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#240]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#224]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#240]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#272]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#304]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#288]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#304]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#320]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#336]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#368]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#352]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#368]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#400]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#432]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#416]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#432]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#448]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#464]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#496]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#480]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#496]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#528]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#560]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#544]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#560]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#576]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#592]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#624]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#608]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#624]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#656]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#688]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#672]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#688]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#704]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#720]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#752]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#736]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#752]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#784]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#816]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#800]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#816]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#832]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#848]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#880]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#864]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#880]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#912]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#944]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#928]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#944]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#960]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#976]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#1008]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#992]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+
+		"subs %3,%3,#1\n\t"
+                "bne _work_loop_ldr128_2\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r"(dst_addr), "r" (passes)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"
+      );
+      /* 1024 Byte read and 1024 Byte written per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 4:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the source buffer)
+       *         %2: dst_addr (pointer to the destination buffer)
+       *         %3: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_ldr128_4\n\t"
+                ".align 6\n\t"
+                "_work_loop_ldr128_4:\n\t"
+//ldr 128 -> str 128
+		"ldr q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#48]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#16]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#32]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#48]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#112]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#64]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#80]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#96]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#112]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#176]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#144]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#160]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#176]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#240]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#192]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#208]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#224]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#240]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#304]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#272]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#288]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#304]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#368]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#320]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#336]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#352]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#368]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#432]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#400]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#416]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#432]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#496]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#448]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#464]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#480]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#496]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#560]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#528]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#544]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#560]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#624]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#576]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#592]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#608]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#624]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#688]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#656]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#672]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#688]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#752]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#704]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#720]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#736]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#752]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#816]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#784]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#800]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#816]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#880]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#832]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#848]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#864]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#880]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#944]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#912]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#928]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#944]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#1008]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#960]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#976]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#992]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+
+		"subs %3,%3,#1\n\t"
+                "bne _work_loop_ldr128_4\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r"(dst_addr), "r" (passes)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"
+      );
+      /* 1024 Byte read and 1024 Byte written per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 8:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the source buffer)
+       *         %2: dst_addr (pointer to the destination buffer)
+       *         %3: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_ldr128_8\n\t"
+                ".align 6\n\t"
+                "_work_loop_ldr128_8:\n\t"
+//ldr 128 -> str 128
+		"ldr q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#48]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#112]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#16]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#32]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#48]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#64]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#80]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#96]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#112]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#176]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#240]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#144]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#160]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#176]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#192]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#208]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#224]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#240]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#304]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#368]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#272]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#288]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#304]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#320]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#336]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#352]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#368]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#432]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#496]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#400]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#416]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#432]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#448]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#464]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#480]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#496]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#560]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#624]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#528]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#544]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#560]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#576]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#592]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#608]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#624]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#688]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#752]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#656]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#672]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#688]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#704]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#720]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#736]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#752]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#816]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#880]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#784]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#800]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#816]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#832]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#848]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#864]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#880]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#944]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#1008]\n\t"NOP(NOPCOUNT)
+		"str q0,[%2,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#912]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#928]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#944]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#960]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#976]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#992]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+
+		"subs %3,%3,#1\n\t"
+                "bne _work_loop_ldr128_8\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r"(dst_addr), "r" (passes)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"
+      );
+      /* 1024 Byte read and 1024 Byte written per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    default: ret=0.0;break;
+   }
+
+  #ifdef USE_PAPI
+    if ((data)&&(data->num_events)) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** assembler implementation of copy bandwidth measurement using ldp/stp (2x128 bit) instructions
+ *  data==NULL disables PAPI measurements (used by helper threads)
+ */
+static double asm_work_ldp128(unsigned long long addr, unsigned long long dst_addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_ldp128(unsigned long long addr, unsigned long long dst_addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   #ifdef USE_PAPI
+    if ((data)&&(data->num_events)) PAPI_reset(data->Eventset);
+   #endif
+   switch (burst_length)
+   {
+    case 2:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the source buffer)
+       *         %2: dst_addr (pointer to the destination buffer)
+       *         %3: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_ldp128_2\n\t"
+                ".align 6\n\t"
+                "_work_loop_ldp128_2:\n\t"
+//ldp 128 -> stp 128
+		"ldp q0,q1,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#0]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#32]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#64]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#96]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#128]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#160]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#192]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#224]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#256]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#288]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#320]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#352]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#384]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#416]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#448]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#480]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#512]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#544]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#576]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#608]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#640]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#672]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#704]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#736]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#768]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#800]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#832]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#864]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#896]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#928]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#960]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#992]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+
+		"subs %3,%3,#1\n\t"
+                "bne _work_loop_ldp128_2\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r"(dst_addr), "r" (passes)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"
+      );
+      /* 1024 Byte read and 1024 Byte written per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 4:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the source buffer)
+       *         %2: dst_addr (pointer to the destination buffer)
+       *         %3: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_ldp128_4\n\t"
+                ".align 6\n\t"
+                "_work_loop_ldp128_4:\n\t"
+//ldp 128 -> stp 128
+		"ldp q0,q1,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#0]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#32]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#64]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#96]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#128]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#160]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#192]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#224]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#256]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#288]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#320]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#352]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#384]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#416]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#448]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#480]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#512]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#544]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#576]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#608]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#640]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#672]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#704]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#736]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#768]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#800]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#832]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#864]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#896]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#928]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#960]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#992]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+
+		"subs %3,%3,#1\n\t"
+                "bne _work_loop_ldp128_4\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r"(dst_addr), "r" (passes)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"
+      );
+      /* 1024 Byte read and 1024 Byte written per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 8:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the source buffer)
+       *         %2: dst_addr (pointer to the destination buffer)
+       *         %3: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_ldp128_8\n\t"
+                ".align 6\n\t"
+                "_work_loop_ldp128_8:\n\t"
+//ldp 128 -> stp 128
+		"ldp q0,q1,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"ldp q4,q5,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"ldp q6,q7,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#0]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#32]\n\t"NOP(NOPCOUNT)
+		"stp q4,q5,[%2,#64]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%2,#96]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"ldp q4,q5,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"ldp q6,q7,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#128]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#160]\n\t"NOP(NOPCOUNT)
+		"stp q4,q5,[%2,#192]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%2,#224]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"ldp q4,q5,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"ldp q6,q7,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#256]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#288]\n\t"NOP(NOPCOUNT)
+		"stp q4,q5,[%2,#320]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%2,#352]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"ldp q4,q5,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"ldp q6,q7,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#384]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#416]\n\t"NOP(NOPCOUNT)
+		"stp q4,q5,[%2,#448]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%2,#480]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"ldp q4,q5,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"ldp q6,q7,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#512]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#544]\n\t"NOP(NOPCOUNT)
+		"stp q4,q5,[%2,#576]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%2,#608]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"ldp q4,q5,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"ldp q6,q7,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#640]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#672]\n\t"NOP(NOPCOUNT)
+		"stp q4,q5,[%2,#704]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%2,#736]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"ldp q4,q5,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"ldp q6,q7,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#768]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#800]\n\t"NOP(NOPCOUNT)
+		"stp q4,q5,[%2,#832]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%2,#864]\n\t"NOP(NOPCOUNT)
+
+		"ldp q0,q1,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"ldp q2,q3,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"ldp q4,q5,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"ldp q6,q7,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%2,#896]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%2,#928]\n\t"NOP(NOPCOUNT)
+		"stp q4,q5,[%2,#960]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%2,#992]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+
+		"subs %3,%3,#1\n\t"
+                "bne _work_loop_ldp128_8\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r"(dst_addr), "r" (passes)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"
+      );
+      /* 1024 Byte read and 1024 Byte written per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    default: ret=0.0;break;
+   }
+
+  #ifdef USE_PAPI
+    if ((data)&&(data->num_events)) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** assembler implementation of copy bandwidth measurement using ld1/st1 instructions with four registers
+ *  data==NULL disables PAPI measurements (used by helper threads)
+ */
+static double asm_work_ld1(unsigned long long addr, unsigned long long dst_addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_ld1(unsigned long long addr, unsigned long long dst_addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   #ifdef USE_PAPI
+    if ((data)&&(data->num_events)) PAPI_reset(data->Eventset);
+   #endif
+   switch (burst_length)
+   {
+    case 4:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the source buffer)
+       *         %2: dst_addr (pointer to the destination buffer)
+       *         %3: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_ld1_4\n\t"
+                ".align 6\n\t"
+                "_work_loop_ld1_4:\n\t"
+//ld1 -> st1 (4 registers)
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"subs %3,%3,#1\n\t"
+                "bne _work_loop_ld1_4\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r"(dst_addr), "r" (passes)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"
+      );
+      /* 1024 Byte read and 1024 Byte written per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 8:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the source buffer)
+       *         %2: dst_addr (pointer to the destination buffer)
+       *         %3: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_ld1_8\n\t"
+                ".align 6\n\t"
+                "_work_loop_ld1_8:\n\t"
+//ld1 -> st1 (4 registers)
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"ld1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"ld1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"ld1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"ld1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"ld1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"ld1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"ld1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"ld1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"ld1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%2],#64\n\t"NOP(NOPCOUNT)
+
+		"subs %3,%3,#1\n\t"
+                "bne _work_loop_ld1_8\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r"(dst_addr), "r" (passes)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"
+      );
+      /* 1024 Byte read and 1024 Byte written per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    default: ret=0.0;break;
+   }
+
+  #ifdef USE_PAPI
+    if ((data)&&(data->num_events)) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+
+/* Bytes read and written by the copy routines, only complete loop iterations are executed */
+static unsigned long long bytes_copied(unsigned long long accesses)
+{
+  return (accesses/64)*64*16*2;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - the data set is distributed evenly across all CPUs in BENCHIT_KERNEL_CPU_LIST, all of them
+ *     access their part of the data set concurrently
+ *   - (*results)[0]: aggregate bandwidth (data of all threads / time from the first start to the last end),
+ *     (*results)[1+t]: bandwidth of thread t
+ */
+/*
+ * THREAD_WORK: measurement of a helper thread's own buffers, started by the master thread via data->go
+ */
+static void thread_work(volatile mydata_t *global_data,threaddata_t *mydata)
+{
+  double tmp=(double)0;
+  int j,k;
+
+  if ((mydata->settings)&LOOP_OVERHEAD_COMP) k=global_data->loop_overhead;
+  else k=mydata->cpuinfo->rdtsc_latency;
+
+  //prefetch measurement routine
+  if (global_data->ENABLE_CODE_PREFETCH){
+    switch(global_data->function){
+      case 0: for (j=0;j<mydata->NUM_USES;j++) {tmp+=asm_work_ldr128((unsigned long long)(mydata->cache_flush_area),(unsigned long long)(mydata->cache_flush_area),CODE_PREFETCH_ACCESSES,global_data->burst_length,k,mydata->cpuinfo->clockrate,NULL);} break;
+      case 1: for (j=0;j<mydata->NUM_USES;j++) {tmp+=asm_work_ldp128((unsigned long long)(mydata->cache_flush_area),(unsigned long long)(mydata->cache_flush_area),CODE_PREFETCH_ACCESSES,global_data->burst_length,k,mydata->cpuinfo->clockrate,NULL);} break;
+      case 2: for (j=0;j<mydata->NUM_USES;j++) {tmp+=asm_work_ld1((unsigned long long)(mydata->cache_flush_area),(unsigned long long)(mydata->cache_flush_area),CODE_PREFETCH_ACCESSES,global_data->burst_length,k,mydata->cpuinfo->clockrate,NULL);} break;
+      default: break;
+    }
+  }
+  mydata->ready=1;
+
+  //wait for the master thread to start the measurement
+  while (!global_data->go);
+  mydata->start_ts=global_timestamp();
+  switch(global_data->function){
+    case 0: tmp=asm_work_ldr128(mydata->aligned_addr,mydata->dst_aligned_addr,mydata->accesses,global_data->burst_length,k,mydata->cpuinfo->clockrate,NULL);break;
+    case 1: tmp=asm_work_ldp128(mydata->aligned_addr,mydata->dst_aligned_addr,mydata->accesses,global_data->burst_length,k,mydata->cpuinfo->clockrate,NULL);break;
+    case 2: tmp=asm_work_ld1(mydata->aligned_addr,mydata->dst_aligned_addr,mydata->accesses,global_data->burst_length,k,mydata->cpuinfo->clockrate,NULL);break;
+    default: tmp=-1;break;
+  }
+  mydata->end_ts=global_timestamp();
+  mydata->bandwidth=tmp;
+}
+
+void  _work( unsigned long long memsize, int offset, int function, int burst_length, int runs, volatile mydata_t* data, double **results)
+{
+  int loop_overhead,i,j,t;
+  double tmax,tagg;
+  double tmp=(double)0;
+  int dtsize,max_threads;
+  unsigned long long aligned_addr,dst_addr,accesses,thread_memsize,copysize;
+  unsigned long long start_ts,end_ts,bytes,freq;
+  int dst_use_mode;
+  #ifdef USE_PAPI
+  int count;
+  #endif
+
+  /* all copy variants read and write 1024 Byte per loop iteration (64 accesses of 16 Byte) */
+  dtsize = 16;
+  max_threads=data->num_results;
+
+  /* each thread accesses its share of the total data set size, half of it is source, half destination */
+  thread_memsize = memsize / max_threads;
+  copysize = thread_memsize / 2;
+  accesses = copysize / dtsize;
+
+  /* shared coherency states are only applied to the source buffers,
+   * the destinations are prepared by the CPU that owns them (S/F -> Exclusive, O/U -> Modified) */
+  switch (data->USE_MODE) {
+    case MODE_SHARED:
+    case MODE_FORWARD: dst_use_mode = MODE_EXCLUSIVE; break;
+    case MODE_OWNED:
+    case MODE_MUW: dst_use_mode = MODE_MODIFIED; break;
+    default: dst_use_mode = data->USE_MODE; break;
+  }
+  if ((data->settings)&LOOP_OVERHEAD_COMP) loop_overhead=data->loop_overhead;
+  else loop_overhead=data->cpuinfo->rdtsc_latency;
+
+  if (accesses<512) runs*=5;
+  else if (accesses<1024) runs*=3;
+  else if (accesses<4096) runs*=2;
+  if (memsize>data->cpuinfo->Total_D_Cache_Size) runs/=3;
+  if (runs==0) runs=1;
+
+  tmax=0;
+  freq=global_timestamp_freq();
+  for (t=0;t<max_threads;t++) (*results)[1+t]=INVALID_MEASUREMENT;
+
+  if (accesses) 
+  {
+   for (i=0;i<runs;i++)
+   {
+    /* bring the data of all threads into the requested coherency state, see membench_thread.h for details
+     * applied to the buffers of each measuring thread one after another, every buffer is flushed afterwards
+     */
+    for (t=0;t<max_threads;t++)
+    {
+      if(!t) aligned_addr=(unsigned long long)(data->buffer) + offset;
+      else aligned_addr=data->threaddata[t].aligned_addr;
+      if(!t) dst_addr=(unsigned long long)(data->dst_buffer) + offset;
+      else dst_addr=data->threaddata[t].dst_aligned_addr;
+
+      /* prepare destination buffer in the cache hierarchy of the CPU that owns it */
+      if (!t) use_memory((void*)dst_addr,data->cache_flush_area,copysize,dst_use_mode,data->USE_DIRECTION,data->NUM_USES,*(data->cpuinfo));
+      else{
+        //tell other thread to use its destination buffer
+        unsigned long long tmp;
+        tmp=data->threaddata[t].aligned_addr;
+        data->threaddata[t].aligned_addr=dst_addr;
+        data->threaddata[t].memsize=copysize;
+        data->threaddata[t].accesses=accesses;
+        data->threaddata[t].USE_MODE=dst_use_mode;
+
+        thread_command(&(data->mailbox[t]),THREAD_USE_MEMORY);
+        data->threaddata[t].aligned_addr=tmp;
+      }
+
+      use_mode_adaption(data,t,aligned_addr,copysize,accesses);
+    }
+    aligned_addr=(unsigned long long)(data->buffer) + offset;
+
+    /* arm measuring threads, they prefetch the measurement routine and wait for the go signal */
+    data->go=0;
+    for (t=1;t<max_threads;t++){
+       data->threaddata[t].ready=0;
+       data->threaddata[t].bandwidth=0;
+    }
+    asm volatile ("dmb sy\n\t" : : : "memory");
+    for (t=1;t<max_threads;t++) mailbox_post(&(data->mailbox[t]),THREAD_WORK);
+
+    //prefetch measurement routine
+    if (data->ENABLE_CODE_PREFETCH){
+      switch(function){
+        case 0: for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_ldr128((unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,burst_length,loop_overhead,data->cpuinfo->clockrate,NULL);} break;
+        case 1: for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_ldp128((unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,burst_length,loop_overhead,data->cpuinfo->clockrate,NULL);} break;
+        case 2: for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_ld1((unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,burst_length,loop_overhead,data->cpuinfo->clockrate,NULL);} break;
+        default: break;
+      }
+    }
+    for (t=1;t<max_threads;t++){
+       while (!data->threaddata[t].ready);
+    }
+
+    /* start all threads at once */
+    asm volatile ("dmb sy\n\t" : : : "memory");
+    data->go=1;
+
+    /* call ASM implementation */
+    dst_addr=(unsigned long long)(data->dst_buffer) + offset;
+    data->threaddata[0].start_ts=global_timestamp();
+    switch(function){
+       case 0://ldr128
+         tmp=asm_work_ldr128(aligned_addr,dst_addr,accesses,burst_length,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case 1://ldp128
+         tmp=asm_work_ldp128(aligned_addr,dst_addr,accesses,burst_length,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case 2://ld1
+         tmp=asm_work_ld1(aligned_addr,dst_addr,accesses,burst_length,loop_overhead,data->cpuinfo->clockrate,data);break;
+       default: tmp=-1;break;
+    }
+    data->threaddata[0].end_ts=global_timestamp();
+
+    /* wait for other threads to finish their measurement */
+    for (t=1;t<max_threads;t++) mailbox_wait(&(data->mailbox[t]));
+    data->go=0;
+
+    if (tmp>0){
+      /* aggregate bandwidth: Bytes copied by all threads divided by the time from the first start to the last end
+       * (global_timestamp() is synchronized across CPUs, the per thread results use the cycle counter of each CPU) */
+      start_ts=data->threaddata[0].start_ts;
+      end_ts=data->threaddata[0].end_ts;
+      bytes=bytes_copied(accesses);
+      for (t=1;t<max_threads;t++){
+        if (data->threaddata[t].bandwidth<=0) {bytes=0;break;}
+        if (data->threaddata[t].start_ts<start_ts) start_ts=data->threaddata[t].start_ts;
+        if (data->threaddata[t].end_ts>end_ts) end_ts=data->threaddata[t].end_ts;
+        bytes+=bytes_copied(data->threaddata[t].accesses);
+      }
+      if ((bytes)&&(end_ts>start_ts)) tagg=((double)bytes)/(((double)(end_ts-start_ts))/(((double)freq)*0.000000001));
+      else tagg=0;
+      if (tagg>tmax)
+      {
+        tmax=tagg;
+        (*results)[1]=tmp;
+        for (t=1;t<max_threads;t++) (*results)[1+t]=data->threaddata[t].bandwidth;
+        #ifdef USE_PAPI
+        switch (burst_length)
+        {
+          case 1: count = 1024 / dtsize; break;
+          case 2: count = 1024 / dtsize; break;
+          case 3: count = 1056 / dtsize; break;
+          case 4: count = 1024 / dtsize; break;
+          case 8: count = 1024 / dtsize; break;
+        }
+
+        for (j=0;j<data->num_events;j++)
+        {
+           data->papi_results[j]=(double)data->values[j]/(double)((accesses/count)*count);
+        }
+        #endif
+      }
+    }
+   }
+  }
+  
+  if (tmax) (*results)[0]=tmax;
+  else (*results)[0]=INVALID_MEASUREMENT;
+}
+
@@ -0,0 +1,264 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures aggregate read bandwidth of multiple CPUs accessing data in their own caches or memory concurrently.
+ ******************************************************************************************************/
+ 
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+#ifdef USE_PAPI
+#include <papi.h>
+#endif
+
+
+/* accesses of the code prefetch runs of the measurement routines, enough for one loop iteration (64 accesses, 72 for burst length 3) */
+#define CODE_PREFETCH_ACCESSES 72
+
+/* accesses of the measuring CPU and the helper threads in USE MODE ADAPTION and thread() */
+#define LOCAL_USE_MEMORY(data,addr,memsize,mode) use_memory((void*)(addr),data->cache_flush_area,memsize,mode,data->USE_DIRECTION,data->NUM_USES,*(data->cpuinfo))
+#define HELPER_USE_MEMORY(global_data,mydata) use_memory((void*)mydata->aligned_addr,mydata->cache_flush_area,mydata->memsize,mydata->USE_MODE,mydata->USE_DIRECTION,mydata->NUM_USES,*(mydata->cpuinfo))
+/* concurrent measurement of the helper threads, defined after the assembler routines */
+static void thread_work(volatile mydata_t *global_data,threaddata_t *mydata);
+#define HELPER_COMMAND(global_data,mydata,cmd) if (cmd==THREAD_WORK) thread_work(global_data,mydata)
+#include "membench_thread.h"
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,c,d,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: RAX: stop timestamp 
+         *         RBX: start timestamp
+         */
+        __asm__ __volatile__(
+               //"mov $1,%%rcx;"
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+//                "jmp _work_loop_overhead;"
+//                ".align 64,0x0;"
+//                "_work_loop_overhead:"
+//                "sub $1,%%rcx;"
+//                "jnz _work_loop_overhead;"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+	if ((a-b)<ret) ret=(a-b);
+   }			
+  return (int)ret;
+}
+
+/* measurement loops, generated at compile time (see membench_asm.h)
+ * data==NULL disables PAPI measurements (used by helper threads) */
+#include "membench_asm.h"
+
+ASM_WORK_ALL(ld1)
+ASM_WORK_ALL(ldr128)
+
+/* dispatch table, indexed by function and burst length (NULL: not supported) */
+static const asm_work_t asm_work_table[][MAX_BURST_LENGTH+1]={
+  ASM_WORK_ROW(ld1),        // function 0
+  ASM_WORK_ROW(ldr128),     // function 1
+  ASM_WORK_NONE,            // function 2 (movdqu, not available)
+  ASM_WORK_NONE,            // function 3 (vmovdqu, not available)
+  ASM_WORK_NONE             // function 4 (mov, not available)
+};
+#define ASM_WORK_FUNCTIONS ((int)(sizeof(asm_work_table)/sizeof(asm_work_table[0])))
+
+int asm_work_supported(int function, int burst_length)
+{
+   if ((function<0)||(function>=ASM_WORK_FUNCTIONS)) return 0;
+   if ((burst_length<1)||(burst_length>MAX_BURST_LENGTH)) return 0;
+   return asm_work_table[function][burst_length]!=NULL;
+}
+
+/* Bytes read by the measurement routines, only complete loop iterations are executed */
+static unsigned long long bytes_read(unsigned long long accesses,int burst_length)
+{
+  unsigned long long per_pass=(burst_length==3)?72:64;
+
+  return (accesses/per_pass)*per_pass*16;
+}
+
+/*
+ * THREAD_WORK: measurement of a helper thread's own buffer, started by the master thread via data->go
+ */
+static void thread_work(volatile mydata_t *global_data,threaddata_t *mydata)
+{
+  asm_work_t work=asm_work_table[global_data->function][global_data->burst_length];
+  double tmp=(double)0;
+  int j,k;
+
+  if ((mydata->settings)&LOOP_OVERHEAD_COMP) k=global_data->loop_overhead;
+  else k=mydata->cpuinfo->rdtsc_latency;
+
+  //prefetch measurement routine
+  if (global_data->ENABLE_CODE_PREFETCH)
+    for (j=0;j<mydata->NUM_USES;j++) {tmp+=work((unsigned long long)(mydata->cache_flush_area),CODE_PREFETCH_ACCESSES,0,k,mydata->cpuinfo->clockrate,NULL);}
+  mydata->ready=1;
+
+  //wait for the master thread to start the measurement
+  while (!global_data->go);
+  mydata->start_ts=global_timestamp();
+  tmp=work(mydata->aligned_addr,mydata->accesses,PREFETCH_DISTANCE,k,mydata->cpuinfo->clockrate,NULL);
+  mydata->end_ts=global_timestamp();
+  mydata->bandwidth=tmp;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - the data set is distributed evenly across all CPUs in BENCHIT_KERNEL_CPU_LIST, all of them
+ *     access their part of the data set concurrently
+ *   - (*results)[0]: aggregate bandwidth (data of all threads / time from the first start to the last end),
+ *     (*results)[1+t]: bandwidth of thread t
+ */
+void  _work( unsigned long long memsize, int offset, int function, int burst_length, int runs, volatile mydata_t* data, double **results)
+{
+  int loop_overhead,i,j,t;
+  double tmax,tagg;
+  double tmp=(double)0;
+  int dtsize,max_threads;
+  unsigned long long aligned_addr,accesses,thread_memsize;
+  unsigned long long start_ts,end_ts,bytes,freq;
+  asm_work_t work=NULL;
+  #ifdef USE_PAPI
+  int count;
+  #endif
+
+  switch (function) {
+    case 3: dtsize = 32; break;
+    case 4: dtsize = 8; break;
+    default: dtsize = 16; break;
+  }
+  max_threads=data->num_results;
+
+  /* each thread accesses its share of the total data set size */
+  thread_memsize = memsize / max_threads;
+  accesses = thread_memsize / dtsize;
+  /* only started if the burst length is supported, the helper threads use the same routine */
+  if (asm_work_supported(function,burst_length)) work=asm_work_table[function][burst_length];
+  else accesses=0;
+  if ((data->settings)&LOOP_OVERHEAD_COMP) loop_overhead=data->loop_overhead;
+  else loop_overhead=data->cpuinfo->rdtsc_latency;
+
+  if (accesses<512) runs*=5;
+  else if (accesses<1024) runs*=3;
+  else if (accesses<4096) runs*=2;
+  if (memsize>data->cpuinfo->Total_D_Cache_Size) runs/=3;
+  if (runs==0) runs=1;
+
+  tmax=0;
+  freq=global_timestamp_freq();
+  for (t=0;t<max_threads;t++) (*results)[1+t]=INVALID_MEASUREMENT;
+
+  if (accesses) 
+  {
+   for (i=0;i<runs;i++)
+   {
+    /* bring the data of all threads into the requested coherency state, see membench_thread.h for details
+     * applied to the buffer of each measuring thread one after another, every buffer is flushed afterwards
+     */
+    for (t=0;t<max_threads;t++)
+    {
+      if(!t) aligned_addr=(unsigned long long)(data->buffer) + offset;
+      else aligned_addr=data->threaddata[t].aligned_addr;
+      use_mode_adaption(data,t,aligned_addr,thread_memsize,accesses);
+    }
+    aligned_addr=(unsigned long long)(data->buffer) + offset;
+
+    /* arm measuring threads, they prefetch the measurement routine and wait for the go signal */
+    data->go=0;
+    for (t=1;t<max_threads;t++){
+       data->threaddata[t].ready=0;
+       data->threaddata[t].bandwidth=0;
+    }
+    asm volatile ("dmb sy\n\t" : : : "memory");
+    for (t=1;t<max_threads;t++) mailbox_post(&(data->mailbox[t]),THREAD_WORK);
+
+    //prefetch measurement routine
+    if (data->ENABLE_CODE_PREFETCH)
+      for (j=0;j<data->NUM_USES;j++) {tmp+=work((unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,0,loop_overhead,data->cpuinfo->clockrate,NULL);}
+    for (t=1;t<max_threads;t++){
+       while (!data->threaddata[t].ready);
+    }
+
+    /* start all threads at once */
+    asm volatile ("dmb sy\n\t" : : : "memory");
+    data->go=1;
+
+    /* call ASM implementation */
+    data->threaddata[0].start_ts=global_timestamp();
+    tmp=work(aligned_addr,accesses,PREFETCH_DISTANCE,loop_overhead,data->cpuinfo->clockrate,data);
+    data->threaddata[0].end_ts=global_timestamp();
+
+    /* wait for other threads to finish their measurement */
+    for (t=1;t<max_threads;t++) mailbox_wait(&(data->mailbox[t]));
+    data->go=0;
+
+    if (tmp>0){
+      /* aggregate bandwidth: Bytes read by all threads divided by the time from the first start to the last end
+       * (global_timestamp() is synchronized across CPUs, the per thread results use the cycle counter of each CPU) */
+      start_ts=data->threaddata[0].start_ts;
+      end_ts=data->threaddata[0].end_ts;
+      bytes=bytes_read(accesses,burst_length);
+      for (t=1;t<max_threads;t++){
+        if (data->threaddata[t].bandwidth<=0) {bytes=0;break;}
+        if (data->threaddata[t].start_ts<start_ts) start_ts=data->threaddata[t].start_ts;
+        if (data->threaddata[t].end_ts>end_ts) end_ts=data->threaddata[t].end_ts;
+        bytes+=bytes_read(data->threaddata[t].accesses,burst_length);
+      }
+      if ((bytes)&&(end_ts>start_ts)) tagg=((double)bytes)/(((double)(end_ts-start_ts))/(((double)freq)*0.000000001));
+      else tagg=0;
+      if (tagg>tmax)
+      {
+        tmax=tagg;
+        (*results)[1]=tmp;
+        for (t=1;t<max_threads;t++) (*results)[1+t]=data->threaddata[t].bandwidth;
+        #ifdef USE_PAPI
+        switch (burst_length)
+        {
+          case 1: count = 1024 / dtsize; break;
+          case 2: count = 1024 / dtsize; break;
+          case 3: count = 1152 / dtsize; break;
+          case 4: count = 1024 / dtsize; break;
+          case 8: count = 1024 / dtsize; break;
+        }
+
+        for (j=0;j<data->num_events;j++)
+        {
+           data->papi_results[j]=(double)data->values[j]/(double)((accesses/count)*count);
+        }
+        #endif
+      }
+    }
+   }
+  }
+  
+  if (tmax) (*results)[0]=tmax;
+  else (*results)[0]=INVALID_MEASUREMENT;
+}
+
@@ -0,0 +1,157 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures aggregate read bandwidth of multiple CPUs accessing data in their own caches or memory concurrently.
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "multi threaded memory bandwidth (load)"
+#define CODE_SEQUENCE       "ldr q/ld1 mem -> reg"
+#define X_AXIS_TEXT         "total data set size [Byte]"
+#define Y_AXIS_TEXT_1       "bandwidth [GB/s]"
+#define Y_AXIS_TEXT_2       "counter value/ memory accesses"
+
+/* definitions to add prefetch instructions according to BENCHIT_KERNEL_LINE_PREFETCH setting
+ * one prfm per cacheline, addresses are relative to a separate pointer (reg) that runs ahead of the loads by
+ * LINE_PREFETCH cachelines */
+#ifndef LINE_PREFETCH
+#define LINE_PREFETCH 0
+#endif
+#if LINE_PREFETCH == 0
+#define PREFETCH(offset,reg) ""
+#define PREFETCH_ADVANCE(bytes,reg) ""
+#else
+#define _doprefetch(offset,reg) "prfm pldl1keep,["#reg",#"#offset"]\n\t"
+#define PREFETCH(offset,reg) _doprefetch(offset,reg)       //PREFETCH(offset,%3) -> prfm pldl1keep,[%3,#offset]
+#define PREFETCH_ADVANCE(bytes,reg) "add "#reg","#reg",#"#bytes"\n\t"
+#endif
+#define PREFETCH_DISTANCE (LINE_PREFETCH*64)
+
+/* largest burst length (number of registers used before the first one is reused) */
+#define MAX_BURST_LENGTH 8
+
+/* kernel specific thread functions */
+#define THREAD_WORK            THREAD_KERNEL
+
+#ifndef AVX_STARTUP_REG_OPS
+#define AVX_STARTUP_REG_OPS 0
+#endif
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* buffer;
+   char* cache_flush_area;
+   pthread_t *threads;
+   struct threaddata *threaddata;
+   cpu_info_t *cpuinfo;                                 //40  
+   unsigned int FRST_SHARE_CPU;
+   unsigned int NUM_SHARED_CPUS;
+   unsigned int alignment;                              //+12  
+   unsigned int settings;
+   unsigned int loop_overhead;
+   unsigned short num_threads;
+   unsigned short num_results;
+   unsigned char hugepages;
+   unsigned char extra_clflush;                         
+   unsigned char flush_share_cpu;                       //+15  
+   unsigned char offset;
+   unsigned char burst_length;
+   unsigned char function;
+   unsigned char runs;                                  //+4  
+   unsigned char NUM_FLUSHES;
+   unsigned char NUM_USES;
+   unsigned char FLUSH_MODE;
+   unsigned char USE_DIRECTION;                         //+4
+   unsigned char ENABLE_CODE_PREFETCH;
+   unsigned char USE_MODE;                              //+2
+   unsigned char padding1[51];                          //+51 = 128
+   unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
+   #ifdef USE_PAPI
+   long long *values;
+   double *papi_results;
+   int Eventset;
+   int num_events;                                      //(24) 
+   #endif
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
+   volatile unsigned short go;                          //+2, starts concurrent measurement
+   #ifdef USE_PAPI
+   unsigned char padding2[30];                          //24+8+2+30 = 64
+   #else
+   unsigned char padding2[54];                          //   8+2+54 = 64
+   #endif
+   unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
+} mydata_t;
+
+/* data needed by each thread */
+typedef struct threaddata
+{
+   volatile mydata_t *data;
+   char* buffer;
+   char* cache_flush_area;
+   cpu_info_t *cpuinfo;                                 //32  
+   volatile unsigned long long aligned_addr;  
+   volatile unsigned long long start_ts;                //global_timestamp() before and after the concurrent measurement
+   volatile unsigned long long end_ts;                  //+24  
+   unsigned long long buffersize;
+   unsigned long long memsize;				//+16  
+   volatile double bandwidth;                           //+8, result of concurrent measurement
+   unsigned int thread_id;
+   unsigned int accesses;
+   unsigned int settings;
+   unsigned int alignment;
+   unsigned int offset;
+   unsigned int cpu_id;                                 
+   unsigned int mem_bind;                               //+28 
+   unsigned char NUM_FLUSHES;
+   unsigned char NUM_USES;
+   unsigned char FLUSH_MODE;
+   unsigned char USE_DIRECTION;                         //+4
+   unsigned char USE_MODE;                              //+1
+   volatile unsigned char ready;                        //+1, THREAD_WORK: code prefetched, waiting for data->go
+   unsigned char padding1[14];                          //+14 = 128
+   unsigned long long end_dummy_cachelines[16];         //avoid prefetching following data 
+} threaddata_t;
+
+/** Initializes the random number generator with the values given to the function.
+ *  formula: r(n+1) = (a*r(n)+b)%m
+ *  sequence generated by calls of _random() is a permutation of values from 0 to max-1
+ */
+void _random_init(int start,int max);
+/** returns a pseudo random number
+ *  do not use this function without a prior call to _random_init()
+ */
+unsigned long long _random(void);
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n);
+
+/* returns 1 if an implementation exists for the combination of function and burst length */
+int asm_work_supported(int function, int burst_length);
+
+ 
+/* function that performs the measurement */
+void _work(unsigned long long memsize, int offset, int function, int burst_length, int runs,volatile mydata_t* data, double **results);
+
+/* parallel first touch of the master buffer and the threads' buffers by the threads on the buffers' NUMA nodes */
+void init_buffers(volatile mydata_t *data,unsigned long long buffersize,int mem_bind);
+
+/* loop executed by all threads, except the master thread
+ * THREAD_WORK: thread sets ready, waits for data->go and measures its own buffer concurrently with all other threads
+ */
+void *thread(void *threaddata);
+
+#endif
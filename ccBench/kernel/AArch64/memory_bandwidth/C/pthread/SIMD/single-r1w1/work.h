@@ -0,0 +1,146 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures copy (read+write) bandwidth of data located in different cache levels or memory of certain CPUs,
+ *         source and destination buffers can be placed in different NUMA nodes.
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "single threaded memory bandwidth (copy)"
+#define CODE_SEQUENCE       "ldr q/ldp q/ld1 mem -> reg, str q/stp q/st1 reg -> mem"
+#define X_AXIS_TEXT         "data set size (source + destination) [Byte]"
+#define Y_AXIS_TEXT_1       "bandwidth (read + write) [GB/s]"
+#define Y_AXIS_TEXT_2       "counter value/ memory accesses"
+
+/* definitions to add prefetch instructions according to BENCHIT_KERNEL_LINE_PREFETCH setting */
+#ifndef LINE_PREFETCH
+#define LINE_PREFETCH 0
+#endif
+#if LINE_PREFETCH == 0
+#define PREFETCH(lines,offset,reg) ""
+#else
+#define _doprefetch(lines,offset,reg) "prefetcht0 "#offset"+64*"#lines"(%%"#reg");"
+#define PREFETCH(lines,offset,reg) _doprefetch(lines,offset,reg)       //PREFETCH(LINE_PREFETCH,offset,reg) -> _doprefetch(n,offset,reg)
+#endif
+
+/* kernel specific thread functions */
+#define THREAD_INIT_DST        THREAD_KERNEL
+
+#ifndef AVX_STARTUP_REG_OPS
+#define AVX_STARTUP_REG_OPS 0
+#endif
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* buffer;
+   char* dst_buffer;
+   char* cache_flush_area;
+   pthread_t *threads;
+   struct threaddata *threaddata;
+   cpu_info_t *cpuinfo;                                 //48  
+   unsigned int FRST_SHARE_CPU;
+   unsigned int NUM_SHARED_CPUS;
+   unsigned int alignment;                              //+12  
+   unsigned int settings;
+   unsigned int loop_overhead;
+   unsigned short num_threads;
+   unsigned short num_results;
+   unsigned char hugepages;
+   unsigned char extra_clflush;                         
+   unsigned char flush_share_cpu;                       //+15  
+   unsigned char offset;
+   unsigned char burst_length;
+   unsigned char function;
+   unsigned char runs;                                  //+4  
+   unsigned char NUM_FLUSHES;
+   unsigned char NUM_USES;
+   unsigned char FLUSH_MODE;
+   unsigned char USE_DIRECTION;                         //+4
+   unsigned char ENABLE_CODE_PREFETCH;
+   unsigned char USE_MODE;                              //+2
+   unsigned char padding1[43];                          //+43 = 128
+   unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
+   #ifdef USE_PAPI
+   long long *values;
+   double *papi_results;
+   int Eventset;
+   int num_events;                                      //(24) 
+   #endif
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
+   #ifdef USE_PAPI
+   unsigned char padding2[32];                          //24+8+32 = 64
+   #else
+   unsigned char padding2[56];                          //   8+56 = 64
+   #endif
+   unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
+} mydata_t;
+
+/* data needed by each thread */
+typedef struct threaddata
+{
+   volatile mydata_t *data;
+   char* buffer;
+   char* dst_buffer;
+   char* cache_flush_area;
+   cpu_info_t *cpuinfo;                                 //40  
+   volatile unsigned long long aligned_addr;  
+   volatile unsigned long long dst_aligned_addr;  
+   unsigned long long start_ts;     
+   unsigned long long end_ts;                           //+32  
+   unsigned long long buffersize;
+   unsigned long long memsize;				//+16  
+   unsigned int thread_id;
+   unsigned int accesses;
+   unsigned int settings;
+   unsigned int alignment;
+   unsigned int offset;
+   unsigned int cpu_id;                                 
+   unsigned int mem_bind;
+   unsigned int dst_mem_bind;                           //+32 
+   unsigned char NUM_FLUSHES;
+   unsigned char NUM_USES;
+   unsigned char FLUSH_MODE;
+   unsigned char USE_DIRECTION;                         //+4
+   unsigned char USE_MODE;                              //+1
+   unsigned char padding1[3];                           //+3 = 128
+   unsigned long long end_dummy_cachelines[16];         //avoid prefetching following data 
+} threaddata_t;
+
+/** Initializes the random number generator with the values given to the function.
+ *  formula: r(n+1) = (a*r(n)+b)%m
+ *  sequence generated by calls of _random() is a permutation of values from 0 to max-1
+ */
+void _random_init(int start,int max);
+/** returns a pseudo random number
+ *  do not use this function without a prior call to _random_init()
+ */
+unsigned long long _random(void);
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n);
+
+ 
+/* function that performs the measurement */
+void _work(unsigned long long memsize, int offset, int function, int burst_length, int runs,volatile mydata_t* data, double **results);
+
+/* parallel first touch of the master buffer and the threads' buffers by the threads on the buffers' NUMA nodes */
+void init_buffers(volatile mydata_t *data,unsigned long long buffersize,int mem_bind);
+
+/* loop executed by all threads, except the master thread */
+void *thread(void *threaddata);
+
+#endif
@@ -40,8 +40,19 @@ int n_of_sure_funcs_per_work;
 /* variables to store settings from PARAMETERS file 
  * parsed by evaluate_environment() function */
 unsigned long long BUFFERSIZE;
+unsigned long long DAMAGE_SIZE=0;
+/* prefetch distances in cachelines, derived from PREFETCH_DISTANCE in PARAMETERS file */
+unsigned long long *prefetch_distances=NULL;
+int NUM_PREFETCH_DISTANCES=0;
+/* nops after each load, derived from JIT_NOPCOUNT in PARAMETERS file (NOPCOUNT if code generation is disabled) */
+int *nopcounts=NULL;
+int NUM_NOPCOUNTS=0;
+/* runtime code generation, derived from CODE_GENERATION, UNROLL, and JIT_PREFETCH_OP in PARAMETERS file */
+int CODE_GENERATION=0,UNROLL=0,JIT_PREFETCH_OP=0,JIT_SERIALIZE=1;
 int HUGEPAGES=0,RUNS=0,EXTRA_CLFLUSH=0,OFFSET=0,FUNCTION=0,BURST_LENGTH=0,RANDOM=0;
 int ALIGNMENT=64,NUM_RESULTS=0,TIMEOUT=0,NUM_THREADS=0,LOOP_OVERHEAD_COMPENSATION=0;
+/* idle policy of the helper threads, spin time in ns before blocking (-1: spin only), derived from IDLE_POLICY and IDLE_SPIN_TIME in PARAMETERS file */
+long long IDLE_SPIN_TIME=-1;
 int EXTRA_FLUSH_SIZE=0,GLOBAL_FLUSH_BUFFER=0,DISABLE_CLFLUSH=1;
 int FLUSH_L1=0,FLUSH_L2=0,FLUSH_L3=0,FLUSH_L4=0,NUM_FLUSHES=0,NUM_USES=0,FLUSH_MODE=0,ENABLE_CODE_PREFETCH=0,FLUSH_SHARED_CPU=0;
 int USE_MODE=0,FRST_SHARE_CPU=0,NUM_SHARED_CPUS=0,USE_DIRECTION=0,ALWAYS_FLUSH_CPU0=0;
@@ -144,6 +155,11 @@ void bi_getinfo( bi_info * infostruct )
    infostruct->maxproblemsize=problemlistsize;
    sprintf(buff, KERNEL_DESCRIPTION);
    infostruct->kerneldescription = bi_strdup( buff );
+   /* vector length is determined at runtime (rdvl), report it in the result file */
+   if (cpuinfo->features&SVE){
+     sprintf(buff,"sve_vector_length=%u",cpuinfo->sve_vector_length*8);
+     infostruct->additional_information = bi_strdup( buff );
+   }
    infostruct->num_processes = 1;
    infostruct->num_threads_per_process = NUM_THREADS;
    infostruct->kernel_execs_mpi1 = 0;
@@ -154,12 +170,14 @@ void bi_getinfo( bi_info * infostruct )
 
    /* GB/s + selected counters */
    n_of_works = 1;
+   /* bandwidth of co-resident working set re-read */
+   if (DAMAGE_SIZE) n_of_works++;
    #ifdef USE_PAPI
     n_of_works+=papi_num_counters;
    #endif
       
-   /* local bandwidth of first CPU in list and bandwidth between this and all other selected CPUs */
-   n_of_sure_funcs_per_work = NUM_RESULTS;
+   /* local bandwidth of first CPU in list and bandwidth between this and all other selected CPUs (for every prefetch distance and nop count) */
+   n_of_sure_funcs_per_work = NUM_RESULTS*NUM_PREFETCH_DISTANCES*NUM_NOPCOUNTS;
    
    infostruct->numfunctions = n_of_works * n_of_sure_funcs_per_work;
 
@@ -187,21 +205,32 @@ void bi_getinfo( bi_info * infostruct )
 
    /* setting up y axis texts and properties */
    for ( j = 0; j < n_of_works; j++ ){
-     int k,index;
+     int k,d,n,index;
+     char dist[96];
+     for (n=0;n<NUM_NOPCOUNTS;n++)
+     for (d=0;d<NUM_PREFETCH_DISTANCES;d++)
      for (k=0;k<NUM_RESULTS;k++){
-       index= k + n_of_sure_funcs_per_work * j;
+       index= k + NUM_RESULTS * (d + NUM_PREFETCH_DISTANCES * n) + n_of_sure_funcs_per_work * j;
+       if (NUM_PREFETCH_DISTANCES>1) sprintf(dist,", prefetch distance %llu",prefetch_distances[d]);
+       else dist[0]='\0';
+       if (NUM_NOPCOUNTS>1) sprintf(dist+strlen(dist),", %i nops",nopcounts[n]);
        infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_1 );
        infostruct->outlier_direction_upwards[index]=0;         //report maximum of iterations
        infostruct->base_yaxis[index] = 0;
        switch ( j ){
          case 0:  // GB/s
-           sprintf(buff,"bandwidth: CPU%llu - CPU%llu",cpu_bind[0],cpu_bind[k]);
+           sprintf(buff,"bandwidth: CPU%llu - CPU%llu%s",cpu_bind[0],cpu_bind[k],dist);
            infostruct->legendtexts[index] = bi_strdup( buff );
            break;
-         default: // papi
+         default: // working set re-read, papi
+           if ((DAMAGE_SIZE)&&(j==1)){
+             sprintf(buff,"working set re-read after load: CPU%llu - CPU%llu%s",cpu_bind[0],cpu_bind[k],dist);
+             infostruct->legendtexts[index] = bi_strdup( buff );
+             break;
+           }
           #ifdef USE_PAPI
-           if (k)  sprintf(buff,"%s CPU%llu - CPU%llu",papi_names[j-1],cpu_bind[0],cpu_bind[k]);
-           else sprintf(buff,"%s CPU%llu locally",papi_names[j-1],cpu_bind[0]);
+           if (k)  sprintf(buff,"%s CPU%llu - CPU%llu%s",papi_names[j-1-(DAMAGE_SIZE!=0)],cpu_bind[0],cpu_bind[k],dist);
+           else sprintf(buff,"%s CPU%llu locally%s",papi_names[j-1-(DAMAGE_SIZE!=0)],cpu_bind[0],dist);
            infostruct->legendtexts[index] = bi_strdup( buff );
            infostruct->outlier_direction_upwards[index] = 0;   //report maximum of iterations
            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_2 );
@@ -315,15 +344,29 @@ void* bi_init( int problemsizemax )
    }
 
    if (ALWAYS_FLUSH_CPU0) mdp->settings|=OPT_FLUSH_CPU0;
+
+   /* executable buffer for the generated measurement loop */
+   if (CODE_GENERATION){
+     mdp->jit_buffer=(char*) mmap(NULL,JIT_BUFFER_SIZE,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+     if (mdp->jit_buffer==MAP_FAILED){
+       fprintf( stderr, "Error: Allocation of code buffer failed\n" ); fflush( stderr );
+       exit( 127 );
+     }
+     mdp->jit_unroll=UNROLL;
+     mdp->jit_prefetch_op=JIT_PREFETCH_OP;
+     mdp->jit_serialize=JIT_SERIALIZE;
+   }
    if ((NUM_THREADS>mdp->cpuinfo->num_cores)||(NUM_THREADS==0)) NUM_THREADS=mdp->cpuinfo->num_cores;
    mdp->num_threads=NUM_THREADS;
    mdp->num_results=NUM_RESULTS;
    mdp->threads=_mm_malloc(NUM_THREADS*sizeof(pthread_t),ALIGNMENT);
-   mdp->thread_comm=_mm_malloc(NUM_THREADS*sizeof(int),ALIGNMENT);
-   if ((mdp->threads==NULL)||(mdp->thread_comm==NULL)){
+   mdp->mailbox=_mm_malloc(NUM_THREADS*sizeof(mailbox_t),sizeof(mailbox_t));
+   if ((mdp->threads==NULL)||(mdp->mailbox==NULL)){
      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
      exit( 127 );
-   }   
+   }
+   memset(mdp->mailbox,0,NUM_THREADS*sizeof(mailbox_t));
+   for (i=0;i<NUM_THREADS;i++) mdp->mailbox[i].spin_time=IDLE_SPIN_TIME;
 
    /* enable selected cache flushes */
    if ((FLUSH_L1)&&(mdp->cpuinfo->U_Cache_Size[0]+mdp->cpuinfo->D_Cache_Size[0]!=0)){ 
@@ -387,6 +430,8 @@ void* bi_init( int problemsizemax )
       mdp->cpuinfo->Cachelevels=CACHELEVELS;
    }
 
+   damage_init(&(mdp->damage),DAMAGE_SIZE,NUM_RESULTS,ALIGNMENT);
+
    mdp->threaddata = _mm_malloc(mdp->num_threads*sizeof(threaddata_t),ALIGNMENT);
    memset( mdp->threaddata,0,mdp->num_threads*sizeof(threaddata_t));
   #ifdef USE_PAPI
@@ -419,12 +464,10 @@ void* bi_init( int problemsizemax )
       exit( 127 );
     }
     memcpy(mdp->threaddata[t].cpuinfo,mdp->cpuinfo,sizeof(cpu_info_t));
-    mdp->ack=0;
     mdp->threaddata[t].thread_id=t;
     mdp->threaddata[t].cpu_id=cpu_bind[t];
     mdp->threaddata[t].mem_bind=mem_bind[t];
     mdp->threaddata[t].data=mdp;
-    mdp->thread_comm[t]=THREAD_INIT;
     mdp->threaddata[t].settings=mdp->settings;
     if (GLOBAL_FLUSH_BUFFER){
        mdp->threaddata[t].cache_flush_area=mdp->cache_flush_area;
@@ -454,11 +497,10 @@ void* bi_init( int problemsizemax )
     mdp->threaddata[t].buffersize=BUFFERSIZE;
     mdp->threaddata[t].alignment=ALIGNMENT;
     mdp->threaddata[t].offset=OFFSET;    
+    mailbox_post(&(mdp->mailbox[t]),THREAD_INIT);
     pthread_create(&(mdp->threads[t]),NULL,thread,(void*)(&(mdp->threaddata[t])));
-    while (!mdp->ack);
   }
 
-  mdp->ack=0;mdp->done=0;
   cpu_set(mem_bind[0]);
   numa_node = numa_node_of_cpu(mem_bind[0]);
   numa_bitmask = numa_bitmask_alloc((unsigned int) numa_max_possible_node());
@@ -491,22 +533,12 @@ void* bi_init( int problemsizemax )
      exit( 127 );
   }
  
-   /* initialize buffer */
-   tmp=sizeof(unsigned long long);
-   for (i=0;i<=BUFFERSIZE-tmp;i+=tmp){
-      *((unsigned long long*)((unsigned long long)mdp->buffer+i))=(unsigned long long)i;
-   }
-   clflush(mdp->buffer,BUFFERSIZE,*(mdp->cpuinfo));
- 
   cpu_set(cpu_bind[0]);
   printf("  wait for threads memory initialization \n");fflush(stdout);
   /* wait for threads to finish their initialization */  
-  for (t=1;t<mdp->num_threads;t++){
-     mdp->ack=0;
-     mdp->thread_comm[t]=THREAD_WAIT;
-     while (!mdp->ack);
-  }
-  mdp->ack=0;
+  for (t=1;t<mdp->num_threads;t++) mailbox_wait(&(mdp->mailbox[t]));
+  /* first touch of all buffers, split across the threads on the NUMA node of each buffer */
+  init_buffers(mdp,BUFFERSIZE,mem_bind[0]);
   printf("    ...done\n");
   if ((num_packages()!=-1)&&(num_cores_per_package()!=-1)&&(num_threads_per_core()!=-1))  printf("  num_packages: %i, %i cores per package, %i threads per core\n",num_packages(),num_cores_per_package(),num_threads_per_core());
   printf("  using %i threads\n",NUM_THREADS);
@@ -537,7 +569,7 @@ void* bi_init( int problemsizemax )
 int inline bi_entry( void* mdpv, int problemsize, double* results )
 {
   /* j is used for loop iterations */
-  int j = 0,k = 0;
+  int j = 0,k = 0,d = 0,n = 0,index;
   /* real problemsize*/
   unsigned long long rps;
   /* cast void* pointer */
@@ -557,19 +589,27 @@ int inline bi_entry( void* mdpv, int problemsize, double* results )
   /* check wether the pointer to store the results in is valid or not */
   if ( results == NULL ) return 1;
 
-  _work(rps,OFFSET,FUNCTION,BURST_LENGTH,RUNS,mdp,&tmp_results);
   results[0] = (double)rps;
 
-  /* copy tmp_results to final results */  
-  for (k=0;k<NUM_RESULTS;k++)
+  /* one measurement per prefetch distance (distance in cachelines, prfm pointer offset in Byte) and nop count */
+  for (n=0;n<NUM_NOPCOUNTS;n++)
+  for (d=0;d<NUM_PREFETCH_DISTANCES;d++)
   {
-    results[1+k]=tmp_results[k];
+   _work(rps,OFFSET,FUNCTION,BURST_LENGTH,prefetch_distances[d]*64,nopcounts[n],RUNS,mdp,&tmp_results);
+
+   /* copy tmp_results to final results */  
+   for (k=0;k<NUM_RESULTS;k++)
+   {
+    index=(n*NUM_PREFETCH_DISTANCES+d)*NUM_RESULTS+k;
+    results[1+index]=tmp_results[k];
+    if (DAMAGE_SIZE) results[1+n_of_sure_funcs_per_work+index]=mdp->damage.results[k];
     #ifdef USE_PAPI
     for (j=0;j<papi_num_counters;j++)
     {
-      results[1+(j+1)*NUM_RESULTS+k]=mdp->papi_results[j*NUM_RESULTS+k];
+      results[1+(j+1+(DAMAGE_SIZE!=0))*n_of_sure_funcs_per_work+index]=mdp->papi_results[j*NUM_RESULTS+k];
     }
     #endif
+   }
   }
   _mm_free(tmp_results);
   return 0;
@@ -583,12 +623,9 @@ void bi_cleanup( void* mdpv )
    
    mydata_t* mdp = (mydata_t*)mdpv;
    /* terminate other threads */
-   for (t=1;t<mdp->num_threads;t++)
-   {
-    mdp->ack=0;
-    mdp->thread_comm[t]=THREAD_STOP;
-    pthread_join((mdp->threads[t]),NULL);
-   } 
+   for (t=1;t<mdp->num_threads;t++) mailbox_post(&(mdp->mailbox[t]),THREAD_STOP);
+   for (t=1;t<mdp->num_threads;t++) pthread_join((mdp->threads[t]),NULL);
+   if (mdp->mailbox) mailbox_report(mdp->mailbox,mdp->num_threads);
    pthread_kill(watchdog,SIGUSR1);
 
    /* free resources */
@@ -597,6 +634,8 @@ void bi_cleanup( void* mdpv )
      if(mdp->buffer!=NULL) munmap((void*)mdp->buffer,BUFFERSIZE);
    }
    if (mdp->cache_flush_area!=NULL) _mm_free (mdp->cache_flush_area);
+   damage_free(&(mdp->damage));
+   if (mdp->jit_buffer!=NULL) munmap((void*)mdp->jit_buffer,JIT_BUFFER_SIZE);
    if (mdp->threaddata){
      for (t=1;t<mdp->num_threads;t++){
         if (mdp->threaddata[t].cpuinfo) _mm_free(mdp->threaddata[t].cpuinfo);
@@ -604,7 +643,7 @@ void bi_cleanup( void* mdpv )
      _mm_free(mdp->threaddata);   
    }
    if (mdp->threads) _mm_free(mdp->threads);
-   if (mdp->thread_comm) _mm_free(mdp->thread_comm);
+   if (mdp->mailbox) _mm_free(mdp->mailbox);
    if (mdp->cpuinfo) _mm_free(mdp->cpuinfo);
    _mm_free( mdp );
    return;
@@ -953,11 +992,77 @@ void evaluate_environment(bi_info * info)
      else if (!strcmp(p,"mov")) {
        ALIGNMENT=64;OFFSET=OFFSET%ALIGNMENT;FUNCTION=4;
      }
+     else if (!strcmp(p,"ld1d")) {
+       ALIGNMENT=256;OFFSET=0;FUNCTION=5;
+     }
+     else if (!strcmp(p,"ld1b")) {
+       ALIGNMENT=256;OFFSET=0;FUNCTION=6;
+     }
+     else if (!strcmp(p,"ldnp")) {
+       ALIGNMENT=128;OFFSET=0;FUNCTION=7;
+     }
      else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_INSTRUCTION");}
    }
    p = bi_getenv( "BENCHIT_KERNEL_BURST_LENGTH", 0 );
    if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_BURST_LENGTH not set");}
    else BURST_LENGTH = atoi( p );
+   if ((FUNCTION==5)||(FUNCTION==6)){
+     #ifdef NO_SVE
+     errors++;sprintf(error_msg,"SVE instructions not available (compiled with NO_SVE)");
+     #else
+     if (!(cpuinfo->features&SVE)) {errors++;sprintf(error_msg,"SVE not supported by this CPU");}
+     #endif
+   }
+   /* runtime code generation: nop count, prefetch distance and operation, burst length, and unroll factor without recompilation */
+   p=bi_getenv( "BENCHIT_KERNEL_CODE_GENERATION", 0 );
+   if (p!=0){
+     if (!strcmp(p,"static")) CODE_GENERATION=0;
+     else if (!strcmp(p,"jit")) CODE_GENERATION=1;
+     else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_CODE_GENERATION (static|jit)");}
+   }
+   if (CODE_GENERATION){
+     if ((FUNCTION!=0)&&(FUNCTION!=1)&&(FUNCTION!=7)) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_CODE_GENERATION=jit only supports ld1, ldr128, and ldnp");}
+     if ((BURST_LENGTH<1)||(BURST_LENGTH>JIT_MAX_BURST)||((FUNCTION==7)&&(BURST_LENGTH%2))) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_BURST_LENGTH (jit: 1-8, ldnp: 2,4,6,8)");}
+
+     p=bi_getenv( "BENCHIT_KERNEL_UNROLL", 0 );
+     if (p!=0) UNROLL=atoi(p);
+     else UNROLL=(FUNCTION==7)?32:64;
+     /* whole cachelines per iteration, one prfm per cacheline */
+     if ((UNROLL<1)||(UNROLL>JIT_MAX_UNROLL)||((UNROLL*((FUNCTION==7)?32:16))%64)) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_UNROLL (1-1024, multiple of one cacheline)");}
+
+     p=bi_getenv( "BENCHIT_KERNEL_JIT_PREFETCH_OP", 0 );
+     if ((p==0)||(!strcmp(p,"pldl1keep"))) JIT_PREFETCH_OP=0;
+     else if (!strcmp(p,"pldl1strm")) JIT_PREFETCH_OP=1;
+     else if (!strcmp(p,"pldl2keep")) JIT_PREFETCH_OP=2;
+     else if (!strcmp(p,"pldl2strm")) JIT_PREFETCH_OP=3;
+     else if (!strcmp(p,"pldl3keep")) JIT_PREFETCH_OP=4;
+     else if (!strcmp(p,"pldl3strm")) JIT_PREFETCH_OP=5;
+     else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_JIT_PREFETCH_OP");}
+
+     /* list of nop counts */
+     if (bi_getenv( "BENCHIT_KERNEL_JIT_NOPCOUNT", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_JIT_NOPCOUNT", 0 ));else p=NULL;
+     if (p){
+       char *q,*r,*s;
+       int c;
+       do{
+         q=strstr(p,",");if (q) {*q='\0';q++;}
+         s=strstr(p,"/");if (s) {*s='\0';s++;}
+         r=strstr(p,"-");if (r) {*r='\0';r++;}
+
+         if ((s)&&(r)) for (c=atoi(p);c<=atoi(r);c+=atoi(s)) {nopcounts=realloc(nopcounts,(NUM_NOPCOUNTS+1)*sizeof(int));nopcounts[NUM_NOPCOUNTS++]=c;}
+         else if (r) for (c=atoi(p);c<=atoi(r);c++) {nopcounts=realloc(nopcounts,(NUM_NOPCOUNTS+1)*sizeof(int));nopcounts[NUM_NOPCOUNTS++]=c;}
+         else {nopcounts=realloc(nopcounts,(NUM_NOPCOUNTS+1)*sizeof(int));nopcounts[NUM_NOPCOUNTS++]=atoi(p);}
+         p=q;
+       }while(p!=NULL);
+       for (i=0;i<NUM_NOPCOUNTS;i++) if ((nopcounts[i]<0)||(nopcounts[i]>JIT_MAX_NOPS)) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_JIT_NOPCOUNT (0-16)");}
+     }
+   }
+   else if (!asm_work_supported(FUNCTION,BURST_LENGTH)) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_BURST_LENGTH (ld1/ldr128: 1,2,3,4,8, ld1d/ld1b: 1,2,4,8, ldnp: 2,4,8)");}
+   if (!NUM_NOPCOUNTS){
+     nopcounts=malloc(sizeof(int));
+     nopcounts[NUM_NOPCOUNTS++]=NOPCOUNT;
+   }
+
    p=bi_getenv( "BENCHIT_KERNEL_LOOP_OVERHEAD_COMPENSATION", 0 );
    if (p!=0)
    {
@@ -980,9 +1085,49 @@ void evaluate_environment(bi_info * info)
    if (p!=0){
      TIMEOUT=atoi(p);
    }
+
+   /* helper threads spin while idle (default) or block after BENCHIT_KERNEL_IDLE_SPIN_TIME microseconds */
+   p=bi_getenv( "BENCHIT_KERNEL_IDLE_POLICY", 0 );
+   if ((p==0)||(!strcmp(p,"spin"))) IDLE_SPIN_TIME=-1;
+   else if (!strcmp(p,"block")){
+     p=bi_getenv( "BENCHIT_KERNEL_IDLE_SPIN_TIME", 0 );
+     if (p!=0) IDLE_SPIN_TIME=atoll(p)*1000;
+     else IDLE_SPIN_TIME=100000;
+     if (IDLE_SPIN_TIME<0) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_SPIN_TIME");}
+   }
+   else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_POLICY (spin|block)");}
+
+   /* list of prefetch distances in cachelines, defaults to BENCHIT_KERNEL_LINE_PREFETCH */
+   if (bi_getenv( "BENCHIT_KERNEL_PREFETCH_DISTANCE", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_PREFETCH_DISTANCE", 0 ));else p=NULL;
+   if (p){
+     char *q,*r,*s;
+     unsigned long long d;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       s=strstr(p,"/");if (s) {*s='\0';s++;}
+       r=strstr(p,"-");if (r) {*r='\0';r++;}
+
+       if ((s)&&(r)) for (d=atoll(p);d<=atoll(r);d+=atoll(s)) {prefetch_distances=realloc(prefetch_distances,(NUM_PREFETCH_DISTANCES+1)*sizeof(unsigned long long));prefetch_distances[NUM_PREFETCH_DISTANCES++]=d;}
+       else if (r) for (d=atoll(p);d<=atoll(r);d++) {prefetch_distances=realloc(prefetch_distances,(NUM_PREFETCH_DISTANCES+1)*sizeof(unsigned long long));prefetch_distances[NUM_PREFETCH_DISTANCES++]=d;}
+       else {prefetch_distances=realloc(prefetch_distances,(NUM_PREFETCH_DISTANCES+1)*sizeof(unsigned long long));prefetch_distances[NUM_PREFETCH_DISTANCES++]=atoll(p);}
+       p=q;
+     }while(p!=NULL);
+     if ((LINE_PREFETCH==0)&&(!CODE_GENERATION)) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_PREFETCH_DISTANCE requires BENCHIT_KERNEL_LINE_PREFETCH>0 (prfm instructions not compiled in)");}
+     if ((NUM_PREFETCH_DISTANCES>1)&&(FUNCTION!=0)&&(FUNCTION!=1)&&(FUNCTION!=7)&&(!CODE_GENERATION)) {errors++;sprintf(error_msg,"prefetch distance sweep only supported by ld1, ldr128, and ldnp");}
+   }
+   else{
+     prefetch_distances=malloc(sizeof(unsigned long long));
+     prefetch_distances[NUM_PREFETCH_DISTANCES++]=LINE_PREFETCH;
+   }
+
+   p=bi_getenv( "BENCHIT_KERNEL_DAMAGE_SIZE", 0 );
+   if (p!=0){
+     DAMAGE_SIZE=atoll(p)&~(DAMAGE_GRANULARITY-1ULL);
+   }
    
    p=bi_getenv( "BENCHIT_KERNEL_SERIALIZATION", 0 );
    if ((p!=0)&&(strcmp(p,"mfence"))&&(strcmp(p,"cpuid"))&&(strcmp(p,"disabled"))) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_SERIALIZATION");}
+   if ((p!=0)&&(!strcmp(p,"disabled"))) JIT_SERIALIZE=0;
 
    #ifdef USE_PAPI
    p=bi_getenv( "BENCHIT_KERNEL_ENABLE_PAPI", 0 );
@@ -1086,7 +1231,8 @@ void evaluate_environment(bi_info * info)
    }
    #endif
 
-   if ((BURST_LENGTH>4)&&(BURST_LENGTH!=8)) {errors++;sprintf(error_msg,"BURST LENGTH %i not supported",BURST_LENGTH);}  
+   /* the compiled routines support burst lengths 1-4 and 8, generated code is checked above */
+   if ((!CODE_GENERATION)&&(BURST_LENGTH>4)&&(BURST_LENGTH!=8)) {errors++;sprintf(error_msg,"BURST LENGTH %i not supported",BURST_LENGTH);}  
    if ( errors > 0 ) {
       fprintf( stderr, "Error: There's an environment variable not set or invalid!\n" );      
       fprintf( stderr, "%s\n", error_msg);
@@ -0,0 +1,127 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Functional check of the SVE load routines (asm_work_ld1d_*(), asm_work_ld1b_*()), built and run by test_sve.sh
+ * (e.g. under qemu-aarch64 -cpu max with different vector lengths):
+ *   - the vector length read with rdvl matches the expected one (optional argument, Byte)
+ *   - every routine reads exactly passes*8 vectors: the last pass is executed (a fault is raised if the page
+ *     that only holds the last pass is protected) and no further pass is executed (guard page after the buffer)
+ ******************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <setjmp.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/auxv.h>
+#include "arch.h"
+#include "membench.h"
+
+/* the PMU cycle counter is not necessarily accessible at EL0 (e.g. qemu user mode), the routines are timed with
+ * the generic timer instead, the measured bandwidth is not checked */
+#undef TIMESTAMP
+#define TIMESTAMP "mrs %0,cntvct_el0\n\t"
+
+#include "work.c"
+
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+
+/* pages of the test buffer, followed by a guard page */
+#define NUM_PAGES 4
+
+static int errors=0;
+static sigjmp_buf fault_env;
+
+/* tools/hw_detect is not linked, the routines do not flush caches */
+int clflush(void* buffer,unsigned long long size, cpu_info_t cpuinfo)
+{
+   return 0;
+}
+
+static void fault_handler(int sig)
+{
+   siglongjmp(fault_env,1);
+}
+
+/* runs the routine for passes iterations (8 vectors each) starting at addr, returns 1 if it accessed protected memory */
+static int run(asm_work_t work,unsigned long long addr,unsigned long long passes,volatile mydata_t *data)
+{
+   if (sigsetjmp(fault_env,1)) return 1;
+   work(addr,passes*8,0,0,1000000000ULL,data);
+   return 0;
+}
+
+/* checks all burst lengths of one row of the dispatch table (function) */
+static void check(const char *name,int function,char *buffer,long pagesize,volatile mydata_t *data)
+{
+   unsigned long long vl=data->cpuinfo->sve_vector_length;
+   unsigned long long pass_size=8*vl,passes,end=(unsigned long long)buffer+NUM_PAGES*pagesize;
+   int bursts[]={1,2,4,8};
+   int old_errors=errors;
+   unsigned int i;
+
+   /* the last pass lies in the last page, all previous passes in the pages before */
+   passes=(NUM_PAGES-1)*pagesize/pass_size;
+   for (i=0;i<sizeof(bursts)/sizeof(bursts[0]);i++){
+     if (run(asm_work_table[function][bursts[i]],end-passes*pass_size,passes,data))
+       {errors++;printf("FAILED: %s (burst length %i): more than %llu passes executed\n",name,bursts[i],passes);}
+     mprotect(buffer+(NUM_PAGES-1)*pagesize,pagesize,PROT_NONE);
+     if (!run(asm_work_table[function][bursts[i]],end-pagesize-(passes-1)*pass_size,passes,data))
+       {errors++;printf("FAILED: %s (burst length %i): less than %llu passes executed\n",name,bursts[i],passes);}
+     mprotect(buffer+(NUM_PAGES-1)*pagesize,pagesize,PROT_READ|PROT_WRITE);
+   }
+   printf("%s: %s\n",name,(errors==old_errors)?"ok":"FAILED");
+}
+
+int main(int argc,char **argv)
+{
+   long pagesize=sysconf(_SC_PAGESIZE);
+   unsigned long long vl;
+   cpu_info_t cpuinfo;
+   mydata_t data;
+   char *buffer;
+
+   if (!(getauxval(AT_HWCAP)&HWCAP_SVE)){
+     printf("SVE not supported by this CPU\n");
+     return 1;
+   }
+   __asm__ __volatile__(SVE_ARCH "rdvl %0,#1\n\t" : "=r" (vl));
+   printf("SVE vector length: %llu Byte\n",vl);
+   if ((argc>1)&&(vl!=strtoull(argv[1],NULL,0))){
+     printf("FAILED: expected vector length %s Byte\n",argv[1]);
+     return 1;
+   }
+   if (8*vl>(unsigned long long)pagesize){
+     printf("vector length too large for page size %li\n",pagesize);
+     return 1;
+   }
+
+   memset(&cpuinfo,0,sizeof(cpuinfo));
+   cpuinfo.features=SVE;
+   cpuinfo.sve_vector_length=(unsigned int)vl;
+   memset(&data,0,sizeof(data));
+   data.cpuinfo=&cpuinfo;
+
+   buffer=mmap(NULL,(NUM_PAGES+1)*pagesize,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+   if (buffer==MAP_FAILED){
+     printf("allocation of test buffer failed\n");
+     return 1;
+   }
+   memset(buffer,0,NUM_PAGES*pagesize);
+   mprotect(buffer+NUM_PAGES*pagesize,pagesize,PROT_NONE);
+   signal(SIGSEGV,fault_handler);
+
+   check("ld1d",5,buffer,pagesize,&data);
+   check("ld1b",6,buffer,pagesize,&data);
+
+   munmap(buffer,(NUM_PAGES+1)*pagesize);
+   return errors?1:0;
+}
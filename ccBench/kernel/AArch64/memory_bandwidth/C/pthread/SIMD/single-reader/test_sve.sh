@@ -0,0 +1,40 @@
+#!/bin/sh
+##################################################################################################################
+# BenchIT - Performance Measurement for Scientific Applications
+# Contact: developer@benchit.org
+#
+# $Id$
+# For license details see COPYING in the package base directory
+##################################################################################################################
+# Builds the functional check of the SVE load routines (test_sve.c) and runs it for all vector lengths from
+# 128 to 2048 bit under qemu user mode emulation (qemu-aarch64 -cpu max), no SVE hardware is required.
+# The cross compiler (CC) and qemu (QEMU) can be selected, the libnuma headers are needed for work.h.
+# With QEMU="" the check runs natively for the vector length of the CPU.
+##################################################################################################################
+
+cd `dirname ${0}` || exit 1
+
+CC=${CC:-aarch64-linux-gnu-gcc}
+QEMU=${QEMU-qemu-aarch64}
+ROOT=../../../../../../..
+TMPDIR=`mktemp -d` || exit 1
+trap 'rm -rf ${TMPDIR}' EXIT
+
+printf "${CC} -O2 -Wall -static -I. -I${ROOT} -I${ROOT}/tools/hw_detect -I${ROOT}/tools/membench -o ${TMPDIR}/test_sve test_sve.c ${ROOT}/tools/membench/membench.c -lpthread -lm\n"
+${CC} -O2 -Wall -static -I. -I${ROOT} -I${ROOT}/tools/hw_detect -I${ROOT}/tools/membench -o ${TMPDIR}/test_sve test_sve.c ${ROOT}/tools/membench/membench.c -lpthread -lm || exit 1
+
+if [ -z "${QEMU}" ]; then
+  ${TMPDIR}/test_sve
+  exit $?
+fi
+
+ERRORS=0
+for VL in 16 32 64 128 256; do
+  printf "${QEMU} -cpu max,sve-default-vector-length=${VL} ${TMPDIR}/test_sve ${VL}\n"
+  ${QEMU} -cpu max,sve-default-vector-length=${VL} ${TMPDIR}/test_sve ${VL} || ERRORS=`expr ${ERRORS} + 1`
+done
+
+if [ ${ERRORS} -ne 0 ]; then
+  printf "${ERRORS} vector length(s) FAILED\n"
+  exit 1
+fi
@@ -12,10 +12,10 @@
 #define __WORK_H
 
 #include "mm_malloc.h"
-//#include <mm_malloc.h>
 #include <pthread.h>
 #include <numa.h>
 #include "arch.h"
+#include "membench.h"
 
 #define KERNEL_DESCRIPTION  "single threaded memory bandwidth (load)"
 #define CODE_SEQUENCE       "movdqa mem -> reg"
@@ -23,83 +23,37 @@
 #define Y_AXIS_TEXT_1       "bandwidth [GB/s]"
 #define Y_AXIS_TEXT_2       "counter value/ memory accesses"
 
-/* serialization method */
-#if defined(FORCE_CPUID)
-#define SERIALIZE "push %%rax; push %%rbx; push %%rcx; push %%rdx;" \
-                "mov $0, %%rax;" \
-                "cpuid;" \
-                "pop %%rdx; pop %%rcx; pop %%rbx; pop %%rax;"
-#elif defined(FORCE_MFENCE)
-#define SERIALIZE "dmb sy\n\t"
-#else
-#define SERIALIZE ""
-#endif
-
-/* read timestamp counter */
-#define TIMESTAMP "mrs %0,pmccntr_el0\n\t"
-
-#define LOOP_OVERHEAD_COMP 0x100
-#define OPT_FLUSH_CPU0  0x200
-#define FLUSH(X)  (1<<(X-1))
-
-#define HUGEPAGES_OFF  0x01
-#define HUGEPAGES_ON   0x02
-
-#define LIFO           0x01
-#define FIFO           0x02
-
-/* coherency states */
-#define MODE_EXCLUSIVE 0x01
-#define MODE_MODIFIED  0x02
-#define MODE_INVALID   0x04
-#define MODE_SHARED    0x08
-#define MODE_OWNED     0x10
-#define MODE_FORWARD   0x20
-#define MODE_RDONLY    0x40
-#define MODE_MUW       0x80
-#define MODE_DISABLED  0x00
-
-/* thread functions */
-#define THREAD_INIT            1
-#define THREAD_STOP            2
-#define THREAD_USE_MEMORY      3
-#define THREAD_WAIT            4
-#define THREAD_PREFETCH_CODE   5
-#define THREAD_FLUSH           6
-#define THREAD_FLUSH_ALL       7
-
-/* default value for accessing each cacheline - updated with hw_detect information if available */
-#define STRIDE        64
-
-/* definitions to add the selected number of "nop" instructions (BENCHIT_KERNEL_NOPCOUNT) into the assembler code */
-#ifndef NOPCOUNT
-#define NOPCOUNT 0
-#endif
-#define _nop0 ""
-#define _nop1 "nop;"_nop0
-#define _nop2 "nop;"_nop1
-#define _nop3 "nop;"_nop2
-#define _nop4 "nop;"_nop3
-#define _nop5 "nop;"_nop4
-#define _nop6 "nop;"_nop5
-#define _nop7 "nop;"_nop6
-#define _nop8 "nop;"_nop7
-#define _nop9 "nop;"_nop8
-#define _nop10 "nop;"_nop9
-#define _donop(x) _nop ## x       //_donop(n)     -> _nopn
-#define NOP(x) _donop(x)          //NOP(NOPCOUNT) -> _donop(n)
-
-/* definitions to add prefetch instructions according to BENCHIT_KERNEL_LINE_PREFETCH setting */
+/* definitions to add prefetch instructions according to BENCHIT_KERNEL_LINE_PREFETCH setting
+ * one prfm per cacheline, addresses are relative to a separate pointer (reg) that runs ahead of the loads
+ * the prefetch distance is therefore a runtime parameter (BENCHIT_KERNEL_PREFETCH_DISTANCE)
+ * PREFETCH_OP selects target cache and policy (BENCHIT_KERNEL_PREFETCH_OP: pldl1keep, pldl2keep, pldl1strm, ...) */
 #ifndef LINE_PREFETCH
 #define LINE_PREFETCH 0
 #endif
+#ifndef PREFETCH_OP
+#define PREFETCH_OP pldl1keep
+#endif
 #if LINE_PREFETCH == 0
-#define PREFETCH(lines,offset,reg) ""
+#define PREFETCH(offset,reg) ""
+#define PREFETCH_ADVANCE(bytes,reg) ""
 #else
-#define _doprefetch(lines,offset,reg) "prefetcht0 "#offset"+64*"#lines"(%%"#reg");"
-#define PREFETCH(lines,offset,reg) _doprefetch(lines,offset,reg)       //PREFETCH(LINE_PREFETCH,offset,reg) -> _doprefetch(n,offset,reg)
+#define _prfm_op(op) #op
+#define _doprefetch(op,offset,reg) "prfm "_prfm_op(op)",["#reg",#"#offset"]\n\t"
+#define PREFETCH(offset,reg) _doprefetch(PREFETCH_OP,offset,reg)       //PREFETCH(offset,%3) -> prfm pldl1keep,[%3,#offset]
+#define PREFETCH_ADVANCE(bytes,reg) "add "#reg","#reg",#"#bytes"\n\t"
 #endif
 
+/* largest burst length (number of registers used before the first one is reused) */
+#define MAX_BURST_LENGTH 8
+
+/* runtime code generation (BENCHIT_KERNEL_CODE_GENERATION="jit")
+ * the measurement loop is written into an executable buffer before each measurement, so nop count, prefetch distance
+ * and operation, serialization, burst length, and unroll factor are runtime parameters */
+#define JIT_BUFFER_SIZE  (256*1024)
+#define JIT_MAX_UNROLL   1024                           // loads per loop iteration
+#define JIT_MAX_NOPS     16                             // nops after each load
+#define JIT_MAX_BURST    8                              // registers v0-v7 (caller-saved)
+
 #ifndef AVX_STARTUP_REG_OPS
 #define AVX_STARTUP_REG_OPS 0
 #endif
@@ -112,7 +66,9 @@ typedef struct mydata
    char* cache_flush_area;
    pthread_t *threads;
    struct threaddata *threaddata;
-   cpu_info_t *cpuinfo;                                 //40  
+   char* jit_buffer;                                    // executable memory for generated code, NULL if disabled
+   cpu_info_t *cpuinfo;                                 //48  
+   damage_t damage;                                     //+24, co-resident working set (BENCHIT_KERNEL_DAMAGE_SIZE)
    unsigned int FRST_SHARE_CPU;
    unsigned int NUM_SHARED_CPUS;
    unsigned int alignment;                              //+12  
@@ -133,7 +89,10 @@ typedef struct mydata
    unsigned char USE_DIRECTION;                         //+4
    unsigned char ENABLE_CODE_PREFETCH;
    unsigned char USE_MODE;                              //+2
-   unsigned char padding1[51];                          //+51 = 128
+   unsigned char jit_serialize;                         // dmb sy around timestamps in generated code
+   unsigned char jit_prefetch_op;                       //+2, prfm operation in generated code
+   unsigned short jit_unroll;                           //+2, loads per iteration of generated loop
+   unsigned char padding1[14];                          //+14 = 128
    unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
    #ifdef USE_PAPI
    long long *values;
@@ -141,13 +100,11 @@ typedef struct mydata
    int Eventset;
    int num_events;                                      //(24) 
    #endif
-   int *thread_comm;                                    //+8   
-   volatile unsigned short ack;
-   volatile unsigned short done;                        //+4 
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
    #ifdef USE_PAPI
-   unsigned char padding2[28];                          //24+8+4+28 = 64
+   unsigned char padding2[32];                          //24+8+32 = 64
    #else
-   unsigned char padding2[52];                          //   8+4+52 = 64
+   unsigned char padding2[56];                          //   8+56 = 64
    #endif
    unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
 } mydata_t;
@@ -193,9 +150,16 @@ unsigned long long _random(void);
 /* measure overhead of empty loop */
 int asm_loop_overhead(int n);
 
+/* returns 1 if a static implementation exists for the combination of function and burst length */
+int asm_work_supported(int function, int burst_length);
+
  
-/* function that performs the measurement */
-void _work(unsigned long long memsize, int offset, int function, int burst_length, int runs,volatile mydata_t* data, double **results);
+/* function that performs the measurement
+ * nopcount is only used by generated code (data->jit_buffer!=NULL), the static implementations use NOPCOUNT */
+void _work(unsigned long long memsize, int offset, int function, int burst_length, unsigned long long prefetch_distance, int nopcount, int runs,volatile mydata_t* data, double **results);
+
+/* parallel first touch of the master buffer and the threads' buffers by the threads on the buffers' NUMA nodes */
+void init_buffers(volatile mydata_t *data,unsigned long long buffersize,int mem_bind);
 
 /* loop executed by all threads, except the master thread */
 void *thread(void *threaddata);
@@ -0,0 +1,1263 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures bandwidth of the STREAM operations (copy, scale, add, triad) for data located in different cache levels or memory of certain CPUs.
+ ******************************************************************************************************/
+ 
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+#ifdef USE_PAPI
+#include <papi.h>
+#endif
+
+
+/* accesses of the code prefetch runs of the measurement routines, enough for one loop iteration (64 accesses) */
+#define CODE_PREFETCH_ACCESSES 64
+
+/* accesses of the measuring CPU and the helper threads in USE MODE ADAPTION and thread() */
+#define LOCAL_USE_MEMORY(data,addr,memsize,mode) use_memory((void*)(addr),data->cache_flush_area,memsize,mode,data->USE_DIRECTION,data->NUM_USES,*(data->cpuinfo))
+#define HELPER_USE_MEMORY(global_data,mydata) use_memory((void*)mydata->aligned_addr,mydata->cache_flush_area,mydata->memsize,mydata->USE_MODE,mydata->USE_DIRECTION,mydata->NUM_USES,*(mydata->cpuinfo))
+#include "membench_thread.h"
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,c,d,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: RAX: stop timestamp 
+         *         RBX: start timestamp
+         */
+        __asm__ __volatile__(
+               //"mov $1,%%rcx;"
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+//                "jmp _work_loop_overhead;"
+//                ".align 64,0x0;"
+//                "_work_loop_overhead:"
+//                "sub $1,%%rcx;"
+//                "jnz _work_loop_overhead;"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+	if ((a-b)<ret) ret=(a-b);
+   }			
+  return (int)ret;
+}
+
+/** assembler implementation of STREAM copy (c = a) on 64 bit floating point data
+ *  ldr q (a) -> str q (c), 8 independent registers per array
+ */
+static double asm_work_copy(unsigned long long a, unsigned long long b, unsigned long long c, unsigned long long accesses, unsigned long long scalar, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_copy(unsigned long long a, unsigned long long b, unsigned long long c, unsigned long long accesses, unsigned long long scalar, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   passes=accesses/64;
+   if (!passes) return 0;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+      /*
+       * Input:  %1: a, %2: b, %3: c (pointers to the arrays)
+       *         %4: passes (number of loop iterations)
+       *         %5: scalar (bit pattern of the 64 bit floating point factor)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                "fmov d31,%5\n\t"
+                "dup v31.2d,v31.d[0]\n\t"
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_copy\n\t"
+                ".align 6\n\t"
+                "_work_loop_copy:\n\t"
+		"ldr q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#48]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#112]\n\t"NOP(NOPCOUNT)
+		"str q0,[%3,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#16]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#32]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#48]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#64]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#80]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#96]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#112]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#176]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#240]\n\t"NOP(NOPCOUNT)
+		"str q0,[%3,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#144]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#160]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#176]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#192]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#208]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#224]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#240]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#304]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#368]\n\t"NOP(NOPCOUNT)
+		"str q0,[%3,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#272]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#288]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#304]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#320]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#336]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#352]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#368]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#432]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#496]\n\t"NOP(NOPCOUNT)
+		"str q0,[%3,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#400]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#416]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#432]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#448]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#464]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#480]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#496]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#560]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#624]\n\t"NOP(NOPCOUNT)
+		"str q0,[%3,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#528]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#544]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#560]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#576]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#592]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#608]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#624]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#688]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#752]\n\t"NOP(NOPCOUNT)
+		"str q0,[%3,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#656]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#672]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#688]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#704]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#720]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#736]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#752]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#816]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#880]\n\t"NOP(NOPCOUNT)
+		"str q0,[%3,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#784]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#800]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#816]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#832]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#848]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#864]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#880]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#944]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#1008]\n\t"NOP(NOPCOUNT)
+		"str q0,[%3,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#912]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#928]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#944]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#960]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#976]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#992]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+		"add %3,%3,#1024\n\t"
+
+		"subs %4,%4,#1\n\t"
+                "bne _work_loop_copy\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (a)
+                : "r"(a), "r"(b), "r"(c), "r" (passes), "r" (scalar)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7",
+                  "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v31"
+      );
+      /* 2 arrays with 1024 Byte each are accessed per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((a)-call_latency))/(((double)freq)*0.000000001)));
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** assembler implementation of STREAM scale (b = s * c) on 64 bit floating point data
+ *  ldr q (c) -> fmul -> str q (b), 8 independent registers per array
+ */
+static double asm_work_scale(unsigned long long a, unsigned long long b, unsigned long long c, unsigned long long accesses, unsigned long long scalar, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_scale(unsigned long long a, unsigned long long b, unsigned long long c, unsigned long long accesses, unsigned long long scalar, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   passes=accesses/64;
+   if (!passes) return 0;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+      /*
+       * Input:  %1: a, %2: b, %3: c (pointers to the arrays)
+       *         %4: passes (number of loop iterations)
+       *         %5: scalar (bit pattern of the 64 bit floating point factor)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                "fmov d31,%5\n\t"
+                "dup v31.2d,v31.d[0]\n\t"
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_scale\n\t"
+                ".align 6\n\t"
+                "_work_loop_scale:\n\t"
+		"ldr q0,[%3,#0]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%3,#16]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%3,#32]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%3,#48]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%3,#64]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%3,#80]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%3,#96]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%3,#112]\n\t"NOP(NOPCOUNT)
+		"fmul v0.2d,v0.2d,v31.2d\n\t"
+		"fmul v1.2d,v1.2d,v31.2d\n\t"
+		"fmul v2.2d,v2.2d,v31.2d\n\t"
+		"fmul v3.2d,v3.2d,v31.2d\n\t"
+		"fmul v4.2d,v4.2d,v31.2d\n\t"
+		"fmul v5.2d,v5.2d,v31.2d\n\t"
+		"fmul v6.2d,v6.2d,v31.2d\n\t"
+		"fmul v7.2d,v7.2d,v31.2d\n\t"
+		"str q0,[%2,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#16]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#32]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#48]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#64]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#80]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#96]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#112]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%3,#128]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%3,#144]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%3,#160]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%3,#176]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%3,#192]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%3,#208]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%3,#224]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%3,#240]\n\t"NOP(NOPCOUNT)
+		"fmul v0.2d,v0.2d,v31.2d\n\t"
+		"fmul v1.2d,v1.2d,v31.2d\n\t"
+		"fmul v2.2d,v2.2d,v31.2d\n\t"
+		"fmul v3.2d,v3.2d,v31.2d\n\t"
+		"fmul v4.2d,v4.2d,v31.2d\n\t"
+		"fmul v5.2d,v5.2d,v31.2d\n\t"
+		"fmul v6.2d,v6.2d,v31.2d\n\t"
+		"fmul v7.2d,v7.2d,v31.2d\n\t"
+		"str q0,[%2,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#144]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#160]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#176]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#192]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#208]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#224]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#240]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%3,#256]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%3,#272]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%3,#288]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%3,#304]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%3,#320]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%3,#336]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%3,#352]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%3,#368]\n\t"NOP(NOPCOUNT)
+		"fmul v0.2d,v0.2d,v31.2d\n\t"
+		"fmul v1.2d,v1.2d,v31.2d\n\t"
+		"fmul v2.2d,v2.2d,v31.2d\n\t"
+		"fmul v3.2d,v3.2d,v31.2d\n\t"
+		"fmul v4.2d,v4.2d,v31.2d\n\t"
+		"fmul v5.2d,v5.2d,v31.2d\n\t"
+		"fmul v6.2d,v6.2d,v31.2d\n\t"
+		"fmul v7.2d,v7.2d,v31.2d\n\t"
+		"str q0,[%2,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#272]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#288]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#304]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#320]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#336]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#352]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#368]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%3,#384]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%3,#400]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%3,#416]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%3,#432]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%3,#448]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%3,#464]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%3,#480]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%3,#496]\n\t"NOP(NOPCOUNT)
+		"fmul v0.2d,v0.2d,v31.2d\n\t"
+		"fmul v1.2d,v1.2d,v31.2d\n\t"
+		"fmul v2.2d,v2.2d,v31.2d\n\t"
+		"fmul v3.2d,v3.2d,v31.2d\n\t"
+		"fmul v4.2d,v4.2d,v31.2d\n\t"
+		"fmul v5.2d,v5.2d,v31.2d\n\t"
+		"fmul v6.2d,v6.2d,v31.2d\n\t"
+		"fmul v7.2d,v7.2d,v31.2d\n\t"
+		"str q0,[%2,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#400]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#416]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#432]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#448]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#464]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#480]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#496]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%3,#512]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%3,#528]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%3,#544]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%3,#560]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%3,#576]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%3,#592]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%3,#608]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%3,#624]\n\t"NOP(NOPCOUNT)
+		"fmul v0.2d,v0.2d,v31.2d\n\t"
+		"fmul v1.2d,v1.2d,v31.2d\n\t"
+		"fmul v2.2d,v2.2d,v31.2d\n\t"
+		"fmul v3.2d,v3.2d,v31.2d\n\t"
+		"fmul v4.2d,v4.2d,v31.2d\n\t"
+		"fmul v5.2d,v5.2d,v31.2d\n\t"
+		"fmul v6.2d,v6.2d,v31.2d\n\t"
+		"fmul v7.2d,v7.2d,v31.2d\n\t"
+		"str q0,[%2,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#528]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#544]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#560]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#576]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#592]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#608]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#624]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%3,#640]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%3,#656]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%3,#672]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%3,#688]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%3,#704]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%3,#720]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%3,#736]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%3,#752]\n\t"NOP(NOPCOUNT)
+		"fmul v0.2d,v0.2d,v31.2d\n\t"
+		"fmul v1.2d,v1.2d,v31.2d\n\t"
+		"fmul v2.2d,v2.2d,v31.2d\n\t"
+		"fmul v3.2d,v3.2d,v31.2d\n\t"
+		"fmul v4.2d,v4.2d,v31.2d\n\t"
+		"fmul v5.2d,v5.2d,v31.2d\n\t"
+		"fmul v6.2d,v6.2d,v31.2d\n\t"
+		"fmul v7.2d,v7.2d,v31.2d\n\t"
+		"str q0,[%2,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#656]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#672]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#688]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#704]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#720]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#736]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#752]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%3,#768]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%3,#784]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%3,#800]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%3,#816]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%3,#832]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%3,#848]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%3,#864]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%3,#880]\n\t"NOP(NOPCOUNT)
+		"fmul v0.2d,v0.2d,v31.2d\n\t"
+		"fmul v1.2d,v1.2d,v31.2d\n\t"
+		"fmul v2.2d,v2.2d,v31.2d\n\t"
+		"fmul v3.2d,v3.2d,v31.2d\n\t"
+		"fmul v4.2d,v4.2d,v31.2d\n\t"
+		"fmul v5.2d,v5.2d,v31.2d\n\t"
+		"fmul v6.2d,v6.2d,v31.2d\n\t"
+		"fmul v7.2d,v7.2d,v31.2d\n\t"
+		"str q0,[%2,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#784]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#800]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#816]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#832]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#848]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#864]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#880]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%3,#896]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%3,#912]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%3,#928]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%3,#944]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%3,#960]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%3,#976]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%3,#992]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%3,#1008]\n\t"NOP(NOPCOUNT)
+		"fmul v0.2d,v0.2d,v31.2d\n\t"
+		"fmul v1.2d,v1.2d,v31.2d\n\t"
+		"fmul v2.2d,v2.2d,v31.2d\n\t"
+		"fmul v3.2d,v3.2d,v31.2d\n\t"
+		"fmul v4.2d,v4.2d,v31.2d\n\t"
+		"fmul v5.2d,v5.2d,v31.2d\n\t"
+		"fmul v6.2d,v6.2d,v31.2d\n\t"
+		"fmul v7.2d,v7.2d,v31.2d\n\t"
+		"str q0,[%2,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%2,#912]\n\t"NOP(NOPCOUNT)
+		"str q2,[%2,#928]\n\t"NOP(NOPCOUNT)
+		"str q3,[%2,#944]\n\t"NOP(NOPCOUNT)
+		"str q4,[%2,#960]\n\t"NOP(NOPCOUNT)
+		"str q5,[%2,#976]\n\t"NOP(NOPCOUNT)
+		"str q6,[%2,#992]\n\t"NOP(NOPCOUNT)
+		"str q7,[%2,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+		"add %3,%3,#1024\n\t"
+
+		"subs %4,%4,#1\n\t"
+                "bne _work_loop_scale\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (a)
+                : "r"(a), "r"(b), "r"(c), "r" (passes), "r" (scalar)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7",
+                  "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v31"
+      );
+      /* 2 arrays with 1024 Byte each are accessed per loop iteration */
+      ret=(((double)(passes*64*16*2))/((double)(((a)-call_latency))/(((double)freq)*0.000000001)));
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** assembler implementation of STREAM add (c = a + b) on 64 bit floating point data
+ *  ldr q (a,b) -> fadd -> str q (c), 8 independent registers per array
+ */
+static double asm_work_add(unsigned long long a, unsigned long long b, unsigned long long c, unsigned long long accesses, unsigned long long scalar, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_add(unsigned long long a, unsigned long long b, unsigned long long c, unsigned long long accesses, unsigned long long scalar, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   passes=accesses/64;
+   if (!passes) return 0;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+      /*
+       * Input:  %1: a, %2: b, %3: c (pointers to the arrays)
+       *         %4: passes (number of loop iterations)
+       *         %5: scalar (bit pattern of the 64 bit floating point factor)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                "fmov d31,%5\n\t"
+                "dup v31.2d,v31.d[0]\n\t"
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_add\n\t"
+                ".align 6\n\t"
+                "_work_loop_add:\n\t"
+		"ldr q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#48]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#112]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%2,#0]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%2,#16]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%2,#32]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%2,#48]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%2,#64]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%2,#80]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%2,#96]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%2,#112]\n\t"NOP(NOPCOUNT)
+		"fadd v0.2d,v0.2d,v16.2d\n\t"
+		"fadd v1.2d,v1.2d,v17.2d\n\t"
+		"fadd v2.2d,v2.2d,v18.2d\n\t"
+		"fadd v3.2d,v3.2d,v19.2d\n\t"
+		"fadd v4.2d,v4.2d,v20.2d\n\t"
+		"fadd v5.2d,v5.2d,v21.2d\n\t"
+		"fadd v6.2d,v6.2d,v22.2d\n\t"
+		"fadd v7.2d,v7.2d,v23.2d\n\t"
+		"str q0,[%3,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#16]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#32]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#48]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#64]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#80]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#96]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#112]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#176]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#240]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%2,#128]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%2,#144]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%2,#160]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%2,#176]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%2,#192]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%2,#208]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%2,#224]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%2,#240]\n\t"NOP(NOPCOUNT)
+		"fadd v0.2d,v0.2d,v16.2d\n\t"
+		"fadd v1.2d,v1.2d,v17.2d\n\t"
+		"fadd v2.2d,v2.2d,v18.2d\n\t"
+		"fadd v3.2d,v3.2d,v19.2d\n\t"
+		"fadd v4.2d,v4.2d,v20.2d\n\t"
+		"fadd v5.2d,v5.2d,v21.2d\n\t"
+		"fadd v6.2d,v6.2d,v22.2d\n\t"
+		"fadd v7.2d,v7.2d,v23.2d\n\t"
+		"str q0,[%3,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#144]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#160]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#176]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#192]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#208]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#224]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#240]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#304]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#368]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%2,#256]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%2,#272]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%2,#288]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%2,#304]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%2,#320]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%2,#336]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%2,#352]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%2,#368]\n\t"NOP(NOPCOUNT)
+		"fadd v0.2d,v0.2d,v16.2d\n\t"
+		"fadd v1.2d,v1.2d,v17.2d\n\t"
+		"fadd v2.2d,v2.2d,v18.2d\n\t"
+		"fadd v3.2d,v3.2d,v19.2d\n\t"
+		"fadd v4.2d,v4.2d,v20.2d\n\t"
+		"fadd v5.2d,v5.2d,v21.2d\n\t"
+		"fadd v6.2d,v6.2d,v22.2d\n\t"
+		"fadd v7.2d,v7.2d,v23.2d\n\t"
+		"str q0,[%3,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#272]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#288]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#304]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#320]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#336]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#352]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#368]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#432]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#496]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%2,#384]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%2,#400]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%2,#416]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%2,#432]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%2,#448]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%2,#464]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%2,#480]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%2,#496]\n\t"NOP(NOPCOUNT)
+		"fadd v0.2d,v0.2d,v16.2d\n\t"
+		"fadd v1.2d,v1.2d,v17.2d\n\t"
+		"fadd v2.2d,v2.2d,v18.2d\n\t"
+		"fadd v3.2d,v3.2d,v19.2d\n\t"
+		"fadd v4.2d,v4.2d,v20.2d\n\t"
+		"fadd v5.2d,v5.2d,v21.2d\n\t"
+		"fadd v6.2d,v6.2d,v22.2d\n\t"
+		"fadd v7.2d,v7.2d,v23.2d\n\t"
+		"str q0,[%3,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#400]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#416]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#432]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#448]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#464]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#480]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#496]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#560]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#624]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%2,#512]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%2,#528]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%2,#544]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%2,#560]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%2,#576]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%2,#592]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%2,#608]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%2,#624]\n\t"NOP(NOPCOUNT)
+		"fadd v0.2d,v0.2d,v16.2d\n\t"
+		"fadd v1.2d,v1.2d,v17.2d\n\t"
+		"fadd v2.2d,v2.2d,v18.2d\n\t"
+		"fadd v3.2d,v3.2d,v19.2d\n\t"
+		"fadd v4.2d,v4.2d,v20.2d\n\t"
+		"fadd v5.2d,v5.2d,v21.2d\n\t"
+		"fadd v6.2d,v6.2d,v22.2d\n\t"
+		"fadd v7.2d,v7.2d,v23.2d\n\t"
+		"str q0,[%3,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#528]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#544]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#560]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#576]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#592]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#608]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#624]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#688]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#752]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%2,#640]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%2,#656]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%2,#672]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%2,#688]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%2,#704]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%2,#720]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%2,#736]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%2,#752]\n\t"NOP(NOPCOUNT)
+		"fadd v0.2d,v0.2d,v16.2d\n\t"
+		"fadd v1.2d,v1.2d,v17.2d\n\t"
+		"fadd v2.2d,v2.2d,v18.2d\n\t"
+		"fadd v3.2d,v3.2d,v19.2d\n\t"
+		"fadd v4.2d,v4.2d,v20.2d\n\t"
+		"fadd v5.2d,v5.2d,v21.2d\n\t"
+		"fadd v6.2d,v6.2d,v22.2d\n\t"
+		"fadd v7.2d,v7.2d,v23.2d\n\t"
+		"str q0,[%3,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#656]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#672]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#688]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#704]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#720]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#736]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#752]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#816]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#880]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%2,#768]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%2,#784]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%2,#800]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%2,#816]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%2,#832]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%2,#848]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%2,#864]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%2,#880]\n\t"NOP(NOPCOUNT)
+		"fadd v0.2d,v0.2d,v16.2d\n\t"
+		"fadd v1.2d,v1.2d,v17.2d\n\t"
+		"fadd v2.2d,v2.2d,v18.2d\n\t"
+		"fadd v3.2d,v3.2d,v19.2d\n\t"
+		"fadd v4.2d,v4.2d,v20.2d\n\t"
+		"fadd v5.2d,v5.2d,v21.2d\n\t"
+		"fadd v6.2d,v6.2d,v22.2d\n\t"
+		"fadd v7.2d,v7.2d,v23.2d\n\t"
+		"str q0,[%3,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#784]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#800]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#816]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#832]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#848]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#864]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#880]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%1,#944]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%1,#1008]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%2,#896]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%2,#912]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%2,#928]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%2,#944]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%2,#960]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%2,#976]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%2,#992]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%2,#1008]\n\t"NOP(NOPCOUNT)
+		"fadd v0.2d,v0.2d,v16.2d\n\t"
+		"fadd v1.2d,v1.2d,v17.2d\n\t"
+		"fadd v2.2d,v2.2d,v18.2d\n\t"
+		"fadd v3.2d,v3.2d,v19.2d\n\t"
+		"fadd v4.2d,v4.2d,v20.2d\n\t"
+		"fadd v5.2d,v5.2d,v21.2d\n\t"
+		"fadd v6.2d,v6.2d,v22.2d\n\t"
+		"fadd v7.2d,v7.2d,v23.2d\n\t"
+		"str q0,[%3,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%3,#912]\n\t"NOP(NOPCOUNT)
+		"str q2,[%3,#928]\n\t"NOP(NOPCOUNT)
+		"str q3,[%3,#944]\n\t"NOP(NOPCOUNT)
+		"str q4,[%3,#960]\n\t"NOP(NOPCOUNT)
+		"str q5,[%3,#976]\n\t"NOP(NOPCOUNT)
+		"str q6,[%3,#992]\n\t"NOP(NOPCOUNT)
+		"str q7,[%3,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+		"add %3,%3,#1024\n\t"
+
+		"subs %4,%4,#1\n\t"
+                "bne _work_loop_add\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (a)
+                : "r"(a), "r"(b), "r"(c), "r" (passes), "r" (scalar)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7",
+                  "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v31"
+      );
+      /* 3 arrays with 1024 Byte each are accessed per loop iteration */
+      ret=(((double)(passes*64*16*3))/((double)(((a)-call_latency))/(((double)freq)*0.000000001)));
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** assembler implementation of STREAM triad (a = b + s * c) on 64 bit floating point data
+ *  ldr q (b,c) -> fmla -> str q (a), 8 independent registers per array
+ */
+static double asm_work_triad(unsigned long long a, unsigned long long b, unsigned long long c, unsigned long long accesses, unsigned long long scalar, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_triad(unsigned long long a, unsigned long long b, unsigned long long c, unsigned long long accesses, unsigned long long scalar, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   passes=accesses/64;
+   if (!passes) return 0;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+      /*
+       * Input:  %1: a, %2: b, %3: c (pointers to the arrays)
+       *         %4: passes (number of loop iterations)
+       *         %5: scalar (bit pattern of the 64 bit floating point factor)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                "fmov d31,%5\n\t"
+                "dup v31.2d,v31.d[0]\n\t"
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_triad\n\t"
+                ".align 6\n\t"
+                "_work_loop_triad:\n\t"
+		"ldr q0,[%2,#0]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%2,#16]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%2,#32]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%2,#48]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%2,#64]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%2,#80]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%2,#96]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%2,#112]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%3,#0]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%3,#16]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%3,#32]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%3,#48]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%3,#64]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%3,#80]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%3,#96]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%3,#112]\n\t"NOP(NOPCOUNT)
+		"fmla v0.2d,v16.2d,v31.2d\n\t"
+		"fmla v1.2d,v17.2d,v31.2d\n\t"
+		"fmla v2.2d,v18.2d,v31.2d\n\t"
+		"fmla v3.2d,v19.2d,v31.2d\n\t"
+		"fmla v4.2d,v20.2d,v31.2d\n\t"
+		"fmla v5.2d,v21.2d,v31.2d\n\t"
+		"fmla v6.2d,v22.2d,v31.2d\n\t"
+		"fmla v7.2d,v23.2d,v31.2d\n\t"
+		"str q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#48]\n\t"NOP(NOPCOUNT)
+		"str q4,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#112]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%2,#128]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%2,#144]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%2,#160]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%2,#176]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%2,#192]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%2,#208]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%2,#224]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%2,#240]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%3,#128]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%3,#144]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%3,#160]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%3,#176]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%3,#192]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%3,#208]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%3,#224]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%3,#240]\n\t"NOP(NOPCOUNT)
+		"fmla v0.2d,v16.2d,v31.2d\n\t"
+		"fmla v1.2d,v17.2d,v31.2d\n\t"
+		"fmla v2.2d,v18.2d,v31.2d\n\t"
+		"fmla v3.2d,v19.2d,v31.2d\n\t"
+		"fmla v4.2d,v20.2d,v31.2d\n\t"
+		"fmla v5.2d,v21.2d,v31.2d\n\t"
+		"fmla v6.2d,v22.2d,v31.2d\n\t"
+		"fmla v7.2d,v23.2d,v31.2d\n\t"
+		"str q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#176]\n\t"NOP(NOPCOUNT)
+		"str q4,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#240]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%2,#256]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%2,#272]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%2,#288]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%2,#304]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%2,#320]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%2,#336]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%2,#352]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%2,#368]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%3,#256]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%3,#272]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%3,#288]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%3,#304]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%3,#320]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%3,#336]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%3,#352]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%3,#368]\n\t"NOP(NOPCOUNT)
+		"fmla v0.2d,v16.2d,v31.2d\n\t"
+		"fmla v1.2d,v17.2d,v31.2d\n\t"
+		"fmla v2.2d,v18.2d,v31.2d\n\t"
+		"fmla v3.2d,v19.2d,v31.2d\n\t"
+		"fmla v4.2d,v20.2d,v31.2d\n\t"
+		"fmla v5.2d,v21.2d,v31.2d\n\t"
+		"fmla v6.2d,v22.2d,v31.2d\n\t"
+		"fmla v7.2d,v23.2d,v31.2d\n\t"
+		"str q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#304]\n\t"NOP(NOPCOUNT)
+		"str q4,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#368]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%2,#384]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%2,#400]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%2,#416]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%2,#432]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%2,#448]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%2,#464]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%2,#480]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%2,#496]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%3,#384]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%3,#400]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%3,#416]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%3,#432]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%3,#448]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%3,#464]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%3,#480]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%3,#496]\n\t"NOP(NOPCOUNT)
+		"fmla v0.2d,v16.2d,v31.2d\n\t"
+		"fmla v1.2d,v17.2d,v31.2d\n\t"
+		"fmla v2.2d,v18.2d,v31.2d\n\t"
+		"fmla v3.2d,v19.2d,v31.2d\n\t"
+		"fmla v4.2d,v20.2d,v31.2d\n\t"
+		"fmla v5.2d,v21.2d,v31.2d\n\t"
+		"fmla v6.2d,v22.2d,v31.2d\n\t"
+		"fmla v7.2d,v23.2d,v31.2d\n\t"
+		"str q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#432]\n\t"NOP(NOPCOUNT)
+		"str q4,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#496]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%2,#512]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%2,#528]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%2,#544]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%2,#560]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%2,#576]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%2,#592]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%2,#608]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%2,#624]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%3,#512]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%3,#528]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%3,#544]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%3,#560]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%3,#576]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%3,#592]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%3,#608]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%3,#624]\n\t"NOP(NOPCOUNT)
+		"fmla v0.2d,v16.2d,v31.2d\n\t"
+		"fmla v1.2d,v17.2d,v31.2d\n\t"
+		"fmla v2.2d,v18.2d,v31.2d\n\t"
+		"fmla v3.2d,v19.2d,v31.2d\n\t"
+		"fmla v4.2d,v20.2d,v31.2d\n\t"
+		"fmla v5.2d,v21.2d,v31.2d\n\t"
+		"fmla v6.2d,v22.2d,v31.2d\n\t"
+		"fmla v7.2d,v23.2d,v31.2d\n\t"
+		"str q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#560]\n\t"NOP(NOPCOUNT)
+		"str q4,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#624]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%2,#640]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%2,#656]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%2,#672]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%2,#688]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%2,#704]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%2,#720]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%2,#736]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%2,#752]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%3,#640]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%3,#656]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%3,#672]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%3,#688]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%3,#704]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%3,#720]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%3,#736]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%3,#752]\n\t"NOP(NOPCOUNT)
+		"fmla v0.2d,v16.2d,v31.2d\n\t"
+		"fmla v1.2d,v17.2d,v31.2d\n\t"
+		"fmla v2.2d,v18.2d,v31.2d\n\t"
+		"fmla v3.2d,v19.2d,v31.2d\n\t"
+		"fmla v4.2d,v20.2d,v31.2d\n\t"
+		"fmla v5.2d,v21.2d,v31.2d\n\t"
+		"fmla v6.2d,v22.2d,v31.2d\n\t"
+		"fmla v7.2d,v23.2d,v31.2d\n\t"
+		"str q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#688]\n\t"NOP(NOPCOUNT)
+		"str q4,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#752]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%2,#768]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%2,#784]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%2,#800]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%2,#816]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%2,#832]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%2,#848]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%2,#864]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%2,#880]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%3,#768]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%3,#784]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%3,#800]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%3,#816]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%3,#832]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%3,#848]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%3,#864]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%3,#880]\n\t"NOP(NOPCOUNT)
+		"fmla v0.2d,v16.2d,v31.2d\n\t"
+		"fmla v1.2d,v17.2d,v31.2d\n\t"
+		"fmla v2.2d,v18.2d,v31.2d\n\t"
+		"fmla v3.2d,v19.2d,v31.2d\n\t"
+		"fmla v4.2d,v20.2d,v31.2d\n\t"
+		"fmla v5.2d,v21.2d,v31.2d\n\t"
+		"fmla v6.2d,v22.2d,v31.2d\n\t"
+		"fmla v7.2d,v23.2d,v31.2d\n\t"
+		"str q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#816]\n\t"NOP(NOPCOUNT)
+		"str q4,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#880]\n\t"NOP(NOPCOUNT)
+
+		"ldr q0,[%2,#896]\n\t"NOP(NOPCOUNT)
+		"ldr q1,[%2,#912]\n\t"NOP(NOPCOUNT)
+		"ldr q2,[%2,#928]\n\t"NOP(NOPCOUNT)
+		"ldr q3,[%2,#944]\n\t"NOP(NOPCOUNT)
+		"ldr q4,[%2,#960]\n\t"NOP(NOPCOUNT)
+		"ldr q5,[%2,#976]\n\t"NOP(NOPCOUNT)
+		"ldr q6,[%2,#992]\n\t"NOP(NOPCOUNT)
+		"ldr q7,[%2,#1008]\n\t"NOP(NOPCOUNT)
+		"ldr q16,[%3,#896]\n\t"NOP(NOPCOUNT)
+		"ldr q17,[%3,#912]\n\t"NOP(NOPCOUNT)
+		"ldr q18,[%3,#928]\n\t"NOP(NOPCOUNT)
+		"ldr q19,[%3,#944]\n\t"NOP(NOPCOUNT)
+		"ldr q20,[%3,#960]\n\t"NOP(NOPCOUNT)
+		"ldr q21,[%3,#976]\n\t"NOP(NOPCOUNT)
+		"ldr q22,[%3,#992]\n\t"NOP(NOPCOUNT)
+		"ldr q23,[%3,#1008]\n\t"NOP(NOPCOUNT)
+		"fmla v0.2d,v16.2d,v31.2d\n\t"
+		"fmla v1.2d,v17.2d,v31.2d\n\t"
+		"fmla v2.2d,v18.2d,v31.2d\n\t"
+		"fmla v3.2d,v19.2d,v31.2d\n\t"
+		"fmla v4.2d,v20.2d,v31.2d\n\t"
+		"fmla v5.2d,v21.2d,v31.2d\n\t"
+		"fmla v6.2d,v22.2d,v31.2d\n\t"
+		"fmla v7.2d,v23.2d,v31.2d\n\t"
+		"str q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#944]\n\t"NOP(NOPCOUNT)
+		"str q4,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+		"add %2,%2,#1024\n\t"
+		"add %3,%3,#1024\n\t"
+
+		"subs %4,%4,#1\n\t"
+                "bne _work_loop_triad\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (a)
+                : "r"(a), "r"(b), "r"(c), "r" (passes), "r" (scalar)
+                : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7",
+                  "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v31"
+      );
+      /* 3 arrays with 1024 Byte each are accessed per loop iteration */
+      ret=(((double)(passes*64*16*3))/((double)(((a)-call_latency))/(((double)freq)*0.000000001)));
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - memsize is the total data set size, it is divided into the three arrays a, b, and c
+ *   - (*results)[o*max_threads+t]: bandwidth of operation o (data->ops[o]) for data in caches of thread t
+ */
+void  _work( unsigned long long memsize, int offset, int runs, volatile mydata_t* data, double **results)
+{
+  int loop_overhead,i,j,t,o;
+  double tmax;
+  double tmp=(double)0;
+  unsigned long long tmp2,tmp3;
+  int dtsize,max_threads;
+  unsigned long long aligned_addr,accesses,arraysize,scalar,fpcr,fpcr_fz;
+  double s=3.0;
+  #ifdef USE_PAPI
+  int count;
+  #endif
+
+  aligned_addr=(unsigned long long)(data->buffer) + offset;
+
+  /* 3 arrays, size is a multiple of the 1024 Byte accessed per loop iteration */
+  dtsize = 16;
+  arraysize = (memsize / 3) & ~1023ULL;
+  accesses = arraysize / dtsize;
+  memcpy(&scalar,&s,sizeof(scalar));
+
+  /* enable flush-to-zero, buffer contents are arbitrary bit patterns that may contain denormals */
+  __asm__ __volatile__("mrs %0,fpcr\n\t" : "=r" (fpcr));
+  fpcr_fz=fpcr|(1ULL<<24);
+  __asm__ __volatile__("msr fpcr,%0\n\t" : : "r" (fpcr_fz));
+  if ((data->settings)&LOOP_OVERHEAD_COMP) loop_overhead=data->loop_overhead;
+  else loop_overhead=data->cpuinfo->rdtsc_latency;
+
+  if (accesses<512) runs*=5;
+  else if (accesses<1024) runs*=3;
+  else if (accesses<4096) runs*=2;
+  if (memsize>data->cpuinfo->Total_D_Cache_Size) runs/=3;
+  if (runs==0) runs=1;
+
+  max_threads=data->num_results;
+  for (t=0;t<max_threads;t++) for (o=0;o<data->num_ops;o++)
+  {
+   tmax=0;
+  
+   if(!t) aligned_addr=(unsigned long long)(data->buffer) + offset;
+   else aligned_addr=data->threaddata[t].aligned_addr;
+  
+   if (accesses) 
+   {
+    for (i=0;i<runs;i++)
+    {
+      use_mode_adaption(data,t,aligned_addr,memsize,accesses);
+
+     /* call ASM implementation */
+    switch(data->ops[o]){
+       case STREAM_COPY:
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_copy((unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,scalar,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_copy(aligned_addr,aligned_addr+arraysize,aligned_addr+2*arraysize,accesses,scalar,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case STREAM_SCALE:
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_scale((unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,scalar,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_scale(aligned_addr,aligned_addr+arraysize,aligned_addr+2*arraysize,accesses,scalar,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case STREAM_ADD:
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_add((unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,scalar,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_add(aligned_addr,aligned_addr+arraysize,aligned_addr+2*arraysize,accesses,scalar,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case STREAM_TRIAD:
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_triad((unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),(unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,scalar,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_triad(aligned_addr,aligned_addr+arraysize,aligned_addr+2*arraysize,accesses,scalar,loop_overhead,data->cpuinfo->clockrate,data);break;
+       default: break;
+     }
+      if ((int)tmp!=-1){
+       if (tmp>tmax)
+       {
+         tmax=tmp;
+         #ifdef USE_PAPI
+         count = 1024 / dtsize;
+
+         for (i=0;i<data->num_events;i++)
+         {
+            data->papi_results[(i*data->num_ops+o)*max_threads+t]=(double)data->values[i]/(double)((accesses/count)*count);
+         }
+         #endif
+       }
+     }
+    }
+   }
+   else tmax=0;
+  
+   if (tmax) (*results)[o*max_threads+t]=tmax;
+   else (*results)[o*max_threads+t]=INVALID_MEASUREMENT;
+  }
+
+  /* restore floating point control register */
+  __asm__ __volatile__("msr fpcr,%0\n\t" : : "r" (fpcr));
+}
+
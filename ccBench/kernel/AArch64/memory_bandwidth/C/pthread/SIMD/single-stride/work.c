@@ -0,0 +1,231 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures strided read bandwidth of data located in different cache levels or memory of certain CPUs (data set size x stride).
+ ******************************************************************************************************/
+ 
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+#ifdef USE_PAPI
+#include <papi.h>
+#endif
+
+
+/* accesses of the measuring CPU and the helper threads in USE MODE ADAPTION and thread() */
+#define LOCAL_USE_MEMORY(data,addr,memsize,mode) use_memory((void*)(addr),data->cache_flush_area,memsize,mode,data->USE_DIRECTION,data->NUM_USES,*(data->cpuinfo))
+#define HELPER_USE_MEMORY(global_data,mydata) use_memory((void*)mydata->aligned_addr,mydata->cache_flush_area,mydata->memsize,mydata->USE_MODE,mydata->USE_DIRECTION,mydata->NUM_USES,*(mydata->cpuinfo))
+#include "membench_thread.h"
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,c,d,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: RAX: stop timestamp 
+         *         RBX: start timestamp
+         */
+        __asm__ __volatile__(
+               //"mov $1,%%rcx;"
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+//                "jmp _work_loop_overhead;"
+//                ".align 64,0x0;"
+//                "_work_loop_overhead:"
+//                "sub $1,%%rcx;"
+//                "jnz _work_loop_overhead;"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+	if ((a-b)<ret) ret=(a-b);
+   }			
+  return (int)ret;
+}
+
+/** assembler implementation of strided bandwidth measurement using ldr (64 bit) instruction
+ *  - the buffer is traversed in sweeps of memsize/stride accesses
+ *  - for strides < 64 Byte there is a single sweep, only one 8 Byte word per stride is accessed
+ *    (16 and 32 Byte strides access every 2nd and every 4th word)
+ *  - for strides >= 64 Byte every sweep starts one cacheline further, so that each cacheline is accessed exactly once
+ */
+static double asm_work_stride(unsigned long long addr, unsigned long long memsize, unsigned long long stride, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_stride(unsigned long long addr, unsigned long long memsize, unsigned long long stride, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes,sweeps,sweep_offset,ptr,count;
+   double ret;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+   /* 8 accesses per loop iteration */
+   passes=(memsize/stride)/8;
+   if (!passes) return 0;
+   if (stride>=64) {sweeps=stride/64;sweep_offset=64;}
+   else {sweeps=1;sweep_offset=0;}
+   ptr=addr;count=passes;
+   /*
+    * Input:  %1: addr (pointer to the buffer, start of current sweep)
+    *         %2: passes (number of loop iterations per sweep)
+    *         %3: stride (distance between accesses in Byte)
+    *         %4: sweeps (number of sweeps)
+    *         %5: ptr (current address)
+    *         %6: count (remaining loop iterations of current sweep)
+    *         %7: sweep_offset (distance between start of consecutive sweeps)
+    * Output: %0: stop timestamp - start timestamp
+    */
+   __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_stride\n\t"
+                ".align 6\n\t"
+                "_work_loop_stride:\n\t"
+		"mov %5,%1\n\t"
+		"mov %6,%2\n\t"
+                "_work_loop_stride_sweep:\n\t"
+		"ldr d0,[%5]\n\t"NOP(NOPCOUNT)
+		"add %5,%5,%3\n\t"
+		"ldr d0,[%5]\n\t"NOP(NOPCOUNT)
+		"add %5,%5,%3\n\t"
+		"ldr d0,[%5]\n\t"NOP(NOPCOUNT)
+		"add %5,%5,%3\n\t"
+		"ldr d0,[%5]\n\t"NOP(NOPCOUNT)
+		"add %5,%5,%3\n\t"
+		"ldr d0,[%5]\n\t"NOP(NOPCOUNT)
+		"add %5,%5,%3\n\t"
+		"ldr d0,[%5]\n\t"NOP(NOPCOUNT)
+		"add %5,%5,%3\n\t"
+		"ldr d0,[%5]\n\t"NOP(NOPCOUNT)
+		"add %5,%5,%3\n\t"
+		"ldr d0,[%5]\n\t"NOP(NOPCOUNT)
+		"add %5,%5,%3\n\t"
+
+		"subs %6,%6,#1\n\t"
+                "bne _work_loop_stride_sweep\n\t"
+		"add %1,%1,%7\n\t"
+		"subs %4,%4,#1\n\t"
+                "bne _work_loop_stride\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes), "r" (stride), "r" (sweeps), "r" (ptr), "r" (count), "r" (sweep_offset)
+                : "v0", "cc", "memory"
+   );
+   /* accessed data (8 Byte per load) */
+   ret=(((double)(sweeps*passes*8*8))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ */
+void  _work( unsigned long long memsize, int offset, unsigned long long stride, int runs, volatile mydata_t* data, double **results)
+{
+  int loop_overhead,i,j,t;
+  double tmax;
+  double tmp=(double)0;
+  double tmp_damage=(double)0;
+  unsigned long long tmp2,tmp3;
+  int max_threads;
+  unsigned long long aligned_addr,accesses;
+  #ifdef USE_PAPI
+  unsigned long long count;
+  #endif
+
+  aligned_addr=(unsigned long long)(data->buffer) + offset;
+
+  /* one 8 Byte word per stride (stride < 64, e.g. every 4th word for 32 Byte) or every cacheline (stride >= 64) is accessed once */
+  if (stride<64) accesses = memsize / stride;
+  else accesses = memsize / 64;
+  if ((data->settings)&LOOP_OVERHEAD_COMP) loop_overhead=data->loop_overhead;
+  else loop_overhead=data->cpuinfo->rdtsc_latency;
+
+  if (accesses<512) runs*=5;
+  else if (accesses<1024) runs*=3;
+  else if (accesses<4096) runs*=2;
+  if (memsize>data->cpuinfo->Total_D_Cache_Size) runs/=3;
+  if (runs==0) runs=1;
+
+  max_threads=data->num_results;
+  for (t=0;t<max_threads;t++)
+  {
+   tmax=0;
+   if (data->damage.size) data->damage.results[t]=INVALID_MEASUREMENT;
+  
+   if(!t) aligned_addr=(unsigned long long)(data->buffer) + offset;
+   else aligned_addr=data->threaddata[t].aligned_addr;
+  
+   if (accesses) 
+   {
+    for (i=0;i<runs;i++)
+    {
+      use_mode_adaption(data,t,aligned_addr,memsize,accesses);
+
+      //bring co-resident working set into the caches of the measuring CPU
+      damage_use(&(data->damage),data->cache_flush_area,data->NUM_USES,data->cpuinfo);
+
+     /* call ASM implementation */
+    //prefetch measurement routine (one loop iteration: 8 accesses)
+    if (data->ENABLE_CODE_PREFETCH)
+      for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_stride((unsigned long long)(data->cache_flush_area),8*stride,stride,loop_overhead,data->cpuinfo->clockrate,data);}
+    //measurement
+    tmp=asm_work_stride(aligned_addr,memsize,stride,loop_overhead,data->cpuinfo->clockrate,data);
+      //check how much of the working set survived the measurement
+      if (data->damage.size) tmp_damage=damage_reread(&(data->damage),loop_overhead,data->cpuinfo->clockrate);
+      if ((int)tmp!=-1){
+       if (tmp>tmax)
+       {
+         tmax=tmp;
+         if (data->damage.size) data->damage.results[t]=tmp_damage;
+         #ifdef USE_PAPI
+         //number of executed loads
+         count = ((memsize/stride)/8)*8;
+         if (stride>=64) count *= stride/64;
+
+         for (i=0;i<data->num_events;i++)
+         {
+            data->papi_results[i*max_threads+t]=(double)data->values[i]/(double)count;
+         }
+         #endif
+       }
+     }
+    }
+   }
+   else tmax=0;
+  
+   if (tmax) (*results)[t]=tmax;
+   else (*results)[t]=INVALID_MEASUREMENT;
+  }
+}
+
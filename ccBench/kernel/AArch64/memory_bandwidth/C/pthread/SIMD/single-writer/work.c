@@ -0,0 +1,1291 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures write bandwidth of data located in different cache levels or memory of certain CPUs.
+ ******************************************************************************************************/
+ 
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+#ifdef USE_PAPI
+#include <papi.h>
+#endif
+
+
+/* accesses of the code prefetch runs of the measurement routines, enough for one loop iteration (64 accesses) */
+#define CODE_PREFETCH_ACCESSES 64
+
+/* accesses of the measuring CPU and the helper threads in USE MODE ADAPTION and thread() */
+#define LOCAL_USE_MEMORY(data,addr,memsize,mode) use_memory((void*)(addr),data->cache_flush_area,memsize,mode,data->USE_DIRECTION,data->NUM_USES,*(data->cpuinfo))
+#define HELPER_USE_MEMORY(global_data,mydata) use_memory((void*)mydata->aligned_addr,mydata->cache_flush_area,mydata->memsize,mydata->USE_MODE,mydata->USE_DIRECTION,mydata->NUM_USES,*(mydata->cpuinfo))
+#include "membench_thread.h"
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,c,d,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: RAX: stop timestamp 
+         *         RBX: start timestamp
+         */
+        __asm__ __volatile__(
+               //"mov $1,%%rcx;"
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+//                "jmp _work_loop_overhead;"
+//                ".align 64,0x0;"
+//                "_work_loop_overhead:"
+//                "sub $1,%%rcx;"
+//                "jnz _work_loop_overhead;"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+	if ((a-b)<ret) ret=(a-b);
+   }			
+  return (int)ret;
+}
+
+/** assembler implementation of bandwidth measurement using str (128 bit) instruction
+ */
+static double asm_work_str128(unsigned long long addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_str128(unsigned long long addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+   switch (burst_length)
+   {
+    case 1:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_str128_1\n\t"
+                ".align 6\n\t"
+                "_work_loop_str128_1:\n\t"
+//str 128
+		"str q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#48]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#112]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#176]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#240]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#304]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#368]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#432]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#496]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#560]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#624]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#688]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#752]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#816]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#880]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#944]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_str128_1\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 2:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_str128_2\n\t"
+                ".align 6\n\t"
+                "_work_loop_str128_2:\n\t"
+//str 128
+		"str q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#48]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#112]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#176]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#240]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#304]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#368]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#432]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#496]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#560]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#624]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#688]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#752]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#816]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#880]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#944]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"str q0,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_str128_2\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 4:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_str128_4\n\t"
+                ".align 6\n\t"
+                "_work_loop_str128_4:\n\t"
+//str 128
+		"str q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#48]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#112]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#176]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#240]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#304]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#368]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#432]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#496]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#560]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#624]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#688]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#752]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#816]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#880]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#944]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_str128_4\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 8:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_str128_8\n\t"
+                ".align 6\n\t"
+                "_work_loop_str128_8:\n\t"
+//str 128
+		"str q0,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#48]\n\t"NOP(NOPCOUNT)
+
+		"str q4,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#112]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#176]\n\t"NOP(NOPCOUNT)
+
+		"str q4,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#240]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#304]\n\t"NOP(NOPCOUNT)
+
+		"str q4,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#368]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#432]\n\t"NOP(NOPCOUNT)
+
+		"str q4,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#496]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#528]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#544]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#560]\n\t"NOP(NOPCOUNT)
+
+		"str q4,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#592]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#608]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#624]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#656]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#672]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#688]\n\t"NOP(NOPCOUNT)
+
+		"str q4,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#720]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#736]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#752]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#784]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#800]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#816]\n\t"NOP(NOPCOUNT)
+
+		"str q4,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#848]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#864]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#880]\n\t"NOP(NOPCOUNT)
+
+		"str q0,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"str q1,[%1,#912]\n\t"NOP(NOPCOUNT)
+		"str q2,[%1,#928]\n\t"NOP(NOPCOUNT)
+		"str q3,[%1,#944]\n\t"NOP(NOPCOUNT)
+
+		"str q4,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"str q5,[%1,#976]\n\t"NOP(NOPCOUNT)
+		"str q6,[%1,#992]\n\t"NOP(NOPCOUNT)
+		"str q7,[%1,#1008]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_str128_8\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    default: ret=0.0;break;
+   }
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** assembler implementation of bandwidth measurement using stp (2x128 bit) instruction
+ */
+static double asm_work_stp128(unsigned long long addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_stp128(unsigned long long addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+   switch (burst_length)
+   {
+    case 2:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_stp128_2\n\t"
+                ".align 6\n\t"
+                "_work_loop_stp128_2:\n\t"
+//stp 128
+		"stp q0,q1,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#32]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#96]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#160]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#224]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#288]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#352]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#416]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#480]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#544]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#608]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#672]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#736]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#800]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#864]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#928]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"stp q0,q1,[%1,#992]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_stp128_2\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 4:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_stp128_4\n\t"
+                ".align 6\n\t"
+                "_work_loop_stp128_4:\n\t"
+//stp 128
+		"stp q0,q1,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#32]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#96]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#160]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#224]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#288]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#352]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#416]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#480]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#544]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#608]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#672]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#736]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#800]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#864]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#928]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#992]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_stp128_4\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 8:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_stp128_8\n\t"
+                ".align 6\n\t"
+                "_work_loop_stp128_8:\n\t"
+//stp 128
+		"stp q0,q1,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#32]\n\t"NOP(NOPCOUNT)
+
+		"stp q4,q5,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%1,#96]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#160]\n\t"NOP(NOPCOUNT)
+
+		"stp q4,q5,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%1,#224]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#288]\n\t"NOP(NOPCOUNT)
+
+		"stp q4,q5,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%1,#352]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#416]\n\t"NOP(NOPCOUNT)
+
+		"stp q4,q5,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%1,#480]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#544]\n\t"NOP(NOPCOUNT)
+
+		"stp q4,q5,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%1,#608]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#672]\n\t"NOP(NOPCOUNT)
+
+		"stp q4,q5,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%1,#736]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#800]\n\t"NOP(NOPCOUNT)
+
+		"stp q4,q5,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%1,#864]\n\t"NOP(NOPCOUNT)
+
+		"stp q0,q1,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"stp q2,q3,[%1,#928]\n\t"NOP(NOPCOUNT)
+
+		"stp q4,q5,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"stp q6,q7,[%1,#992]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_stp128_8\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    default: ret=0.0;break;
+   }
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** assembler implementation of bandwidth measurement using st1 instruction with four registers
+ */
+static double asm_work_st1(unsigned long long addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_st1(unsigned long long addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+   switch (burst_length)
+   {
+    case 4:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_st1_4\n\t"
+                ".align 6\n\t"
+                "_work_loop_st1_4:\n\t"
+//st1 (4 registers)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_st1_4\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 8:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_st1_8\n\t"
+                ".align 6\n\t"
+                "_work_loop_st1_8:\n\t"
+//st1 (4 registers)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v0.4s,v1.4s,v2.4s,v3.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+		"st1 {v4.4s,v5.4s,v6.4s,v7.4s},[%1],#64\n\t"NOP(NOPCOUNT)
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_st1_8\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    default: ret=0.0;break;
+   }
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+
+/** assembler implementation of bandwidth measurement using stnp (2x128 bit, non-temporal hint) instruction
+ */
+static double asm_work_stnp(unsigned long long addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_stnp(unsigned long long addr, unsigned long long accesses, unsigned long long burst_length, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+   switch (burst_length)
+   {
+    case 2:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_stnp_2\n\t"
+                ".align 6\n\t"
+                "_work_loop_stnp_2:\n\t"
+//stnp 128
+		"stnp q0,q1,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#32]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#96]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#160]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#224]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#288]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#352]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#416]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#480]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#544]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#608]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#672]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#736]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#800]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#864]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#928]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"stnp q0,q1,[%1,#992]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_stnp_2\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 4:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_stnp_4\n\t"
+                ".align 6\n\t"
+                "_work_loop_stnp_4:\n\t"
+//stnp 128
+		"stnp q0,q1,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#32]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#96]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#160]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#224]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#288]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#352]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#416]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#480]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#544]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#608]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#672]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#736]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#800]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#864]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#928]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#992]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_stnp_4\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    case 8:
+      passes=accesses/64;
+      if (!passes) return 0;
+      /*
+       * Input:  %1: addr (pointer to the buffer)
+       *         %2: passes (number of loop iterations)
+       * Output: %0: stop timestamp - start timestamp
+       */
+      __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_stnp_8\n\t"
+                ".align 6\n\t"
+                "_work_loop_stnp_8:\n\t"
+//stnp 128
+		"stnp q0,q1,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#32]\n\t"NOP(NOPCOUNT)
+
+		"stnp q4,q5,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"stnp q6,q7,[%1,#96]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#160]\n\t"NOP(NOPCOUNT)
+
+		"stnp q4,q5,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"stnp q6,q7,[%1,#224]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#288]\n\t"NOP(NOPCOUNT)
+
+		"stnp q4,q5,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"stnp q6,q7,[%1,#352]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#416]\n\t"NOP(NOPCOUNT)
+
+		"stnp q4,q5,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"stnp q6,q7,[%1,#480]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#512]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#544]\n\t"NOP(NOPCOUNT)
+
+		"stnp q4,q5,[%1,#576]\n\t"NOP(NOPCOUNT)
+		"stnp q6,q7,[%1,#608]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#640]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#672]\n\t"NOP(NOPCOUNT)
+
+		"stnp q4,q5,[%1,#704]\n\t"NOP(NOPCOUNT)
+		"stnp q6,q7,[%1,#736]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#768]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#800]\n\t"NOP(NOPCOUNT)
+
+		"stnp q4,q5,[%1,#832]\n\t"NOP(NOPCOUNT)
+		"stnp q6,q7,[%1,#864]\n\t"NOP(NOPCOUNT)
+
+		"stnp q0,q1,[%1,#896]\n\t"NOP(NOPCOUNT)
+		"stnp q2,q3,[%1,#928]\n\t"NOP(NOPCOUNT)
+
+		"stnp q4,q5,[%1,#960]\n\t"NOP(NOPCOUNT)
+		"stnp q6,q7,[%1,#992]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#1024\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_stnp_8\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+      );
+      ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+      break;
+
+    default: ret=0.0;break;
+   }
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ */
+void  _work( unsigned long long memsize, int offset, int function, int burst_length, int runs, volatile mydata_t* data, double **results)
+{
+  int loop_overhead,i,j,t;
+  double tmax;
+  double tmp=(double)0;
+  double tmp_damage=(double)0;
+  unsigned long long tmp2,tmp3;
+  int dtsize,max_threads;
+  unsigned long long aligned_addr,accesses;
+  #ifdef USE_PAPI
+  int count;
+  #endif
+
+  aligned_addr=(unsigned long long)(data->buffer) + offset;
+
+  /* all store variants write 1024 Byte per loop iteration (64 accesses of 16 Byte) */
+  dtsize = 16;
+  accesses = memsize / dtsize;
+  if ((data->settings)&LOOP_OVERHEAD_COMP) loop_overhead=data->loop_overhead;
+  else loop_overhead=data->cpuinfo->rdtsc_latency;
+
+  if (accesses<512) runs*=5;
+  else if (accesses<1024) runs*=3;
+  else if (accesses<4096) runs*=2;
+  if (memsize>data->cpuinfo->Total_D_Cache_Size) runs/=3;
+  if (runs==0) runs=1;
+
+  max_threads=data->num_results;
+  for (t=0;t<max_threads;t++)
+  {
+   tmax=0;
+   if (data->damage.size) data->damage.results[t]=INVALID_MEASUREMENT;
+  
+   if(!t) aligned_addr=(unsigned long long)(data->buffer) + offset;
+   else aligned_addr=data->threaddata[t].aligned_addr;
+  
+   if (accesses) 
+   {
+    for (i=0;i<runs;i++)
+    {
+      use_mode_adaption(data,t,aligned_addr,memsize,accesses);
+
+      //bring co-resident working set into the caches of the measuring CPU
+      damage_use(&(data->damage),data->cache_flush_area,data->NUM_USES,data->cpuinfo);
+
+     /* call ASM implementation */
+    switch(function){
+       case 0://str128
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_str128((unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,burst_length,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_str128(aligned_addr,accesses,burst_length,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case 1://stp128
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_stp128((unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,burst_length,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_stp128(aligned_addr,accesses,burst_length,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case 2://st1
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_st1((unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,burst_length,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_st1(aligned_addr,accesses,burst_length,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case 3://stnp
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_stnp((unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,burst_length,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_stnp(aligned_addr,accesses,burst_length,loop_overhead,data->cpuinfo->clockrate,data);break;
+       default: break;
+     }
+      //check how much of the working set survived the measurement
+      if (data->damage.size) tmp_damage=damage_reread(&(data->damage),loop_overhead,data->cpuinfo->clockrate);
+      if ((int)tmp!=-1){
+       if (tmp>tmax)
+       {
+         tmax=tmp;
+         if (data->damage.size) data->damage.results[t]=tmp_damage;
+         #ifdef USE_PAPI
+         switch (burst_length)
+         {
+           case 1: count = 1024 / dtsize; break;
+           case 2: count = 1024 / dtsize; break;
+           case 3: count = 1056 / dtsize; break;
+           case 4: count = 1024 / dtsize; break;
+           case 8: count = 1024 / dtsize; break;
+         }
+
+         for (i=0;i<data->num_events;i++)
+         {
+            data->papi_results[i*max_threads+t]=(double)data->values[i]/(double)((accesses/count)*count);
+         }
+         #endif
+       }
+     }
+    }
+   }
+   else tmax=0;
+  
+   if (tmax) (*results)[t]=tmax;
+   else (*results)[t]=INVALID_MEASUREMENT;
+  }
+}
+
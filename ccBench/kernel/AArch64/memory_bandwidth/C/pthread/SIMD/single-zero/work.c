@@ -0,0 +1,418 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures bandwidth of zeroing data located in different cache levels or memory of certain CPUs (dc zva, stp xzr, memset).
+ ******************************************************************************************************/
+ 
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+#ifdef USE_PAPI
+#include <papi.h>
+#endif
+
+
+/* accesses of the code prefetch runs of the measurement routines, enough for one loop iteration (64 accesses, dc zva needs at least zva_block_size) */
+#define CODE_PREFETCH_ACCESSES 64
+
+/* accesses of the measuring CPU and the helper threads in USE MODE ADAPTION and thread() */
+#define LOCAL_USE_MEMORY(data,addr,memsize,mode) use_memory((void*)(addr),data->cache_flush_area,memsize,mode,data->USE_DIRECTION,data->NUM_USES,*(data->cpuinfo))
+#define HELPER_USE_MEMORY(global_data,mydata) use_memory((void*)mydata->aligned_addr,mydata->cache_flush_area,mydata->memsize,mydata->USE_MODE,mydata->USE_DIRECTION,mydata->NUM_USES,*(mydata->cpuinfo))
+#include "membench_thread.h"
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,c,d,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: RAX: stop timestamp 
+         *         RBX: start timestamp
+         */
+        __asm__ __volatile__(
+               //"mov $1,%%rcx;"
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+//                "jmp _work_loop_overhead;"
+//                ".align 64,0x0;"
+//                "_work_loop_overhead:"
+//                "sub $1,%%rcx;"
+//                "jnz _work_loop_overhead;"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+	if ((a-b)<ret) ret=(a-b);
+   }			
+  return (int)ret;
+}
+
+/** determines the block size of the dc zva instruction (DCZID_EL0)
+ *  returns 0 if dc zva is prohibited
+ */
+unsigned int zva_block_size(void)
+{
+   unsigned long long dczid;
+
+   __asm__ __volatile__("mrs %0,dczid_el0\n\t" : "=r" (dczid));
+   if (dczid&0x10) return 0;
+   return 4<<(dczid&0xf);
+}
+
+/** assembler implementation of bandwidth measurement using dc zva instruction
+ *  - each instruction zeroes one block of data->zva_block_size Byte without reading it first
+ */
+static double asm_work_zva(unsigned long long addr, unsigned long long accesses, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_zva(unsigned long long addr, unsigned long long accesses, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes,block_size;
+   double ret;
+
+   block_size=data->zva_block_size;
+   if (!block_size) return 0;
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+   passes=(accesses*16)/(16*block_size);
+   if (!passes) return 0;
+   /*
+    * Input:  %1: addr (pointer to the buffer)
+    *         %2: passes (number of loop iterations)
+    *         %3: block_size (Byte zeroed per instruction)
+    * Output: %0: stop timestamp - start timestamp
+    */
+   __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_zva\n\t"
+                ".align 6\n\t"
+                "_work_loop_zva:\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+		"dc zva,%1\n\t"NOP(NOPCOUNT)
+		"add %1,%1,%3\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_zva\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes), "r" (block_size)
+                : "cc", "memory"
+   );
+   ret=(((double)(passes*16*block_size))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** assembler implementation of bandwidth measurement using stp xzr,xzr instruction
+ *  - regular stores of the zero register, 16 Byte per instruction
+ */
+static double asm_work_stpxzr(unsigned long long addr, unsigned long long accesses, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double asm_work_stpxzr(unsigned long long addr, unsigned long long accesses, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long passes;
+   double ret;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+   passes=accesses/64;
+   if (!passes) return 0;
+   /*
+    * Input:  %1: addr (pointer to the buffer)
+    *         %2: passes (number of loop iterations)
+    * Output: %0: stop timestamp - start timestamp
+    */
+   __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_stpxzr\n\t"
+                ".align 6\n\t"
+                "_work_loop_stpxzr:\n\t"
+		"stp xzr,xzr,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#48]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#112]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#176]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#240]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#304]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#368]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#432]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#496]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#512\n\t"
+
+		"stp xzr,xzr,[%1,#0]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#16]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#32]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#48]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#64]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#80]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#96]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#112]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#128]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#144]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#160]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#176]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#192]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#208]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#224]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#240]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#256]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#272]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#288]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#304]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#320]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#336]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#352]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#368]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#384]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#400]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#416]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#432]\n\t"NOP(NOPCOUNT)
+
+		"stp xzr,xzr,[%1,#448]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#464]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#480]\n\t"NOP(NOPCOUNT)
+		"stp xzr,xzr,[%1,#496]\n\t"NOP(NOPCOUNT)
+
+		"add %1,%1,#512\n\t"
+
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_stpxzr\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+   );
+   ret=(((double)(passes*64*16))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** bandwidth measurement of the C library memset() (reference for dc zva and stp xzr)
+ */
+static double work_memset(unsigned long long addr, unsigned long long accesses, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline));
+static double work_memset(unsigned long long addr, unsigned long long accesses, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data)
+{
+   unsigned long long bytes,start,end;
+   double ret;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+   bytes=(accesses/64)*64*16;
+   if (!bytes) return 0;
+
+   __asm__ __volatile__(
+                TIMESTAMP
+                SERIALIZE
+                : "=r" (start) : : "memory"
+   );
+   memset((void*)addr,0,bytes);
+   __asm__ __volatile__(
+                SERIALIZE
+                TIMESTAMP
+                : "=r" (end) : : "memory"
+   );
+   ret=(((double)bytes)/((double)(((end-start)-call_latency))/(((double)freq)*0.000000001)));
+
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return ret;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ */
+void  _work( unsigned long long memsize, int offset, int function, int runs, volatile mydata_t* data, double **results)
+{
+  int loop_overhead,i,j,t;
+  double tmax;
+  double tmp=(double)0;
+  double tmp_damage=(double)0;
+  unsigned long long tmp2,tmp3;
+  int dtsize,max_threads;
+  unsigned long long aligned_addr,accesses;
+  #ifdef USE_PAPI
+  int count;
+  #endif
+
+  aligned_addr=(unsigned long long)(data->buffer) + offset;
+
+  /* all variants zero whole 1024 Byte blocks (64 accesses of 16 Byte) */
+  dtsize = 16;
+  accesses = memsize / dtsize;
+  if ((data->settings)&LOOP_OVERHEAD_COMP) loop_overhead=data->loop_overhead;
+  else loop_overhead=data->cpuinfo->rdtsc_latency;
+
+  if (accesses<512) runs*=5;
+  else if (accesses<1024) runs*=3;
+  else if (accesses<4096) runs*=2;
+  if (memsize>data->cpuinfo->Total_D_Cache_Size) runs/=3;
+  if (runs==0) runs=1;
+
+  max_threads=data->num_results;
+  for (t=0;t<max_threads;t++)
+  {
+   tmax=0;
+   if (data->damage.size) data->damage.results[t]=INVALID_MEASUREMENT;
+  
+   if(!t) aligned_addr=(unsigned long long)(data->buffer) + offset;
+   else aligned_addr=data->threaddata[t].aligned_addr;
+  
+   if (accesses) 
+   {
+    for (i=0;i<runs;i++)
+    {
+      use_mode_adaption(data,t,aligned_addr,memsize,accesses);
+
+      //bring co-resident working set into the caches of the measuring CPU
+      damage_use(&(data->damage),data->cache_flush_area,data->NUM_USES,data->cpuinfo);
+
+     /* call ASM implementation */
+    switch(function){
+       case 0://dc zva
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_zva((unsigned long long)(data->cache_flush_area),(data->zva_block_size>CODE_PREFETCH_ACCESSES)?data->zva_block_size:CODE_PREFETCH_ACCESSES,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_zva(aligned_addr,accesses,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case 1://stp xzr
+         //prefetch measurement routine
+         if (data->ENABLE_CODE_PREFETCH)
+           for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_stpxzr((unsigned long long)(data->cache_flush_area),CODE_PREFETCH_ACCESSES,loop_overhead,data->cpuinfo->clockrate,data);}
+         //measurement
+         tmp=asm_work_stpxzr(aligned_addr,accesses,loop_overhead,data->cpuinfo->clockrate,data);break;
+       case 2://memset
+         tmp=work_memset(aligned_addr,accesses,loop_overhead,data->cpuinfo->clockrate,data);break;
+       default: break;
+     }
+      //check how much of the working set survived the measurement
+      if (data->damage.size) tmp_damage=damage_reread(&(data->damage),loop_overhead,data->cpuinfo->clockrate);
+      if ((int)tmp!=-1){
+       if (tmp>tmax)
+       {
+         tmax=tmp;
+         if (data->damage.size) data->damage.results[t]=tmp_damage;
+         #ifdef USE_PAPI
+         count = 1024 / dtsize;
+
+         for (i=0;i<data->num_events;i++)
+         {
+            data->papi_results[i*max_threads+t]=(double)data->values[i]/(double)((accesses/count)*count);
+         }
+         #endif
+       }
+     }
+    }
+   }
+   else tmax=0;
+  
+   if (tmax) (*results)[t]=tmax;
+   else (*results)[t]=INVALID_MEASUREMENT;
+  }
+}
+
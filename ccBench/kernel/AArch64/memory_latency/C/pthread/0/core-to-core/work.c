@@ -0,0 +1,376 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures cache line transfer latency between all pairs of selected CPUs (ping-pong).
+ ******************************************************************************************************/
+
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+/* report average latency instead of minimum */
+//#define AVERAGE
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: %0: stop timestamp
+         *         %1: start timestamp
+         */
+          __asm__ __volatile__(
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+        if ((a-b)<ret) ret=(a-b);
+   }
+  return (int)ret;
+}
+
+/*
+ * ping-pong protocol (identical for all variants):
+ *   - the flag is 0 at the beginning of the measurement
+ *   - the initiating CPU (ping) is called with value=0, the other CPU (pong) with value=1
+ *   - in each iteration a CPU waits until the flag equals value, writes value+1, and increments value by 2
+ *   - thus each iteration of the initiating CPU covers two cache line transfers (round trip)
+ * all functions return the number of cycles needed for all iterations
+ */
+
+/** plain loads and stores
+ */
+static unsigned long long asm_pingpong_ldr_str(unsigned long long flag, unsigned long long value, unsigned long long iterations) __attribute__((noinline));
+static unsigned long long asm_pingpong_ldr_str(unsigned long long flag, unsigned long long value, unsigned long long iterations)
+{
+   unsigned long long a,b;
+
+   if (!iterations) return 0;
+     /*
+      * Input:  %4: flag (pointer to the flag)
+      * Output: %0: stop timestamp - start timestamp
+      *         %1: temp
+      */
+     __asm__ __volatile__(
+                TIMESTAMP
+                SERIALIZE
+                ".align 6\n\t"
+                "_work_loop_ldr_str:\n\t"
+                "ldr %1,[%4]\n\t"
+                "cmp %1,%2\n\t"
+                "bne _work_loop_ldr_str\n\t"
+                "add %2,%2,#1\n\t"
+                "str %2,[%4]\n\t"
+                "add %2,%2,#1\n\t"
+                "subs %3,%3,#1\n\t"
+                "bne _work_loop_ldr_str\n\t"
+
+                SERIALIZE
+                "mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		: "=&r"(a),"=&r"(b),"+r"(value),"+r"(iterations)
+                : "r"(flag)
+                : "cc","memory"
+     );
+    return a;
+}
+
+/** load-acquire and store-release
+ */
+static unsigned long long asm_pingpong_ldar_stlr(unsigned long long flag, unsigned long long value, unsigned long long iterations) __attribute__((noinline));
+static unsigned long long asm_pingpong_ldar_stlr(unsigned long long flag, unsigned long long value, unsigned long long iterations)
+{
+   unsigned long long a,b;
+
+   if (!iterations) return 0;
+     /*
+      * Input:  %4: flag (pointer to the flag)
+      * Output: %0: stop timestamp - start timestamp
+      *         %1: temp
+      */
+     __asm__ __volatile__(
+                TIMESTAMP
+                SERIALIZE
+                ".align 6\n\t"
+                "_work_loop_ldar_stlr:\n\t"
+                "ldar %1,[%4]\n\t"
+                "cmp %1,%2\n\t"
+                "bne _work_loop_ldar_stlr\n\t"
+                "add %2,%2,#1\n\t"
+                "stlr %2,[%4]\n\t"
+                "add %2,%2,#1\n\t"
+                "subs %3,%3,#1\n\t"
+                "bne _work_loop_ldar_stlr\n\t"
+
+                SERIALIZE
+                "mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		: "=&r"(a),"=&r"(b),"+r"(value),"+r"(iterations)
+                : "r"(flag)
+                : "cc","memory"
+     );
+    return a;
+}
+
+/** LSE compare and swap, the waiting CPU repeatedly tries to replace value by value+1
+ *  (each failed attempt also requests the cache line)
+ */
+static unsigned long long asm_pingpong_cas(unsigned long long flag, unsigned long long value, unsigned long long iterations) __attribute__((noinline));
+static unsigned long long asm_pingpong_cas(unsigned long long flag, unsigned long long value, unsigned long long iterations)
+{
+   unsigned long long a,b,c;
+
+   if (!iterations) return 0;
+     /*
+      * Input:  %5: flag (pointer to the flag)
+      * Output: %0: stop timestamp - start timestamp
+      *         %1: temp (compare value / old value)
+      *         %4: temp (new value)
+      */
+     __asm__ __volatile__(
+                LSE_ARCH
+                TIMESTAMP
+                SERIALIZE
+                ".align 6\n\t"
+                "_work_loop_cas:\n\t"
+                "add %4,%2,#1\n\t"
+                "_work_loop_cas_retry:\n\t"
+                "mov %1,%2\n\t"
+                "casal %1,%4,[%5]\n\t"
+                "cmp %1,%2\n\t"
+                "bne _work_loop_cas_retry\n\t"
+                "add %2,%2,#2\n\t"
+                "subs %3,%3,#1\n\t"
+                "bne _work_loop_cas\n\t"
+
+                SERIALIZE
+                "mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		: "=&r"(a),"=&r"(b),"+r"(value),"+r"(iterations),"=&r"(c)
+                : "r"(flag)
+                : "cc","memory"
+     );
+    return a;
+}
+
+/** plain load to wait for the flag, LSE swap to pass it on
+ */
+static unsigned long long asm_pingpong_swp(unsigned long long flag, unsigned long long value, unsigned long long iterations) __attribute__((noinline));
+static unsigned long long asm_pingpong_swp(unsigned long long flag, unsigned long long value, unsigned long long iterations)
+{
+   unsigned long long a,b,c;
+
+   if (!iterations) return 0;
+     /*
+      * Input:  %5: flag (pointer to the flag)
+      * Output: %0: stop timestamp - start timestamp
+      *         %1: temp (flag / old value)
+      *         %4: temp (new value)
+      */
+     __asm__ __volatile__(
+                LSE_ARCH
+                TIMESTAMP
+                SERIALIZE
+                ".align 6\n\t"
+                "_work_loop_swp:\n\t"
+                "ldr %1,[%5]\n\t"
+                "cmp %1,%2\n\t"
+                "bne _work_loop_swp\n\t"
+                "add %4,%2,#1\n\t"
+                "swpal %4,%1,[%5]\n\t"
+                "add %2,%2,#2\n\t"
+                "subs %3,%3,#1\n\t"
+                "bne _work_loop_swp\n\t"
+
+                SERIALIZE
+                "mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		: "=&r"(a),"=&r"(b),"+r"(value),"+r"(iterations),"=&r"(c)
+                : "r"(flag)
+                : "cc","memory"
+     );
+    return a;
+}
+
+/** ping-pong with the selected variant
+ *  value: 0 for the initiating CPU, 1 for the other CPU
+ */
+static unsigned long long pingpong(int function, unsigned long long flag, unsigned long long value, unsigned long long iterations)
+{
+   switch(function){
+     case FUNC_LDR_STR:   return asm_pingpong_ldr_str(flag,value,iterations);
+     case FUNC_LDAR_STLR: return asm_pingpong_ldar_stlr(flag,value,iterations);
+     case FUNC_CAS:       return asm_pingpong_cas(flag,value,iterations);
+     case FUNC_SWP:       return asm_pingpong_swp(flag,value,iterations);
+     default: return 0;
+   }
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - measures round trip latency between CPU row (initiator) and all other selected CPUs
+ *   - the flag is located in memory of the initiating CPU
+ *   - (*results)[t]: round trip latency in cycles between thread row and thread t
+ */
+void _work(int row, int function, unsigned long long iterations, int runs, volatile mydata_t* data, double **results)
+{
+  int i,t;
+  unsigned long long tmp,flag;
+  double tmin;
+
+  /* use rdtsc latency parameter for loop overhead compensation */
+  if ((data->settings)&LOOP_OVERHEAD_COMP) data->cpuinfo->rdtsc_latency=data->loop_overhead;
+
+  if (row) flag=(unsigned long long)(data->threaddata[row].flag_area);
+  else flag=(unsigned long long)(data->flag_area);
+
+  for (t=0;t<data->num_results;t++)
+  {
+   if (t==row) {(*results)[t]=INVALID_MEASUREMENT;continue;}
+
+   #ifdef AVERAGE
+    tmin=0;
+   #else
+    tmin=(double)ULLONG_MAX;
+   #endif
+
+   for (i=0;i<runs;i++)
+   {
+     *((volatile unsigned long long*)flag)=0;
+     asm volatile ("dmb sy\n\t" : : : "memory");
+
+     /* the responding CPU starts first and waits for the flag, the initiating CPU starts only after the responding
+      * thread is running (the wake-up of a blocked thread is not part of the measurement) */
+     if (t){
+       data->threaddata[t].flag_addr=flag;
+       data->threaddata[t].ready=0;
+       asm volatile ("dmb sy\n\t" : : : "memory");
+       mailbox_post(&(data->mailbox[t]),THREAD_PONG);
+       while (!data->threaddata[t].ready);
+     }
+     if (row){
+       data->threaddata[row].flag_addr=flag;
+       asm volatile ("dmb sy\n\t" : : : "memory");
+       mailbox_post(&(data->mailbox[row]),THREAD_PING);
+     }
+
+     /* master thread takes part in the measurement if it runs on one of the two CPUs */
+     if (!row) tmp=pingpong(function,flag,0,iterations);
+     else if (!t) pingpong(function,flag,1,iterations);
+
+     if (t) mailbox_wait(&(data->mailbox[t]));
+     if (row){
+       mailbox_wait(&(data->mailbox[row]));
+       tmp=data->threaddata[row].cycles;
+     }
+
+     /* round trip latency in cycles */
+     tmp-=data->cpuinfo->rdtsc_latency;
+
+     // discard first iteration if more than 1 runs are performed
+     if ((i>0)||(runs==1))
+     {
+      #ifdef AVERAGE
+        tmin+=(double)tmp/(double)iterations;
+      #else
+        if ((double)tmp/(double)iterations<tmin) tmin=(double)tmp/(double)iterations;
+      #endif
+     }
+   }
+   #ifdef AVERAGE
+   if (runs>1) tmin/=(runs-1);
+   #endif
+
+   if (tmin>0) (*results)[t]=tmin;
+   else (*results)[t]=INVALID_MEASUREMENT;
+  }
+}
+
+
+/** loop for additional worker threads
+ *  communicating with master thread using the mailbox protocol (see membench.h)
+ */
+void *thread(void *threaddata)
+{
+  int id= ((threaddata_t *) threaddata)->thread_id;
+  unsigned int numa_node;
+  struct bitmask *numa_bitmask;
+  volatile mydata_t* global_data = ((threaddata_t *) threaddata)->data; //communication
+  threaddata_t* mydata = (threaddata_t*)threaddata;
+
+  mailbox_t *mailbox = &(global_data->mailbox[id]);
+  unsigned int seq=0;
+
+  //wait for THREAD_INIT, allocation is done by all threads in parallel, master waits for completion later on
+  while (mailbox_receive(mailbox,&seq)!=THREAD_INIT) mailbox_idle(mailbox,seq);
+
+  /* flag is located in memory of the NUMA node selected by BENCHIT_KERNEL_ALLOC */
+  cpu_set(((threaddata_t *) threaddata)->mem_bind);
+  numa_node = numa_node_of_cpu(((threaddata_t *) threaddata)->mem_bind);
+  numa_bitmask = numa_bitmask_alloc((unsigned int) numa_max_possible_node());
+  numa_bitmask = numa_bitmask_clearall(numa_bitmask);
+  numa_bitmask = numa_bitmask_setbit(numa_bitmask, numa_node);
+  numa_set_membind(numa_bitmask);
+  numa_bitmask_free(numa_bitmask);
+
+  mydata->flag_area = (char*) _mm_malloc(FLAG_AREA,FLAG_AREA);
+  if (mydata->flag_area == NULL)
+  {
+    fprintf( stderr, "Error: Allocation of flag failed\n" ); fflush( stderr );
+    exit( 127 );
+  }
+  memset(mydata->flag_area,0,FLAG_AREA);
+  mailbox_complete(mailbox,seq);
+
+  cpu_set(((threaddata_t *) threaddata)->cpu_id);
+  while(1)
+  {
+     switch (mailbox_receive(mailbox,&seq)){
+       case THREAD_PING:
+         mydata->cycles=pingpong(global_data->function,mydata->flag_addr,0,global_data->iterations);
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_PONG:
+         mydata->ready=1;
+         pingpong(global_data->function,mydata->flag_addr,1,global_data->iterations);
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_WAIT: // no new command
+         mailbox_idle(mailbox,seq);
+         break;
+       case THREAD_STOP: // exit
+       default:
+         if (mydata->flag_area!=NULL) _mm_free(mydata->flag_area);
+         mailbox_complete(mailbox,seq);
+         pthread_exit(NULL);
+    }
+  }
+}
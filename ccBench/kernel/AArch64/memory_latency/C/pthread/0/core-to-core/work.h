@@ -0,0 +1,88 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures cache line transfer latency between all pairs of selected CPUs (ping-pong).
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "core-to-core cache line transfer latency"
+#define CODE_SEQUENCE       "wait for flag, write flag (ping-pong)"
+#define X_AXIS_TEXT         "initiating CPU"
+#define Y_AXIS_TEXT_1       "round trip latency [ns]"
+#define Y_AXIS_TEXT_2       "round trip latency [cycles]"
+#define Y_AXIS_TEXT_3       "one-way latency [ns]"
+
+/* kernel specific thread functions, see membench.h for the common ones */
+#define THREAD_PING            THREAD_KERNEL
+#define THREAD_PONG            (THREAD_KERNEL+1)
+
+/* variants of flag passing (BENCHIT_KERNEL_INSTRUCTION) */
+#define FUNC_LDR_STR   0
+#define FUNC_LDAR_STLR 1
+#define FUNC_CAS       2
+#define FUNC_SWP       3
+
+/* size of the memory area that contains the flag (one cache line, padded to avoid adjacent line prefetches) */
+#define FLAG_AREA      256
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* flag_area;
+   pthread_t *threads;
+   struct threaddata *threaddata;
+   cpu_info_t *cpuinfo;                                 //32
+   unsigned long long iterations;                       //+8
+   unsigned int settings;
+   unsigned int loop_overhead;
+   unsigned short num_threads;
+   unsigned short num_results;                          //+12
+   unsigned char function;
+   unsigned char runs;                                  //+2
+   unsigned char padding1[74];                          //+74 = 128
+   unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
+   unsigned char padding2[56];                          //   8+56 = 64
+   unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
+} mydata_t;
+
+/* data needed by each thread */
+typedef struct threaddata
+{
+   volatile mydata_t *data;
+   char* flag_area;
+   cpu_info_t *cpuinfo;                                 //24
+   volatile unsigned long long flag_addr;               //+8, flag used for the current measurement
+   volatile unsigned long long cycles;                  //+8, result of ping
+   unsigned int thread_id;
+   unsigned int cpu_id;
+   unsigned int mem_bind;                               //+12
+   volatile unsigned char ready;                        //+1, pong is waiting for the flag
+   unsigned char padding1[75];                          //+75 = 128
+   unsigned long long end_dummy_cachelines[16];         //avoid prefetching following data
+} threaddata_t;
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n);
+
+
+/* function that performs the measurement of one row of the matrix (initiating CPU: row) */
+void _work(int row, int function, unsigned long long iterations, int runs,volatile mydata_t* data, double **results);
+
+/* loop executed by all threads, except the master thread */
+void *thread(void *threaddata);
+
+#endif
@@ -0,0 +1,577 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures read latency while other CPUs generate background memory traffic at selectable injection rates.
+ ******************************************************************************************************/
+ 
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+#ifdef USE_PAPI
+#include <papi.h>
+#endif
+
+/* report average latency instead of minimum */
+//#define AVERAGE
+
+/* add data dependencies in kernel versions with arithmetic operations between the loads */
+//#define DEPENDENT
+
+int iteration,accesses,alignment;
+
+static void reset_tlb_check(volatile mydata_t* data){
+  int i,j;
+  
+  if (data->tlb_sets) for (i=0;i<data->tlb_size/data->tlb_sets;i++){
+    data->tlb_collision_check_array[i]=0;
+    for (j=0;j<data->tlb_sets;j++) data->tlb_tags[j*(data->tlb_size/data->tlb_sets)+i]=(unsigned long long)0;
+  }
+}
+
+//checks if page-addresses fit into the n-way associative TLB
+static int tlb_check(unsigned long long addr,volatile mydata_t* data){
+  int i,indizes,index_mask,index,tmp;
+
+  if ((data->tlb_size==0)||(data->tlb_sets==0)) return 0;
+ 
+  indizes = data->tlb_size/data->tlb_sets;
+  index_mask=indizes-1;
+  tmp=addr/data->pagesize;
+  index=tmp&index_mask;
+  /* check if addr is within a already selected page */
+  for (i=0;i<data->tlb_collision_check_array[index];i++){
+    if (tmp==data->tlb_tags[i*(data->tlb_size/data->tlb_sets)+index]) return 0;
+  }
+  /* check if another page fits into TLB */
+  if (data->tlb_collision_check_array[index]<data->tlb_sets){
+    data->tlb_tags[data->tlb_collision_check_array[index]*(data->tlb_size/data->tlb_sets)+index]=tmp;
+    data->tlb_collision_check_array[index]++;
+    return 0;
+  }
+  
+  //printf("TLB_COLLISION\n");
+  return -1;
+  
+}
+static int already_selected(unsigned long long addr, unsigned long long *addresses, int max){
+   int i;
+   for (i=0;i<max;i++){
+      if (addr==addresses[i]) return -1;
+   }
+   return 0;
+}
+
+/*
+ * generates new random pointer chains in the buffer for MODE_EXCLUSIVE, MODE_MODIFIED, and MODE_INVALID
+ * and brings the buffer into the requested coherency state afterwards (see use_memory() in membench.c)
+ */
+static inline int use_memory_chains(void* buffer,void* flush_buffer,unsigned long long memsize,int mode,int direction,int repeat,cpu_info_t cpuinfo,volatile mydata_t *data, threaddata_t *threaddata)
+{
+   int i,j,tmp=0xd08a721b;
+   unsigned long long stride = 64;
+
+   /* additional variables for generation of unique random pattern during use_memory() prior to each call of asm_work() function */
+   unsigned long long tmp_addr,tmp_offset,mask,max_accesses;
+   unsigned long long usable_memory,num_pages,accesses_per_page,usable_page_size;
+   struct timeval time;
+   unsigned long long aligned_addr;	   
+
+   aligned_addr=(unsigned long long)buffer;
+
+   /* MODE_EXCLUSIVE and MODE_MODIFIED generate a new random sequence in each call. This does not conflict with the 
+      coherence state generation, as those three invalidate all other caches anyway
+      MODE_SHARED, MODE_FORWARD, MODE_RDONLY, and MODE_OWNED are read-only operations that generate the wanted coherence states in different caches 
+      in combination with MODE_EXCLUSIVE or MODE_MODIFIED accesses by other cores. They therefore must not modify the buffer as this would
+      evict copies of other cores.
+   */
+   if ((mode==MODE_EXCLUSIVE)||(mode==MODE_MODIFIED)||(mode==MODE_INVALID)){
+     /* clear the memory */
+     memset(buffer,0,memsize);
+     mask=(data->pagesize-1)^0xffffffffffffffffULL;
+     usable_memory=(memsize&mask);
+     if (usable_memory==0) usable_memory=memsize;
+     usable_page_size=data->pagesize;
+
+      if ((data->settings&RESTORE_TLB)&&(data->hugepages==HUGEPAGES_OFF))
+      {
+        usable_memory=usable_memory/2;
+        usable_page_size=(data->pagesize)/2;
+        if (usable_memory>data->tlb_size*(data->pagesize/2)) usable_memory=data->tlb_size*(data->pagesize/2);
+        reset_tlb_check(data);
+      }
+
+      max_accesses=(usable_memory/alignment);
+      if (max_accesses<accesses) accesses=max_accesses;
+      if (usable_memory>=usable_page_size) num_pages=usable_memory/usable_page_size;
+      else num_pages=1;
+      accesses=(accesses/24)*24;
+      if (accesses<=num_pages) {num_pages=accesses;usable_memory=num_pages*usable_page_size;/*alignment=usable_page_size;*/}
+
+      gettimeofday( &time, (struct timezone *) 0);
+      if(usable_memory>=usable_page_size)
+      _random_init(time.tv_sec*time.tv_usec+pthread_self()*iteration*iteration,memsize/data->pagesize-1);
+      /* randomly select pages (4KB) - repetition free sequence returned by _random() 
+       * the first page is implicitely selected, as the asm_work() function is called with a pointer to the beginning of the buffer
+       */
+      data->page_address[0]=aligned_addr;tlb_check(aligned_addr,data); 
+      for (j=1;j<num_pages;j++)
+      {
+        /* select pages that fit into selected TLB level (BENCHIT_KERNEL_TLB_MODE) */
+        do{
+          data->page_address[j]=(((unsigned long long)_random()+1)*data->pagesize);
+        } while (tlb_check(aligned_addr+data->page_address[j],data));
+
+        if (threaddata!=NULL) threaddata->page_address[j]=data->page_address[j];
+        data->page_address[j]+=aligned_addr;
+        if (threaddata!=NULL) threaddata->page_address[j]+=threaddata->aligned_addr;
+      }  
+  
+      /* select random addresses within the choosen pages - repetition free sequence returned by _random() */
+      gettimeofday( &time, (struct timezone *) 0);
+      _random_init(time.tv_sec*time.tv_usec+pthread_self()*iteration*iteration,usable_memory/alignment-1);
+      tmp_addr=aligned_addr; 
+      for(j=0;j<accesses;j++)
+      {
+        tmp_offset=(((unsigned long long)_random())*alignment)+alignment;
+        //*((unsigned long long*)(tmp_addr))=data->page_address[tmp_offset/usable_page_size]+(tmp_offset%usable_page_size);
+        //changed to non-temporal store to prevent caching of the selected addresses
+         __asm__ __volatile__(
+             "str %1, [%0]\n\t"
+       :: "r" (tmp_addr), "r" (data->page_address[tmp_offset/usable_page_size]+(tmp_offset%usable_page_size)));
+	tmp_addr=data->page_address[tmp_offset/usable_page_size]+(tmp_offset%usable_page_size);
+      }
+   }
+   if ((data->extra_clflush)&&((mode==MODE_EXCLUSIVE)||(mode==MODE_MODIFIED)||(mode==MODE_INVALID))) {
+      /* remove data from cache before data placement to avoid reuse of data between runs */
+      clflush(buffer,memsize,cpuinfo);
+   }
+
+   return use_memory(buffer,flush_buffer,memsize,mode,direction,repeat,cpuinfo);
+}
+
+/* accesses of the measuring CPU and the helper threads in USE MODE ADAPTION and thread() */
+#define LOCAL_USE_MEMORY(data,addr,memsize,mode) use_memory_chains((void*)(addr),data->cache_flush_area,memsize,mode,FIFO,data->NUM_USES,*(data->cpuinfo),data,NULL)
+#define HELPER_USE_MEMORY(global_data,mydata) use_memory_chains((void*)mydata->aligned_addr,mydata->cache_flush_area,mydata->memsize,mydata->USE_MODE,FIFO,mydata->NUM_USES,*(mydata->cpuinfo),global_data,mydata)
+/* background traffic of the helper threads, defined after the assembler routines */
+static void stream(threaddata_t *mydata);
+#define HELPER_COMMAND(global_data,mydata,cmd) if (cmd==THREAD_STREAM) stream(mydata)
+#include "membench_thread.h"
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,c,d,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: RAX: stop timestamp 
+         *         RBX: start timestamp
+         */
+          __asm__ __volatile__(
+               //"mov $1,%%rcx;"
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+//                "jmp _work_loop_overhead;"
+//                ".align 64,0x0;"
+//                "_work_loop_overhead:"
+//                "sub $1,%%rcx;"
+//                "jnz _work_loop_overhead;"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+        if ((a-b)<ret) ret=(a-b);
+   }			
+  return (int)ret;
+}
+
+/** assembler implementation of latency measurement using mov instruction
+ */
+static int asm_work_ldr(unsigned long long addr, unsigned long long passes,volatile mydata_t *data) __attribute__((noinline));
+static int asm_work_ldr(unsigned long long addr, unsigned long long passes,volatile mydata_t *data)
+{
+   unsigned long long a,b;
+   int i;
+
+   if (!passes) return 0;
+
+   #ifdef USE_PAPI
+    if (data->num_events) PAPI_reset(data->Eventset);
+   #endif
+     /*
+      * Input:  RBX: addr (pointer to the buffer)
+      *         RCX: passes (number of loop iterations)
+      * Output: RAX: stop timestamp
+      *         RBX: start timestamp
+      */
+     __asm__ __volatile__(
+                TIMESTAMP
+                SERIALIZE
+/* standard version */
+        //        "b _work_loop_mov_1\n\t"
+                ".align 6\n\t"
+                //loop that performs random memory accesses (memory contains precalculated random target addresses)
+                "_work_loop_mov_1:\n\t"
+
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+                "ldr %2,[%2]\n\t"NOP(NOPCOUNT)
+
+                "subs %3,%3,#1\n\t"
+                "bne _work_loop_mov_1\n\t"
+
+                SERIALIZE
+                "mov %1,%0\n\t"
+                TIMESTAMP
+		: "=&r"(a),"=&r"(b)
+                : "r"(addr), "r" (passes)
+     );
+  #ifdef USE_PAPI
+    if (data->num_events) PAPI_read(data->Eventset,data->values);
+  #endif
+    return (unsigned int) ((a-b)-data->cpuinfo->rdtsc_latency)/(passes*24);
+}
+/** read timestamp counter of the calling CPU
+ */
+static inline unsigned long long timestamp(void)
+{
+   unsigned long long ts;
+
+   __asm__ __volatile__(
+                TIMESTAMP
+		: "=r"(ts)
+   );
+   return ts;
+}
+
+/** assembler implementation of the background traffic (same loop as ldr128 in single-reader)
+ *  reads STREAM_BLOCK_SIZE Bytes starting at addr, no time measurement
+ */
+static void asm_stream_ldr128(unsigned long long addr) __attribute__((noinline));
+static void asm_stream_ldr128(unsigned long long addr)
+{
+   unsigned long long passes=STREAM_BLOCK_SIZE/256;
+
+   __asm__ __volatile__(
+                "b _stream_loop_ldr128\n\t"
+                ".align 6\n\t"
+                "_stream_loop_ldr128:\n\t"
+
+		"ldr q0,[%0,#0]\n\t"
+		"ldr q1,[%0,#16]\n\t"
+		"ldr q2,[%0,#32]\n\t"
+		"ldr q3,[%0,#48]\n\t"
+
+		"ldr q4,[%0,#64]\n\t"
+		"ldr q5,[%0,#80]\n\t"
+		"ldr q6,[%0,#96]\n\t"
+		"ldr q7,[%0,#112]\n\t"
+
+		"ldr q0,[%0,#128]\n\t"
+		"ldr q1,[%0,#144]\n\t"
+		"ldr q2,[%0,#160]\n\t"
+		"ldr q3,[%0,#176]\n\t"
+
+		"ldr q4,[%0,#192]\n\t"
+		"ldr q5,[%0,#208]\n\t"
+		"ldr q6,[%0,#224]\n\t"
+		"ldr q7,[%0,#240]\n\t"
+
+		"add %0,%0,#256\n\t"
+
+		"subs %1,%1,#1\n\t"
+                "bne _stream_loop_ldr128\n\t"
+                : "+r"(addr), "+r" (passes)
+                :
+                : "cc","memory","v0","v1","v2","v3","v4","v5","v6","v7"
+   );
+}
+
+/** THREAD_STREAM: background traffic of one thread, starts when the master thread sets data->go and runs until it clears data->go
+ *  - injection_rate: target bandwidth in MB/s, INJECTION_MAX: no throttling, INJECTION_IDLE: no memory accesses
+ *  - throttling: each block gets a time slot of STREAM_BLOCK_SIZE/injection_rate, the thread waits until the
+ *    slot has expired before reading the next block. Slots are not accumulated, i.e. a thread that falls behind
+ *    does not try to catch up with a burst of accesses.
+ */
+static void stream(threaddata_t *mydata)
+{
+   volatile mydata_t* global_data = mydata->data;
+   unsigned long long addr,end_addr,block_cycles=0,next_ts,now,bytes=0;
+
+   //wait for the master thread to start the latency measurement
+   while (!global_data->go);
+
+   addr=mydata->aligned_addr;
+   end_addr=mydata->aligned_addr+(mydata->memsize/STREAM_BLOCK_SIZE)*STREAM_BLOCK_SIZE;
+   if ((mydata->injection_rate!=INJECTION_IDLE)&&(mydata->injection_rate!=INJECTION_MAX))
+     block_cycles=(unsigned long long)(((double)STREAM_BLOCK_SIZE*(double)mydata->cpuinfo->clockrate)/((double)mydata->injection_rate*1000000.0));
+
+   mydata->start_ts=timestamp();
+   next_ts=mydata->start_ts;
+   if ((mydata->injection_rate==INJECTION_IDLE)||(end_addr==addr)) 
+   {
+     mydata->running=1;
+     while (global_data->go);
+   }
+   else while (global_data->go)
+   {
+     asm_stream_ldr128(addr);
+     bytes+=STREAM_BLOCK_SIZE;
+     addr+=STREAM_BLOCK_SIZE;
+     if (addr>=end_addr) addr=mydata->aligned_addr;
+     mydata->running=1;
+
+     if (block_cycles)
+     {
+       next_ts+=block_cycles;
+       do{now=timestamp();} while ((now<next_ts)&&(global_data->go));
+       if (now>next_ts+block_cycles) next_ts=now;
+     }
+   }
+   mydata->end_ts=timestamp();
+   mydata->stream_bytes=bytes;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - latency is always measured on the first CPU in BENCHIT_KERNEL_CPU_LIST, all other CPUs generate
+ *     background traffic with the injection rates from BENCHIT_KERNEL_INJECTION_RATE
+ *   - (*results)[l]: latency with injection rate l, (*results)[num_results+l]: delivered background bandwidth in GB/s
+ */
+void _work(unsigned long long memsize, int def_alignment, int offset, int function, int num_accesses, int runs, volatile mydata_t* data, double **results)
+{
+  int i,j,k,t,l,tmin,max_levels;
+  unsigned long long tmp,tmp2,mask;
+  double bw,bwmin;
+  
+  unsigned long long usable_memory,num_pages,usable_page_size;
+	
+  unsigned long long max_accesses;	
+
+  /* aligned address */
+  unsigned long long aligned_addr;
+
+
+  struct timeval time;
+  
+  gettimeofday( &time, (struct timezone *) 0);
+
+ 
+  /* use rdtsc latency parameter for loop overhead compensation */
+  if ((data->settings)&LOOP_OVERHEAD_COMP) data->cpuinfo->rdtsc_latency=data->loop_overhead;
+  
+  /* calculate aligned address*/
+  aligned_addr = (unsigned long long)(data->buffer)+offset;
+  
+  accesses=num_accesses;
+  alignment=def_alignment;
+
+  mask=(data->pagesize-1)^0xffffffffffffffffULL;
+  usable_memory=(memsize&mask);
+  if (usable_memory==0) usable_memory=memsize;
+  usable_page_size=data->pagesize;
+
+  if ((data->settings&RESTORE_TLB)&&(data->hugepages==HUGEPAGES_OFF))
+  {
+    usable_memory=usable_memory/2;
+    usable_page_size=(data->pagesize)/2;
+    if (usable_memory>data->tlb_size*(data->pagesize/2)) usable_memory=data->tlb_size*(data->pagesize/2);
+    reset_tlb_check(data);
+  }
+
+  max_accesses=(usable_memory/alignment);
+  if (max_accesses<accesses) accesses=max_accesses;
+  if (usable_memory>=usable_page_size) num_pages=usable_memory/usable_page_size;
+  else num_pages=1;
+  accesses=(accesses/24)*24;
+
+  data->page_address=(unsigned long long*)realloc(data->page_address,num_pages*sizeof(unsigned long long));
+
+  if (accesses<=num_pages) {num_pages=accesses;usable_memory=num_pages*usable_page_size;/*alignment=usable_page_size;*/}
+
+
+  if ((accesses<=48) && (memsize<data->cpuinfo->Total_D_Cache_Size)) runs*=2;
+  if ((accesses<=120) && (memsize<data->cpuinfo->Total_D_Cache_Size)) runs*=2;
+  if (memsize>data->cpuinfo->Total_D_Cache_Size) runs/=3;
+  if (runs==0) runs=1;
+
+  max_levels=data->num_results;
+  for (l=0;l<max_levels;l++)
+  {
+   bwmin=0.0;
+   #ifdef AVERAGE
+    tmin=0;
+    #ifdef USE_PAPI
+    for (j=0;j<data->num_events;j++)
+    {
+      data->papi_results[j*max_levels+l]=0;
+    }
+    #endif
+   #else
+    tmin=INT_MAX;
+    #ifdef USE_PAPI
+    for (j=0;j<data->num_events;j++)
+    {
+      data->papi_results[j*max_levels+l]=LONG_MAX;
+    }
+    #endif
+   #endif
+   
+   if (accesses>=24) 
+   {
+
+    for (i=0;i<runs;i++)
+    {
+      iteration=i;
+
+      //access whole buffer to warm up cache
+      use_memory_chains((void*)aligned_addr,data->cache_flush_area,memsize,data->USE_MODE,FIFO,data->NUM_USES,*(data->cpuinfo),data,NULL);
+
+      //flush cachelevels as specified in PARAMETERS
+      flush_caches((void*) aligned_addr,memsize,data->settings,data->NUM_FLUSHES,data->FLUSH_MODE,data->cache_flush_area,data->cpuinfo);
+
+      //restore TLB if enabled (that was destroied by flushing the cache)
+      if ((data->settings&RESTORE_TLB)&&(data->hugepages==HUGEPAGES_OFF))
+      {
+        tmp2=data->pagesize/2+data->pagesize/8;
+        for (j=0;j<num_pages;j++)
+        {
+          for (k=tmp2;k<tmp2+data->pagesize/4;k+=alignment)
+          {
+            tmp=*((unsigned long long*)(data->page_address[j]+k));
+            *((unsigned long long*)(data->page_address[j]+k))=tmp;
+            clflush((void*)data->page_address,num_pages*sizeof(unsigned long long),*(data->cpuinfo));  
+          }
+        }
+      }
+
+      /* start background traffic, threads receive THREAD_STREAM and wait for the go signal */
+      data->go=0;
+      for (t=1;t<data->num_threads;t++){
+         data->threaddata[t].injection_rate=data->injection_rates[l];
+         data->threaddata[t].running=0;
+      }
+      asm volatile ("dmb sy\n\t" : : : "memory");
+      for (t=1;t<data->num_threads;t++) mailbox_post(&(data->mailbox[t]),THREAD_STREAM);
+      asm volatile ("dmb sy\n\t" : : : "memory");
+      data->go=1;
+      //wait until all background threads have completed their first block
+      for (t=1;t<data->num_threads;t++){
+         while (!data->threaddata[t].running);
+      }
+
+      /* call ASM implementation */
+      switch(function){
+        case 0:          
+               //prefetch measurement routine
+               if (data->ENABLE_CODE_PREFETCH){
+                  *((unsigned long long*)(data->cache_flush_area))=(unsigned long long)(data->cache_flush_area); //pointer to itself
+                  for (j=0;j<data->NUM_USES;j++) {tmp+=asm_work_ldr((unsigned long long)(data->cache_flush_area),1,data);}
+               }
+               //measurement
+               tmp=asm_work_ldr(aligned_addr,accesses/24,data);
+               break;
+        default: break;
+      }
+
+      /* stop background traffic */
+      data->go=0;
+      for (t=1;t<data->num_threads;t++) mailbox_wait(&(data->mailbox[t]));
+
+      /* delivered bandwidth, every thread measures its streaming time with the cycle counter of its CPU (not synchronized
+       * across CPUs), all threads stream during the whole latency measurement, so their bandwidths are summed up */
+      bw=0.0;
+      for (t=1;t<data->num_threads;t++){
+         if (data->threaddata[t].end_ts>data->threaddata[t].start_ts)
+           bw+=((double)data->threaddata[t].stream_bytes)/(((double)(data->threaddata[t].end_ts-data->threaddata[t].start_ts))/(((double)data->cpuinfo->clockrate)*0.000000001));
+      }
+
+      // discard first iteration if more than 1 runs are performed
+      if (((i>0)||(runs==1))&&(tmp!=-1))
+      {
+       #ifdef AVERAGE
+         tmin+=tmp;
+         bwmin+=bw;
+         #ifdef USE_PAPI
+         for (j=0;j<data->num_events;j++)
+         {
+           data->papi_results[j*max_levels+l]+=((double)data->values[j]/(double)accesses);
+         }
+         #endif
+       #else
+         if (tmp<tmin) {tmin=tmp;bwmin=bw;}
+         #ifdef USE_PAPI
+         for (j=0;j<data->num_events;j++)
+         {
+           if ((double)data->values[j]/(double)accesses < data->papi_results[j*max_levels+l])
+             data->papi_results[j*max_levels+l]=(double)data->values[j]/(double)accesses;
+         }
+         #endif
+       #endif        
+      }
+    }
+    #ifdef AVERAGE
+    if (runs>1){
+      tmin/=(runs-1);
+      bwmin/=(runs-1);
+       #ifdef USE_PAPI
+       for (j=0;j<data->num_events;j++)
+       {
+         data->papi_results[j*max_levels+l]/=(runs-1);
+       }
+       #endif       
+    }
+    #endif
+   }
+   else tmin=0;
+  
+   if (tmin) (*results)[l]=(double)tmin;
+   else (*results)[l]=INVALID_MEASUREMENT;
+   if ((tmin)&&(data->num_threads>1)&&(data->injection_rates[l]!=INJECTION_IDLE)) (*results)[max_levels+l]=bwmin;
+   else if (tmin) (*results)[max_levels+l]=0.0;
+   else (*results)[max_levels+l]=INVALID_MEASUREMENT;
+  }
+}
@@ -0,0 +1,150 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures read latency while other CPUs generate background memory traffic at selectable injection rates.
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "loaded memory read latency"
+#define CODE_SEQUENCE       "mov mem -> reg, background: ldr q mem -> reg"
+#define X_AXIS_TEXT         "data set size [Byte]"
+#define Y_AXIS_TEXT_1       "latency [ns]"
+#define Y_AXIS_TEXT_2       "latency [cycles]"
+#define Y_AXIS_TEXT_3       "counter value/ memory accesses"
+#define Y_AXIS_TEXT_4       "delivered background bandwidth [GB/s]"
+
+/* kernel specific setting, see membench.h for the common ones */
+#define RESTORE_TLB        0x400
+
+/* kernel specific thread functions */
+#define THREAD_STREAM          THREAD_KERNEL
+
+/* injection rates of the background threads (BENCHIT_KERNEL_INJECTION_RATE)
+ * INJECTION_IDLE: background threads do not access memory (unloaded latency)
+ * INJECTION_MAX:  background threads stream without throttling */
+#define INJECTION_IDLE         0ULL
+#define INJECTION_MAX          0xffffffffffffffffULL
+
+/* background threads check the throttle and the stop condition after each block */
+#define STREAM_BLOCK_SIZE      4096
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* buffer;
+   char* cache_flush_area;
+   pthread_t *threads;
+   struct threaddata *threaddata;
+   cpu_info_t *cpuinfo;                                 //40  
+   unsigned long long* tlb_collision_check_array;
+   unsigned long long* tlb_tags;
+   unsigned long long* page_address;
+   unsigned int FRST_SHARE_CPU;
+   unsigned int NUM_SHARED_CPUS;
+   int max_tlblevel;
+   int pagesize;
+   int tlb_size;
+   int tlb_sets;                                        //+48 
+   unsigned int settings;
+   unsigned int loop_overhead;
+   unsigned short num_threads;
+   unsigned short num_results;
+   unsigned char hugepages;
+   unsigned char extra_clflush;                         
+   unsigned char flush_share_cpu;                       //+15  
+   unsigned char NUM_FLUSHES;
+   unsigned char NUM_USES;
+   unsigned char FLUSH_MODE;                            
+   unsigned char FLUSH_PT;                              //+4
+   unsigned char ENABLE_CODE_PREFETCH;
+   unsigned char USE_MODE;                              //+2
+   unsigned char padding1[3];                           //+3
+   unsigned long long *injection_rates;
+   unsigned long long stream_size;                      //+16 = 128
+   unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
+   #ifdef USE_PAPI
+   long long *values;
+   double *papi_results;
+   int Eventset;
+   int num_events;                                      //(24) 
+   #endif
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
+   volatile unsigned short go;                          //+2, starts background traffic
+   #ifdef USE_PAPI
+   unsigned char padding2[30];                          //24+8+2+30 = 64
+   #else
+   unsigned char padding2[54];                          //   8+2+54 = 64
+   #endif
+   unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
+} mydata_t;
+
+/* data needed by each thread */
+typedef struct threaddata
+{
+   volatile mydata_t *data;
+   char* buffer;
+   char* cache_flush_area;
+   cpu_info_t *cpuinfo;                                 //32  
+   unsigned long long* page_address;
+   volatile unsigned long long aligned_addr;		//+16  
+   unsigned long long buffersize;
+   unsigned long long memsize;				//+16  
+   unsigned long long injection_rate;
+   volatile unsigned long long stream_bytes;
+   volatile unsigned long long start_ts;
+   volatile unsigned long long end_ts;                  //+32
+   unsigned int thread_id;
+   unsigned int accesses;
+   unsigned int settings;
+   unsigned int alignment;
+   unsigned int offset;
+   unsigned int cpu_id;                                 
+   unsigned int mem_bind;                               //+28 
+   unsigned char NUM_FLUSHES;
+   unsigned char NUM_USES;
+   unsigned char FLUSH_MODE;                            //+3
+   unsigned char USE_MODE;                              //+1
+   volatile unsigned char running;                      //+1
+   unsigned char padding1[63];                          //+63 = 192
+   unsigned long long end_dummy_cachelines[16];         //avoid prefetching following data 
+} threaddata_t;
+
+/** Initializes the random number generator with the values given to the function.
+ *  formula: r(n+1) = (a*r(n)+b)%m
+ *  sequence generated by calls of _random() is a permutation of values from 0 to max-1
+ */
+void _random_init(int start,int max);
+/** returns a pseudo random number
+ *  do not use this function without a prior call to _random_init()
+ */
+unsigned long long _random(void);
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n);
+
+ 
+/* function that performs the measurement */
+void _work(unsigned long long memsize, int def_alignment, int offset, int function, int num_accesses, int runs,volatile mydata_t* data, double ** results);
+
+/* parallel first touch of the master buffer and the threads' buffers by the threads on the buffers' NUMA nodes */
+void init_buffers(volatile mydata_t *data,unsigned long long buffersize,int mem_bind);
+
+/* loop executed by all threads, except the master thread
+ * THREAD_STREAM: thread waits for data->go and generates background traffic until data->go is cleared
+ */
+void *thread(void *threaddata);
+
+#endif
@@ -42,10 +42,18 @@ int n_of_sure_funcs_per_work;
 unsigned long long BUFFERSIZE;
 int HUGEPAGES=0,RUNS=0,EXTRA_CLFLUSH=0,OFFSET=0,FUNCTION=0,BURST_LENGTH=0,RANDOM=0;
 int ALIGNMENT=64,NUM_RESULTS=0,TIMEOUT=0,NUM_THREADS=0,LOOP_OVERHEAD_COMPENSATION=0;
+/* idle policy of the helper threads, spin time in ns before blocking (-1: spin only), derived from IDLE_POLICY and IDLE_SPIN_TIME in PARAMETERS file */
+long long IDLE_SPIN_TIME=-1;
 int EXTRA_FLUSH_SIZE=0,GLOBAL_FLUSH_BUFFER=0,DISABLE_CLFLUSH=1;
 int FLUSH_L1=0,FLUSH_L2=0,FLUSH_L3=0,FLUSH_L4=0,NUM_FLUSHES=0,NUM_USES=0,FLUSH_MODE=0,ENABLE_CODE_PREFETCH=0,FLUSH_SHARED_CPU=0;
 int ACCESSES=0,TLB_MODE=0,FLUSH_PT,USE_MODE=0,FRST_SHARE_CPU=0,NUM_SHARED_CPUS=0,ALWAYS_FLUSH_CPU0=0;
 
+/* numbers of interleaved pointer chains, derived from CHAINS in PARAMETERS file
+ * MLP_RESULTS: 1 if memory level parallelism is reported (more than one chain selected) 
+ * CHAINS_REF: index of the measurement with one chain (reference for MLP calculation) */
+int *chain_counts;
+int NUM_CHAIN_COUNTS=0,MLP_RESULTS=0,CHAINS_REF=0;
+
 
 /* string used for error message */
 char *error_msg=NULL;
@@ -152,14 +160,14 @@ void bi_getinfo( bi_info * infostruct )
    infostruct->kernel_execs_omp = 0;
    infostruct->kernel_execs_pthreads = 1;
 
-   /* cycles and ns + selected counters*/
-   n_of_works = 2;
+   /* cycles and ns (+ MLP) + selected counters*/
+   n_of_works = 2 + MLP_RESULTS;
    #ifdef USE_PAPI
     n_of_works+=papi_num_counters;
    #endif
       
-   /* measure local latency of CPU0 and latency between CPU0 and all other selected CPUs*/
-   n_of_sure_funcs_per_work = NUM_RESULTS;
+   /* measure local latency of CPU0 and latency between CPU0 and all other selected CPUs for every number of chains */
+   n_of_sure_funcs_per_work = NUM_RESULTS * NUM_CHAIN_COUNTS;
    
    infostruct->numfunctions = n_of_works * n_of_sure_funcs_per_work;
 
@@ -187,32 +195,46 @@ void bi_getinfo( bi_info * infostruct )
 
    /* setting up y axis texts and properties */
    for ( j = 0; j < n_of_works; j++ ){
-     int k,index;
-      for (k=0;k<n_of_sure_funcs_per_work;k++)
+     int k,d,index;
+     char chains[32];
+     for (d=0;d<NUM_CHAIN_COUNTS;d++)
+     {
+      /* effective time per access is reported if more than one chain is used */
+      if (MLP_RESULTS) sprintf(chains,", %i chains",chain_counts[d]);
+      else chains[0]='\0';
+      for (k=0;k<NUM_RESULTS;k++)
       {
 
-        index= k + n_of_sure_funcs_per_work * j;
+        index= k + NUM_RESULTS * d + n_of_sure_funcs_per_work * j;
         infostruct->base_yaxis[index] = 0;
         switch ( j )
         {
           case 1: // ns
-            if (k)  sprintf(buff,"memory latency CPU%llu accessing CPU%llu memory (time)",cpu_bind[0],cpu_bind[k]);
-            else sprintf(buff,"memory latency CPU%llu locally (time)",cpu_bind[0]);
+            if (k)  sprintf(buff,"memory latency CPU%llu accessing CPU%llu memory%s (time)",cpu_bind[0],cpu_bind[k],chains);
+            else sprintf(buff,"memory latency CPU%llu locally%s (time)",cpu_bind[0],chains);
             infostruct->legendtexts[index] = bi_strdup( buff );
             infostruct->outlier_direction_upwards[index] = 1;  //report minimum of iterations
             infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_1 );
             break;
           case 0: // cycles
-           if (k)  sprintf(buff,"memory latency CPU%llu accessing CPU%llu memory (CPU cycles)",cpu_bind[0],cpu_bind[k]);
-           else sprintf(buff,"memory latency CPU%llu locally (CPU cycles)",cpu_bind[0]);
+           if (k)  sprintf(buff,"memory latency CPU%llu accessing CPU%llu memory%s (CPU cycles)",cpu_bind[0],cpu_bind[k],chains);
+           else sprintf(buff,"memory latency CPU%llu locally%s (CPU cycles)",cpu_bind[0],chains);
            infostruct->legendtexts[index] = bi_strdup( buff );
            infostruct->outlier_direction_upwards[index] = 1;   //report minimum of iterations
            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_2 );
            break;
-          default: // papi
+          default: // MLP, papi
+           if ((MLP_RESULTS)&&(j==2)){
+            if (k)  sprintf(buff,"MLP CPU%llu accessing CPU%llu memory%s",cpu_bind[0],cpu_bind[k],chains);
+            else sprintf(buff,"MLP CPU%llu locally%s",cpu_bind[0],chains);
+            infostruct->legendtexts[index] = bi_strdup( buff );
+            infostruct->outlier_direction_upwards[index] = 0;  //report maximum of iterations
+            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_4 );
+            break;
+           }
            #ifdef USE_PAPI
-            if (k)  sprintf(buff,"%s CPU%llu - CPU%llu",papi_names[j-2],cpu_bind[0],cpu_bind[k]);
-            else sprintf(buff,"%s CPU%llu locally",papi_names[j-2],cpu_bind[0]);
+            if (k)  sprintf(buff,"%s CPU%llu - CPU%llu%s",papi_names[j-2-MLP_RESULTS],cpu_bind[0],cpu_bind[k],chains);
+            else sprintf(buff,"%s CPU%llu locally%s",papi_names[j-2-MLP_RESULTS],cpu_bind[0],chains);
             infostruct->legendtexts[index] = bi_strdup( buff );
             infostruct->outlier_direction_upwards[index] = 0;  //report maximum of iterations
             infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_3 );
@@ -220,6 +242,7 @@ void bi_getinfo( bi_info * infostruct )
            break;
         } 
       }
+     }
    }
 }
 
@@ -353,11 +376,13 @@ void* bi_init( int problemsizemax )
    mdp->num_threads=NUM_THREADS;
    mdp->num_results=NUM_RESULTS;
    mdp->threads=_mm_malloc(NUM_THREADS*sizeof(pthread_t),ALIGNMENT);
-   mdp->thread_comm=_mm_malloc(NUM_THREADS*sizeof(int),ALIGNMENT);
-   if ((mdp->threads==NULL)||(mdp->thread_comm==NULL)){
+   mdp->mailbox=_mm_malloc(NUM_THREADS*sizeof(mailbox_t),sizeof(mailbox_t));
+   if ((mdp->threads==NULL)||(mdp->mailbox==NULL)){
      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
      exit( 127 );
-   }   
+   }
+   memset(mdp->mailbox,0,NUM_THREADS*sizeof(mailbox_t));
+   for (i=0;i<NUM_THREADS;i++) mdp->mailbox[i].spin_time=IDLE_SPIN_TIME;
 
    /* enable selected cache flushes */
    if ((FLUSH_L1)&&(mdp->cpuinfo->U_Cache_Size[0]+mdp->cpuinfo->D_Cache_Size[0]!=0)){ 
@@ -406,8 +431,9 @@ void* bi_init( int problemsizemax )
    if (CACHEFLUSHSIZE>mdp->cpuinfo->Cacheflushsize){
       mdp->cpuinfo->Cacheflushsize=CACHEFLUSHSIZE;
    }
+   mdp->chain_start=(unsigned long long*)_mm_malloc(MAX_CHAINS*sizeof(unsigned long long),ALIGNMENT);
    mdp->cache_flush_area=(char*)_mm_malloc(mdp->cpuinfo->Cacheflushsize,ALIGNMENT);
-   if (mdp->cache_flush_area == 0){
+   if ((mdp->cache_flush_area == 0)||(mdp->chain_start == 0)){
       fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
       exit( 127 );
    }
@@ -454,12 +480,10 @@ void* bi_init( int problemsizemax )
       exit( 127 );
     }
     memcpy(mdp->threaddata[t].cpuinfo,mdp->cpuinfo,sizeof(cpu_info_t));
-    mdp->ack=0;
     mdp->threaddata[t].thread_id=t;
     mdp->threaddata[t].cpu_id=cpu_bind[t];
     mdp->threaddata[t].mem_bind=mem_bind[t];
     mdp->threaddata[t].data=mdp;
-    mdp->thread_comm[t]=THREAD_INIT;
     mdp->threaddata[t].settings=mdp->settings;
     if (GLOBAL_FLUSH_BUFFER){
        mdp->threaddata[t].cache_flush_area=mdp->cache_flush_area;
@@ -488,11 +512,10 @@ void* bi_init( int problemsizemax )
     mdp->threaddata[t].buffersize=BUFFERSIZE;
     mdp->threaddata[t].alignment=mdp->cpuinfo->pagesizes[0];
     mdp->threaddata[t].offset=OFFSET;    
+    mailbox_post(&(mdp->mailbox[t]),THREAD_INIT);
     pthread_create(&(mdp->threads[t]),NULL,thread,(void*)(&(mdp->threaddata[t])));
-    while (!mdp->ack);
   }
 
-  mdp->ack=0;mdp->done=0;
   cpu_set(mem_bind[0]);
   numa_node = numa_node_of_cpu(mem_bind[0]);
   numa_bitmask = numa_bitmask_alloc((unsigned int) numa_max_possible_node());
@@ -525,22 +548,12 @@ void* bi_init( int problemsizemax )
      exit( 127 );
   }
  
-   /* initialize buffer */
-   tmp=sizeof(unsigned long long);
-   for (i=0;i<=BUFFERSIZE-tmp;i+=tmp){
-      *((unsigned long long*)((unsigned long long)mdp->buffer+i))=(unsigned long long)i;
-   }
-   clflush(mdp->buffer,BUFFERSIZE,*(mdp->cpuinfo));
- 
   cpu_set(cpu_bind[0]);
   printf("  wait for threads memory initialization \n");fflush(stdout);
   /* wait for threads to finish their initialization */  
-  for (t=1;t<mdp->num_threads;t++){
-     mdp->ack=0;
-     mdp->thread_comm[t]=THREAD_WAIT;
-     while (!mdp->ack);
-  }
-  mdp->ack=0;
+  for (t=1;t<mdp->num_threads;t++) mailbox_wait(&(mdp->mailbox[t]));
+  /* first touch of all buffers, split across the threads on the NUMA node of each buffer */
+  init_buffers(mdp,BUFFERSIZE,mem_bind[0]);
   printf("    ...done\n");
   if ((num_packages()!=-1)&&(num_cores_per_package()!=-1)&&(num_threads_per_core()!=-1))  printf("  num_packages: %i, %i cores per package, %i threads per core\n",num_packages(),num_cores_per_package(),num_threads_per_core());
   printf("  using %i threads\n",NUM_THREADS);
@@ -571,7 +584,7 @@ void* bi_init( int problemsizemax )
 int inline bi_entry( void* mdpv, int problemsize, double* results )
 {
   /* j is used for loop iterations */
-  int j = 0,k = 0;
+  int j = 0,k = 0,d = 0;
   /* real problemsize*/
   unsigned long long rps;
   /* cast void* pointer */
@@ -591,24 +604,40 @@ int inline bi_entry( void* mdpv, int problemsize, double* results )
   /* check wether the pointer to store the results in is valid or not */
   if ( results == NULL ) return 1;
 
-  /* one call measures latencies in cycles for all selected CPUs */
-  _work(rps,ALIGNMENT,OFFSET,FUNCTION,ACCESSES,RUNS,mdp,&tmp_results);
   results[0] = (double)rps;
 
+  for (d=0;d<NUM_CHAIN_COUNTS;d++)
+  {
+  /* one call measures latencies in cycles for all selected CPUs */
+  if (chain_counts[d]>1) _work(rps,ALIGNMENT,OFFSET,1,chain_counts[d],ACCESSES,RUNS,mdp,&tmp_results);
+  else _work(rps,ALIGNMENT,OFFSET,FUNCTION,1,ACCESSES,RUNS,mdp,&tmp_results);
+
   /* copy tmp_results to final results */  
-for (k=0;k<NUM_RESULTS;k++)
+  for (k=0;k<NUM_RESULTS;k++)
   {
     /* write measured cycles to final results, calculate duration*/
-    results[1+k]=tmp_results[k];
-    if (tmp_results[k]==INVALID_MEASUREMENT)results[1+NUM_RESULTS+k]=INVALID_MEASUREMENT;
-    else results[1+NUM_RESULTS+k]=(double)((tmp_results[k]/mdp->cpuinfo->clockrate)*1000000000);
+    results[1+k+NUM_RESULTS*d]=tmp_results[k];
+    if (tmp_results[k]==INVALID_MEASUREMENT)results[1+n_of_sure_funcs_per_work+k+NUM_RESULTS*d]=INVALID_MEASUREMENT;
+    else results[1+n_of_sure_funcs_per_work+k+NUM_RESULTS*d]=(double)((tmp_results[k]/mdp->cpuinfo->clockrate)*1000000000);
     #ifdef USE_PAPI
     for (j=0;j<papi_num_counters;j++)
     {
-      results[1+(j+2)*NUM_RESULTS+k]=mdp->papi_results[j*NUM_RESULTS+k];
+      results[1+(j+2+MLP_RESULTS)*n_of_sure_funcs_per_work+k+NUM_RESULTS*d]=mdp->papi_results[j*NUM_RESULTS+k];
     }
     #endif
   }
+  }
+
+  /* MLP: latency with a single chain divided by effective time per access with multiple chains */
+  if (MLP_RESULTS) for (d=0;d<NUM_CHAIN_COUNTS;d++)
+  {
+    for (k=0;k<NUM_RESULTS;k++)
+    {
+      if ((results[1+k+NUM_RESULTS*d]==INVALID_MEASUREMENT)||(results[1+k+NUM_RESULTS*CHAINS_REF]==INVALID_MEASUREMENT)||(results[1+k+NUM_RESULTS*d]==0)) results[1+2*n_of_sure_funcs_per_work+k+NUM_RESULTS*d]=INVALID_MEASUREMENT;
+      else results[1+2*n_of_sure_funcs_per_work+k+NUM_RESULTS*d]=results[1+k+NUM_RESULTS*CHAINS_REF]/results[1+k+NUM_RESULTS*d];
+    }
+  }
+  _mm_free(tmp_results);
   return 0;
 }
 
@@ -620,12 +649,9 @@ void bi_cleanup( void* mdpv )
    
    mydata_t* mdp = (mydata_t*)mdpv;
    /* terminate other threads */
-   for (t=1;t<mdp->num_threads;t++)
-   {
-    mdp->ack=0;
-    mdp->thread_comm[t]=THREAD_STOP;
-    pthread_join((mdp->threads[t]),NULL);
-   } 
+   for (t=1;t<mdp->num_threads;t++) mailbox_post(&(mdp->mailbox[t]),THREAD_STOP);
+   for (t=1;t<mdp->num_threads;t++) pthread_join((mdp->threads[t]),NULL);
+   if (mdp->mailbox) mailbox_report(mdp->mailbox,mdp->num_threads);
    pthread_kill(watchdog,SIGUSR1);
 
    /* free resources */
@@ -634,6 +660,7 @@ void bi_cleanup( void* mdpv )
      if(mdp->buffer!=NULL) munmap((void*)mdp->buffer,BUFFERSIZE);
    }
    if (mdp->cache_flush_area!=NULL) _mm_free (mdp->cache_flush_area);
+   if (mdp->chain_start!=NULL) _mm_free (mdp->chain_start);
    if (mdp->threaddata){
      for (t=1;t<mdp->num_threads;t++){
         if (mdp->threaddata[t].cpuinfo) _mm_free(mdp->threaddata[t].cpuinfo);
@@ -642,7 +669,7 @@ void bi_cleanup( void* mdpv )
      _mm_free(mdp->threaddata);   
    }
    if (mdp->threads) _mm_free(mdp->threads);
-   if (mdp->thread_comm) _mm_free(mdp->thread_comm);
+   if (mdp->mailbox) _mm_free(mdp->mailbox);
    if (mdp->cpuinfo) _mm_free(mdp->cpuinfo);
    if (mdp->tlb_tags!=NULL) _mm_free (mdp->tlb_tags);
    if (mdp->tlb_collision_check_array!=NULL) _mm_free (mdp->tlb_collision_check_array);
@@ -806,6 +833,32 @@ void evaluate_environment(bi_info * info)
    p = bi_getenv( "BENCHIT_KERNEL_ACCESSES", 0 );
    if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_ACCESSES not set");}
    else ACCESSES = atoi( p );
+
+   /* list of numbers of interleaved pointer chains (default 1: pure latency) */
+   p = bi_getenv( "BENCHIT_KERNEL_CHAINS", 0 );
+   if ( p == 0 ) {chain_counts=(int*)malloc(sizeof(int));chain_counts[0]=1;NUM_CHAIN_COUNTS=1;}
+   else
+   {
+     char *q;
+     p=bi_strdup(p);
+     NUM_CHAIN_COUNTS=1;
+     for (q=p;strstr(q,",")!=NULL;q=strstr(q,",")+1) NUM_CHAIN_COUNTS++;
+     chain_counts=(int*)malloc(NUM_CHAIN_COUNTS*sizeof(int));
+     CHAINS_REF=-1;
+     for (i=0;i<NUM_CHAIN_COUNTS;i++){
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       chain_counts[i]=atoi(p);
+       switch (chain_counts[i]){
+         case 1: CHAINS_REF=i; break;
+         case 2: case 3: case 4: case 6: case 8: case 12: case 16: case 24: MLP_RESULTS=1; break;
+         default: errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_CHAINS, supported values: 1,2,3,4,6,8,12,16,24");break;
+       }
+       p=q;
+     }
+     if ((MLP_RESULTS)&&(CHAINS_REF==-1)) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_CHAINS has to include 1 (reference for MLP calculation)");}
+     if (CHAINS_REF==-1) CHAINS_REF=0;
+   }
+
    p = bi_getenv( "BENCHIT_KERNEL_TLB_MODE", 0 );
    if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_TLB_MODE not set");}
    else TLB_MODE = atoi( p );
@@ -1012,6 +1065,17 @@ void evaluate_environment(bi_info * info)
    if (p!=0){
      TIMEOUT=atoi(p);
    }
+
+   /* helper threads spin while idle (default) or block after BENCHIT_KERNEL_IDLE_SPIN_TIME microseconds */
+   p=bi_getenv( "BENCHIT_KERNEL_IDLE_POLICY", 0 );
+   if ((p==0)||(!strcmp(p,"spin"))) IDLE_SPIN_TIME=-1;
+   else if (!strcmp(p,"block")){
+     p=bi_getenv( "BENCHIT_KERNEL_IDLE_SPIN_TIME", 0 );
+     if (p!=0) IDLE_SPIN_TIME=atoll(p)*1000;
+     else IDLE_SPIN_TIME=100000;
+     if (IDLE_SPIN_TIME<0) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_SPIN_TIME");}
+   }
+   else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_IDLE_POLICY (spin|block)");}
    
    p=bi_getenv( "BENCHIT_KERNEL_SERIALIZATION", 0 );
    if ((p!=0)&&(strcmp(p,"mfence"))&&(strcmp(p,"cpuid"))&&(strcmp(p,"disabled"))) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_SERIALIZATION");}
@@ -15,6 +15,7 @@
 #include <pthread.h>
 #include <numa.h>
 #include "arch.h"
+#include "membench.h"
 
 #define KERNEL_DESCRIPTION  "memory read latency"
 #define CODE_SEQUENCE       "mov mem -> reg"
@@ -22,75 +23,13 @@
 #define Y_AXIS_TEXT_1       "latency [ns]"
 #define Y_AXIS_TEXT_2       "latency [cycles]"
 #define Y_AXIS_TEXT_3       "counter value/ memory accesses"
+#define Y_AXIS_TEXT_4       "memory level parallelism"
 
-/* serialization method */
-#if defined(FORCE_CPUID)
-#define SERIALIZE "push %%rax; push %%rbx; push %%rcx; push %%rdx;" \
-                "mov $0, %%rax;" \
-                "cpuid;" \
-                "pop %%rdx; pop %%rcx; pop %%rbx; pop %%rax;"
-#elif defined(FORCE_MFENCE)
-#define SERIALIZE "dmb sy\n\t"
-#else
-#define SERIALIZE ""
-#endif
-
-/* read timestamp counter */
-#define TIMESTAMP "mrs %0,pmccntr_el0\n\t"
+/* max. number of interleaved pointer chains (BENCHIT_KERNEL_CHAINS) */
+#define MAX_CHAINS     24
 
-#define LOOP_OVERHEAD_COMP 0x100
-#define OPT_FLUSH_CPU0  0x200
+/* kernel specific setting, see membench.h for the common ones */
 #define RESTORE_TLB        0x400
-#define FLUSH(X)  (1<<(X-1))
-
-#define HUGEPAGES_OFF  0x01
-#define HUGEPAGES_ON   0x02
-
-#define LIFO           0x01
-#define FIFO           0x02
-
-/* coherency states */
-#define MODE_EXCLUSIVE 0x01
-#define MODE_MODIFIED  0x02
-#define MODE_INVALID   0x04
-#define MODE_SHARED    0x08
-#define MODE_OWNED     0x10
-#define MODE_FORWARD   0x20
-#define MODE_RDONLY    0x40
-#define MODE_MUW       0x80
-#define MODE_DISABLED  0x00
-
-/* thread functions */
-#define THREAD_INIT            1
-#define THREAD_STOP            2
-#define THREAD_USE_MEMORY      3
-#define THREAD_WAIT            4
-#define THREAD_PREFETCH_CODE   5
-#define THREAD_FLUSH           6
-#define THREAD_FLUSH_ALL       7
-
-/* default value for accessing each cacheline - updated with hw_detect information if available */
-#define STRIDE        64
-
-/* definitions to add the selected number of "nop" instructions (BENCHIT_KERNEL_NOPCOUNT) into the assembler code */
-#ifndef NOPCOUNT
-#define NOPCOUNT 0
-#endif
-#define _nop0 ""
-#define _nop1 "nop;"_nop0
-#define _nop2 "nop;"_nop1
-#define _nop3 "nop;"_nop2
-#define _nop4 "nop;"_nop3
-#define _nop5 "nop;"_nop4
-#define _nop6 "nop;"_nop5
-#define _nop7 "nop;"_nop6
-#define _nop8 "nop;"_nop7
-#define _nop9 "nop;"_nop8
-#define _nop10 "nop;"_nop9
-#define _donop(x) _nop ## x       //_donop(n)     -> _nopn
-#define NOP(x) _donop(x)          //NOP(NOPCOUNT) -> _donop(n)
-
-
 
 /** The data structure that holds all the global data.
  */
@@ -123,7 +62,8 @@ typedef struct mydata
    unsigned char FLUSH_PT;                              //+4
    unsigned char ENABLE_CODE_PREFETCH;
    unsigned char USE_MODE;                              //+2
-   unsigned char padding1[19];                          //+19 = 128
+   unsigned char padding1[11];                          //+11
+   unsigned long long *chain_start;                     //+8 = 128
    unsigned long long dummy_cachelines1[16];            // separate exclusive data from shared data
    #ifdef USE_PAPI
    long long *values;
@@ -131,13 +71,11 @@ typedef struct mydata
    int Eventset;
    int num_events;                                      //(24) 
    #endif
-   int *thread_comm;                                    //+8   
-   volatile unsigned short ack;
-   volatile unsigned short done;                        //+4 
+   mailbox_t *mailbox;                                  //+8, command slots of the threads
    #ifdef USE_PAPI
-   unsigned char padding2[28];                          //24+8+4+28 = 64
+   unsigned char padding2[32];                          //24+8+32 = 64
    #else
-   unsigned char padding2[52];                          //   8+4+52 = 64
+   unsigned char padding2[56];                          //   8+56 = 64
    #endif
    unsigned long long end_dummy_cachelines[16];         // avoid prefetching other memory when accessing mydata_t structure
 } mydata_t;
@@ -183,7 +121,10 @@ int asm_loop_overhead(int n);
 
  
 /* function that performs the measurement */
-void _work(unsigned long long memsize, int def_alignment, int offset, int function, int num_accesses, int runs,volatile mydata_t* data, double ** results);
+void _work(unsigned long long memsize, int def_alignment, int offset, int function, int num_chains, int num_accesses, int runs,volatile mydata_t* data, double ** results);
+
+/* parallel first touch of the master buffer and the threads' buffers by the threads on the buffers' NUMA nodes */
+void init_buffers(volatile mydata_t *data,unsigned long long buffersize,int mem_bind);
 
 /* loop executed by all threads, except the master thread */
 void *thread(void *threaddata);
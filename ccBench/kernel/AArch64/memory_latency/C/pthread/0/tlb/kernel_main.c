@@ -0,0 +1,519 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *****************************************************************************************************/
+/* Kernel: measures TLB reach and page walk latency for different page sizes (one cache line per page).
+ *****************************************************************************************************/
+#define _GNU_SOURCE
+#include <sched.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <signal.h>
+#include <unistd.h>
+#include "interface.h"
+#include "tools/hw_detect/cpu.h"
+
+
+/*  Header for local functions */
+#include "work.h"
+
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+/* number of functions (needed by BenchIT Framework, see bi_getinfo()) */
+int n_of_works;
+int n_of_sure_funcs_per_work;
+
+/* variables to store settings from PARAMETERS file
+ * parsed by evaluate_environment() function */
+int RUNS=0,TIMEOUT=0,NUM_PAGESIZES=0,CPU=0,LOOP_OVERHEAD_COMPENSATION=0;
+unsigned long long ACCESSES=0,MAX=0,MAX_MEMORY=0,CACHELINE=0;
+unsigned long long PAGESIZES[MAX_PAGE_SIZES];
+
+/* string used for error message */
+char *error_msg=NULL;
+
+/* number of pages for each measurement */
+bi_list_t * problemlist;
+unsigned long long problemlistsize;
+double *problemarray1;
+
+/* data structure for hardware detection */
+static cpu_info_t *cpuinfo=NULL;
+
+/* needed to derive elapsed time from clock cycles, determined by hw_detect */
+unsigned long long FREQUENCY=0;
+
+/* data structure that holds all relevant information for kernel execution */
+volatile mydata_t* mdp;
+
+/* data for watchdog timer */
+pthread_t watchdog;
+typedef struct watchdog_args{
+ pid_t pid;
+ int timeout;
+} watchdog_arg_t;
+watchdog_arg_t watchdog_arg;
+
+/* stops watchdog thread if benchmark finishes before timeout */
+static void sigusr1_handler (int signum) {
+ pthread_exit(0);
+}
+
+/** stops benchmark if timeout is reached
+ */
+static void *watchdog_timer(void *arg){
+  sigset_t  signal_mask;
+
+  /* ignore SIGTERM and SIGINT */
+  sigemptyset (&signal_mask);
+  sigaddset (&signal_mask, SIGINT);
+  sigaddset (&signal_mask, SIGTERM);
+  pthread_sigmask (SIG_BLOCK, &signal_mask, NULL);
+
+  /* watchdog thread will terminate after receiveing SIGUSR1 during bi_cleanup() */
+  signal(SIGUSR1,sigusr1_handler);
+
+  if (((watchdog_arg_t*)arg)->timeout>0){
+     /* sleep for specified timeout before terminating benchmark */
+     sleep(((watchdog_arg_t*)arg)->timeout);
+     kill(((watchdog_arg_t*)arg)->pid,SIGTERM);
+  }
+  pthread_exit(0);
+}
+
+/** prints page size with unit
+ */
+static void pagesize_str(char *buff, unsigned long long size)
+{
+   if ((size>=(1ULL<<30))&&(size%(1ULL<<30)==0)) sprintf(buff,"%llu GiB",size>>30);
+   else if ((size>=(1ULL<<20))&&(size%(1ULL<<20)==0)) sprintf(buff,"%llu MiB",size>>20);
+   else sprintf(buff,"%llu KiB",size>>10);
+}
+
+/** allocates buffer with the requested page size
+ *  - base page size: anonymous memory, transparent hugepages disabled for the buffer
+ *  - larger page sizes: hugetlb pages (MAP_HUGETLB), requires pages of this size to be reserved
+ *    (/sys/kernel/mm/hugepages/hugepages-<size>kB/nr_hugepages)
+ *  returns NULL if the page size is not available
+ */
+static char* alloc_pages(unsigned long long size, unsigned long long pagesize)
+{
+   char *buffer;
+   unsigned long long base=(unsigned long long)sysconf(_SC_PAGESIZE);
+   int shift=0;
+
+   if (pagesize<base) return NULL;
+   if (pagesize==base){
+     buffer=(char*) mmap(NULL,size,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+     if (buffer==MAP_FAILED) return NULL;
+     #ifdef MADV_NOHUGEPAGE
+     madvise(buffer,size,MADV_NOHUGEPAGE);
+     #endif
+   }
+   else {
+     while ((1ULL<<shift)<pagesize) shift++;
+     buffer=(char*) mmap(NULL,size,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB|(shift<<MAP_HUGE_SHIFT),-1,0);
+     if (buffer==MAP_FAILED) return NULL;
+   }
+   /* touch all pages */
+   memset(buffer,0,size);
+   return buffer;
+}
+
+/** function that parses the PARAMETERS file
+ */
+void evaluate_environment(bi_info * info);
+
+/**  The implementation of the bi_getinfo() from the BenchIT interface.
+ *   Infostruct is filled with informations about the kernel.
+ *   @param infostruct  a pointer to a structure filled with zero's
+ */
+void bi_getinfo( bi_info * infostruct )
+{
+   int i = 0, j = 0; /* loop var for n_of_works */
+   char buff[512],size[64];
+   (void) memset ( infostruct, 0, sizeof( bi_info ) );
+   /* get environment variables for the kernel */
+   evaluate_environment(infostruct);
+   infostruct->codesequence = bi_strdup( CODE_SEQUENCE );
+   infostruct->xaxistext = bi_strdup( X_AXIS_TEXT );
+   infostruct->base_xaxis=10.0;
+   infostruct->maxproblemsize=problemlistsize;
+   sprintf(buff, KERNEL_DESCRIPTION);
+   infostruct->kerneldescription = bi_strdup( buff );
+   infostruct->num_processes = 1;
+   infostruct->num_threads_per_process = 1;
+   infostruct->kernel_execs_mpi1 = 0;
+   infostruct->kernel_execs_mpi2 = 0;
+   infostruct->kernel_execs_pvm = 0;
+   infostruct->kernel_execs_omp = 0;
+   infostruct->kernel_execs_pthreads = 0;
+
+   /* latency in cycles and ns for every page size and the reference, latency - reference in cycles for every page size */
+   n_of_works = 3;
+
+   /* one curve per page size, reference */
+   n_of_sure_funcs_per_work = NUM_PAGESIZES+1;
+
+   infostruct->numfunctions = 3*NUM_PAGESIZES+2;
+
+   /* allocating memory for y axis texts and properties */
+   infostruct->yaxistexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->yaxistexts == 0 ){
+     fprintf( stderr, "Allocation of yaxistexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->outlier_direction_upwards = malloc( infostruct->numfunctions * sizeof( int ));
+   if ( infostruct->outlier_direction_upwards == 0 ){
+     fprintf( stderr, "Allocation of outlier direction failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->legendtexts = malloc( infostruct->numfunctions * sizeof( char* ));
+   if ( infostruct->legendtexts == 0 ){
+     fprintf( stderr, "Allocation of legendtexts failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   infostruct->base_yaxis = malloc( infostruct->numfunctions * sizeof( double ));
+   if ( infostruct->base_yaxis == 0 ){
+     fprintf( stderr, "Allocation of base yaxis failed.\n" ); fflush( stderr );
+     exit( 127 );
+   }
+
+   /* setting up y axis texts and properties */
+   for ( j = 0; j < n_of_works; j++ ){
+     int k,index;
+      for (k=0;k<n_of_sure_funcs_per_work;k++)
+      {
+        /* no difference curve for the reference */
+        if ((j==2)&&(k==NUM_PAGESIZES)) continue;
+
+        index= k + n_of_sure_funcs_per_work * j;
+        infostruct->base_yaxis[index] = 0;
+        if (k<NUM_PAGESIZES) {
+          pagesize_str(size,PAGESIZES[k]);
+          sprintf(buff,"%s pages",size);
+        }
+        else sprintf(buff,"reference (lines packed, no TLB misses)");
+        switch ( j )
+        {
+          case 1: // ns
+            strcat(buff," (time)");
+            infostruct->legendtexts[index] = bi_strdup( buff );
+            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_1 );
+            break;
+          case 0: // cycles
+            strcat(buff," (CPU cycles)");
+            infostruct->legendtexts[index] = bi_strdup( buff );
+            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_2 );
+            break;
+          case 2: // page walk cost
+            strcat(buff," (page walk cycles)");
+            infostruct->legendtexts[index] = bi_strdup( buff );
+            infostruct->yaxistexts[index] = bi_strdup( Y_AXIS_TEXT_3 );
+            break;
+          default: break;
+        }
+        infostruct->outlier_direction_upwards[index] = 1;  //report minimum of iterations
+      }
+   }
+}
+
+/** Implementation of the bi_init() of the BenchIT interface.
+ *  init data structures needed for kernel execution
+ */
+void* bi_init( int problemsizemax )
+{
+   int i;
+   char size[64];
+
+   /* measuring CPU allocates all buffers in its local memory */
+   cpu_set(CPU);
+
+   mdp->cpuinfo=cpuinfo;
+
+   /* overwrite detected clockrate if specified in PARAMETERS file*/
+   if (FREQUENCY){
+      mdp->cpuinfo->clockrate=FREQUENCY;
+   }
+   else if (mdp->cpuinfo->clockrate==0){
+      fprintf( stderr, "Error: CPU-Clockrate could not be estimated\n" );
+      exit( 1 );
+   }
+
+   /* use rdtsc latency parameter for loop overhead compensation */
+   mdp->cpuinfo->rdtsc_latency=LOOP_OVERHEAD_COMPENSATION;
+
+   mdp->linesize=CACHELINE;
+   mdp->accesses=ACCESSES;
+   mdp->runs=RUNS;
+   mdp->num_pagesizes=NUM_PAGESIZES;
+   mdp->reference=-1;
+
+   printf("\n  allocating buffers (maximum %llu pages, maximum %llu MiB per page size)\n",MAX,MAX_MEMORY>>20);
+   for (i=0;i<NUM_PAGESIZES;i++){
+     mdp->pagesize[i]=PAGESIZES[i];
+     mdp->max_pages[i]=MAX;
+     if (mdp->max_pages[i]*mdp->pagesize[i]>MAX_MEMORY) mdp->max_pages[i]=MAX_MEMORY/mdp->pagesize[i];
+     mdp->buffersize[i]=mdp->max_pages[i]*mdp->pagesize[i];
+     /* buffers also have to hold the densely packed lines of the reference measurement */
+     if (mdp->buffersize[i]<MAX*mdp->linesize) mdp->buffersize[i]=((MAX*mdp->linesize+mdp->pagesize[i]-1)/mdp->pagesize[i])*mdp->pagesize[i];
+
+     pagesize_str(size,mdp->pagesize[i]);
+     if (mdp->buffersize[i]) mdp->buffer[i]=alloc_pages(mdp->buffersize[i],mdp->pagesize[i]);
+     if ((mdp->buffersize[i]==0)||(mdp->buffer[i]==NULL)){
+       fprintf( stderr, "Warning: %s pages not available, results will be invalid\n",size ); fflush( stderr );
+       mdp->buffer[i]=NULL;
+       mdp->buffersize[i]=0;
+       mdp->max_pages[i]=PAGES_UNAVAILABLE;
+       continue;
+     }
+     printf("    - %s pages: %llu pages (%llu MiB)\n",size,mdp->max_pages[i],mdp->buffersize[i]>>20);
+     if ((mdp->reference<0)||(mdp->pagesize[i]>mdp->pagesize[mdp->reference])) mdp->reference=i;
+   }
+   if (mdp->reference<0) {
+     fprintf( stderr, "Error: none of the selected page sizes is available\n" ); fflush( stderr );
+     exit( 1 );
+   }
+   pagesize_str(size,mdp->pagesize[mdp->reference]);
+   printf("    - reference measurement uses %s pages\n",size);
+   printf("  measuring on CPU %i, %llu Byte cache lines\n",CPU,mdp->linesize);
+   fflush(stdout);
+
+  /* start watchdog thread */
+  watchdog_arg.pid=getpid();
+  watchdog_arg.timeout=TIMEOUT;
+  pthread_create(&watchdog,NULL,watchdog_timer,&watchdog_arg);
+
+  return (void*)mdp;
+}
+
+/** The central function within each kernel. This function
+ *  is called for each measurment step seperately.
+ *  @param  mdpv         a pointer to the structure created in bi_init,
+ *                       it is the pointer the bi_init returns
+ *  @param  problemsize  the actual problemsize
+ *  @param  results      a pointer to a field of doubles, the
+ *                       size of the field depends on the number
+ *                       of functions, there are #functions+1
+ *                       doubles
+ *  @return 0 if the measurment was sucessfull, something
+ *          else in the case of an error
+ */
+int inline bi_entry( void* mdpv, int problemsize, double* results )
+{
+  /* k is used for loop iterations */
+  int k = 0;
+  /* number of pages */
+  unsigned long long num_pages;
+  /* cast void* pointer */
+  mydata_t* mdp = (mydata_t*)mdpv;
+
+  /* results */
+  double *tmp_results;
+
+  /* check wether the pointer to store the results in is valid or not */
+  if ( results == NULL ) return 1;
+
+  tmp_results=_mm_malloc((NUM_PAGESIZES+1)*sizeof(double),64);
+
+  num_pages = (unsigned long long) problemarray1[problemsize-1];
+  results[0] = (double)num_pages;
+
+  _work(num_pages,mdp,&tmp_results);
+
+  /* copy tmp_results to final results */
+  for (k=0;k<=NUM_PAGESIZES;k++)
+  {
+    /* write measured cycles to final results, calculate duration */
+    results[1+k]=tmp_results[k];
+    if (tmp_results[k]==INVALID_MEASUREMENT) results[1+NUM_PAGESIZES+1+k]=INVALID_MEASUREMENT;
+    else results[1+NUM_PAGESIZES+1+k]=(double)((tmp_results[k]/mdp->cpuinfo->clockrate)*1000000000);
+
+    /* latency - reference: cost of the page walk */
+    if (k<NUM_PAGESIZES){
+      if ((tmp_results[k]==INVALID_MEASUREMENT)||(tmp_results[NUM_PAGESIZES]==INVALID_MEASUREMENT)) results[1+2*(NUM_PAGESIZES+1)+k]=INVALID_MEASUREMENT;
+      else results[1+2*(NUM_PAGESIZES+1)+k]=tmp_results[k]-tmp_results[NUM_PAGESIZES];
+    }
+  }
+  _mm_free(tmp_results);
+  return 0;
+}
+
+/** Clean up the memory
+ */
+void bi_cleanup( void* mdpv )
+{
+   int i;
+
+   mydata_t* mdp = (mydata_t*)mdpv;
+   pthread_kill(watchdog,SIGUSR1);
+
+   /* free resources */
+   for (i=0;i<mdp->num_pagesizes;i++){
+     if (mdp->buffer[i]) munmap(mdp->buffer[i],mdp->buffersize[i]);
+   }
+   if (mdp->cpuinfo) _mm_free(mdp->cpuinfo);
+   _mm_free( mdp );
+   return;
+}
+
+/********************************************************************/
+/*************** End of interface implementations *******************/
+/********************************************************************/
+
+/* Reads the environment variables used by this kernel. */
+void evaluate_environment(bi_info * info)
+{
+   int i;
+   int errors = 0;
+   char * p = 0;
+
+   cpuinfo=(cpu_info_t*)_mm_malloc( sizeof( cpu_info_t ),64);memset((void*)cpuinfo,0,sizeof( cpu_info_t ));
+   if ( cpuinfo == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure cpuinfo_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+   init_cpuinfo(cpuinfo,1);
+
+   mdp = (mydata_t*)_mm_malloc( sizeof( mydata_t ),64);memset((void*)mdp,0, sizeof( mydata_t ));
+   if ( mdp == 0 ) {
+      fprintf( stderr, "Error: Allocation of structure mydata_t failed\n" ); fflush( stderr );
+      exit( 127 );
+   }
+
+   error_msg=malloc(256);
+
+   /* generate ordered list of page counts in problemarray1*/
+   p = bi_getenv( "BENCHIT_KERNEL_PROBLEMLIST", 0 );
+   if ( p == 0 ){
+     unsigned long long MIN;
+     int STEPS;
+     double MemFactor;
+     p = bi_getenv("BENCHIT_KERNEL_MIN",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MIN not set");}
+     else MIN=atoll(p);
+     p = bi_getenv("BENCHIT_KERNEL_MAX",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_MAX not set");}
+     else MAX=atoll(p);
+     p = bi_getenv("BENCHIT_KERNEL_STEPS",0);
+     if ( p == 0 ) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_STEPS not set");}
+     else STEPS=atoi(p);
+     if ( errors == 0){
+       problemarray1=malloc(STEPS*sizeof(double));
+       MemFactor =((double)MAX)/((double)MIN);
+       MemFactor = pow(MemFactor, 1.0/((double)STEPS-1));
+       for (i=0;i<STEPS;i++){
+          problemarray1[i] = floor(((double)MIN)*pow(MemFactor, i));
+       }
+       problemlistsize=STEPS;
+       problemarray1[STEPS-1]=(double)MAX;
+     }
+   }
+   else{
+     fflush(stdout);printf("BenchIT: parsing list of problemsizes: ");
+     bi_parselist(p);
+     problemlist = info->list;
+     problemlistsize = info->listsize;
+     problemarray1=malloc(problemlistsize*sizeof(double));
+     for (i=0;i<problemlistsize;i++){
+        problemarray1[i]=problemlist->dnumber;
+        if (problemlist->pnext!=NULL) problemlist=problemlist->pnext;
+        if (problemarray1[i]>MAX) MAX=problemarray1[i];
+     }
+   }
+
+   p = bi_getenv( "BENCHIT_KERNEL_CPU", 0 );
+   if ( p != 0 ) CPU = atoi( p );
+   else {
+     for (CPU=0;CPU<CPU_SETSIZE;CPU++) if (cpu_allowed(CPU)) break;
+   }
+   if (!cpu_allowed(CPU)) {errors++;sprintf(error_msg,"selected CPU not allowed");}
+
+   if (bi_getenv( "BENCHIT_KERNEL_PAGE_SIZES", 0 )!=NULL) p=bi_strdup(bi_getenv( "BENCHIT_KERNEL_PAGE_SIZES", 0 ));else p=NULL;
+   if (p==0) {errors++;sprintf(error_msg,"BENCHIT_KERNEL_PAGE_SIZES not set");}
+   else {
+     char *q,*r;
+     do{
+       q=strstr(p,",");if (q) {*q='\0';q++;}
+       if (NUM_PAGESIZES==MAX_PAGE_SIZES) {errors++;sprintf(error_msg,"too many entries in BENCHIT_KERNEL_PAGE_SIZES (max. %i)",MAX_PAGE_SIZES);}
+       else {
+         PAGESIZES[NUM_PAGESIZES]=strtoull(p,&r,10);
+         if ((*r=='K')||(*r=='k')) PAGESIZES[NUM_PAGESIZES]<<=10;
+         else if ((*r=='M')||(*r=='m')) PAGESIZES[NUM_PAGESIZES]<<=20;
+         else if ((*r=='G')||(*r=='g')) PAGESIZES[NUM_PAGESIZES]<<=30;
+         if ((PAGESIZES[NUM_PAGESIZES]<4096)||(PAGESIZES[NUM_PAGESIZES]&(PAGESIZES[NUM_PAGESIZES]-1))) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_PAGE_SIZES (powers of 2, at least 4K)");}
+         NUM_PAGESIZES++;
+       }
+       p=q;
+     }while(p!=NULL);
+   }
+
+   p = bi_getenv( "BENCHIT_KERNEL_MAX_MEMORY", 0 );
+   if ( p != 0 ) MAX_MEMORY = atoll( p )<<20;
+   if (MAX_MEMORY==0) MAX_MEMORY=4096ULL<<20;
+
+   p = bi_getenv( "BENCHIT_KERNEL_ACCESSES", 0 );
+   if ( p != 0 ) ACCESSES = atoll( p );
+   if (ACCESSES<24) ACCESSES=4800;
+
+   p = bi_getenv( "BENCHIT_KERNEL_CPU_FREQUENCY", 0 );
+   if ( p != 0 ) FREQUENCY = atoll( p );
+
+   p = bi_getenv( "BENCHIT_KERNEL_CACHELINE_SIZE", 0 );
+   if ( p != 0 ) CACHELINE = atoll( p );
+   else CACHELINE = cpuinfo->Cacheline_size[0];
+   if (CACHELINE==0) CACHELINE=64;
+
+   p = bi_getenv( "BENCHIT_KERNEL_RUNS", 0 );
+   if ( p != 0 ) RUNS = atoi( p );
+   if (RUNS<1) RUNS=1;
+
+   p=bi_getenv( "BENCHIT_KERNEL_LOOP_OVERHEAD_COMPENSATION", 0 );
+   if (p!=0)
+   {
+     if (!strcmp(p,"enabled")) {
+       int tmp_ovrhd;
+       LOOP_OVERHEAD_COMPENSATION=asm_loop_overhead(10000);
+       for (i=0;i<1000;i++){
+         tmp_ovrhd=asm_loop_overhead(10000);
+         if (tmp_ovrhd<LOOP_OVERHEAD_COMPENSATION){
+           i=0;
+           LOOP_OVERHEAD_COMPENSATION=tmp_ovrhd;
+         }
+       }
+     }
+     else if (!strcmp(p,"disabled")) {LOOP_OVERHEAD_COMPENSATION=0;}
+     else {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_LOOP_OVERHEAD_COMPENSATION");}
+   }
+
+   p=bi_getenv( "BENCHIT_KERNEL_TIMEOUT", 0 );
+   if (p!=0){
+     TIMEOUT=atoi(p);
+   }
+
+   p=bi_getenv( "BENCHIT_KERNEL_SERIALIZATION", 0 );
+   if ((p!=0)&&(strcmp(p,"mfence"))&&(strcmp(p,"cpuid"))&&(strcmp(p,"disabled"))) {errors++;sprintf(error_msg,"invalid setting for BENCHIT_KERNEL_SERIALIZATION");}
+
+   if ( errors > 0 ) {
+      fprintf( stderr, "Error: There's an environment variable not set or invalid!\n" );
+      fprintf( stderr, "%s\n", error_msg);
+      exit( 1 );
+   }
+   free(error_msg);
+}
@@ -0,0 +1,221 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Kernel: measures TLB reach and page walk latency for different page sizes (one cache line per page).
+ ******************************************************************************************************/
+
+#include "interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "work.h"
+
+/* report average latency instead of minimum */
+//#define AVERAGE
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n)
+{
+   unsigned long long a,b,i;
+   static unsigned long long ret=1000000;
+
+   for (i=0;i<n;i++){
+        /* Output: %0: stop timestamp
+         *         %1: start timestamp
+         */
+          __asm__ __volatile__(
+                TIMESTAMP
+                SERIALIZE
+		"mov %1,%0\n\t"
+                SERIALIZE
+                TIMESTAMP
+		: "=r"(a),"=r" (b)
+        );
+        if ((a-b)<ret) ret=(a-b);
+   }
+  return (int)ret;
+}
+
+/** assembler implementation of latency measurement using ldr instruction
+ *  returns the number of cycles needed for passes*24 dependent loads
+ */
+static unsigned long long asm_work_ldr(unsigned long long addr, unsigned long long passes) __attribute__((noinline));
+static unsigned long long asm_work_ldr(unsigned long long addr, unsigned long long passes)
+{
+   unsigned long long a,b;
+
+   if (!passes) return 0;
+
+     /*
+      * Input:  %2: addr (pointer to the buffer)
+      *         %3: passes (number of loop iterations)
+      * Output: %0: stop timestamp - start timestamp
+      */
+     __asm__ __volatile__(
+                TIMESTAMP
+                SERIALIZE
+                ".align 6\n\t"
+                //loop that performs random memory accesses (memory contains precalculated random target addresses)
+                "_work_loop_tlb_ldr:\n\t"
+
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+                "ldr %2,[%2]\n\t"
+
+                "subs %3,%3,#1\n\t"
+                "bne _work_loop_tlb_ldr\n\t"
+
+                SERIALIZE
+                "mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		: "=&r"(a),"=&r"(b),"+r"(addr),"+r"(passes)
+                :
+                : "cc","memory"
+     );
+    return a;
+}
+
+/** generates a random pointer chain through num_pages slots of size stride in buffer
+ *  - one cache line per slot is used, the offset within the slot is rotated through all cache lines of the slot,
+ *    so that the accessed lines are distributed over all cache sets (avoids conflict misses in the data caches)
+ *  - stride = page size: one cache line per page, stride = line size: densely packed cache lines
+ *  returns the start address of the chain
+ */
+static unsigned long long build_chain(char *buffer, unsigned long long stride, unsigned long long num_pages, unsigned long long linesize)
+{
+  unsigned long long i,first,prev,cur,lines_per_slot;
+  struct timeval time;
+
+  lines_per_slot=stride/linesize;
+  if (lines_per_slot==0) lines_per_slot=1;
+
+  #define SLOT(p) ((unsigned long long)buffer+(p)*stride+((p)%lines_per_slot)*linesize)
+
+  if (num_pages<3){
+    /* random sequence not required */
+    for (i=0;i<num_pages;i++) *((unsigned long long*)SLOT(i))=SLOT((i+1)%num_pages);
+    return SLOT(0);
+  }
+
+  gettimeofday( &time, (struct timezone *) 0);
+  _random_init(time.tv_usec,num_pages);
+  first=_random();
+  prev=first;
+  for (i=1;i<num_pages;i++){
+    cur=_random();
+    *((unsigned long long*)SLOT(prev))=SLOT(cur);
+    prev=cur;
+  }
+  *((unsigned long long*)SLOT(prev))=SLOT(first);
+
+  return SLOT(first);
+  #undef SLOT
+}
+
+/** measures the latency of one pointer chain
+ *  - the first run traverses all pages at least once and is discarded (unless only 1 run is performed)
+ *  returns the latency per access in cycles
+ */
+static double measure_chain(unsigned long long start, unsigned long long num_pages, volatile mydata_t* data)
+{
+  int i;
+  unsigned long long passes,tmp;
+  double tmin,lat;
+
+  #ifdef AVERAGE
+   tmin=0;
+  #else
+   tmin=(double)ULLONG_MAX;
+  #endif
+
+  passes=data->accesses/24;
+  if (passes==0) passes=1;
+
+  for (i=0;i<data->runs;i++)
+  {
+    if ((i==0)&&(data->runs>1)){
+      /* warm up TLBs and caches */
+      tmp=(num_pages>data->accesses)?num_pages:data->accesses;
+      asm_work_ldr(start,tmp/24+1);
+      continue;
+    }
+    tmp=asm_work_ldr(start,passes);
+    if (tmp>data->cpuinfo->rdtsc_latency) tmp-=data->cpuinfo->rdtsc_latency;
+    lat=(double)tmp/(double)(passes*24);
+    #ifdef AVERAGE
+      tmin+=lat;
+    #else
+      if (lat<tmin) tmin=lat;
+    #endif
+  }
+  #ifdef AVERAGE
+  if (data->runs>1) tmin/=(data->runs-1);
+  #endif
+
+  return tmin;
+}
+
+/** function that performs the measurement
+ *   - entry point for BenchIT framework (called by bi_entry())
+ *   - for every page size: one cache line in each of num_pages pages is accessed in random order
+ *   - reference: num_pages cache lines are packed densely into the buffer with the largest page size,
+ *     so that the data cache behavior is similar but (almost) no TLB misses occur
+ */
+void _work(unsigned long long num_pages, volatile mydata_t* data, double **results)
+{
+  int i;
+  unsigned long long start;
+
+  for (i=0;i<data->num_pagesizes;i++)
+  {
+    if ((data->max_pages[i]==PAGES_UNAVAILABLE)||(num_pages>data->max_pages[i])) {(*results)[i]=INVALID_MEASUREMENT;continue;}
+    start=build_chain(data->buffer[i],data->pagesize[i],num_pages,data->linesize);
+    (*results)[i]=measure_chain(start,num_pages,data);
+  }
+
+  i=data->reference;
+  if ((i<0)||(num_pages*data->linesize>data->buffersize[i])) (*results)[data->num_pagesizes]=INVALID_MEASUREMENT;
+  else {
+    start=build_chain(data->buffer[i],data->linesize,num_pages,data->linesize);
+    (*results)[data->num_pagesizes]=measure_chain(start,num_pages,data);
+  }
+}
@@ -0,0 +1,58 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Kernel: measures TLB reach and page walk latency for different page sizes (one cache line per page).
+ *******************************************************************/
+
+#ifndef __WORK_H
+#define __WORK_H
+
+#include "mm_malloc.h"
+#include <pthread.h>
+#include <numa.h>
+#include "arch.h"
+#include "membench.h"
+
+#define KERNEL_DESCRIPTION  "TLB reach and page walk latency"
+#define CODE_SEQUENCE       "ldr x,[x] (one cache line per page)"
+#define X_AXIS_TEXT         "number of pages"
+#define Y_AXIS_TEXT_1       "latency [ns]"
+#define Y_AXIS_TEXT_2       "latency [cycles]"
+#define Y_AXIS_TEXT_3       "latency - reference [cycles]"
+
+/* maximal number of page sizes in BENCHIT_KERNEL_PAGE_SIZES */
+#define MAX_PAGE_SIZES 8
+
+/* page sizes that are not provided by the system are reported as INVALID_MEASUREMENT */
+#define PAGES_UNAVAILABLE 0
+
+/** The data structure that holds all the global data.
+ */
+typedef struct mydata
+{
+   char* buffer[MAX_PAGE_SIZES];                        // one buffer per page size
+   unsigned long long buffersize[MAX_PAGE_SIZES];
+   unsigned long long pagesize[MAX_PAGE_SIZES];
+   unsigned long long max_pages[MAX_PAGE_SIZES];        // PAGES_UNAVAILABLE if allocation failed
+   cpu_info_t *cpuinfo;
+   unsigned long long linesize;
+   unsigned long long accesses;
+   int num_pagesizes;
+   int reference;                                       // buffer (largest available page size) used for the reference measurement
+   int runs;
+} mydata_t;
+
+/* measure overhead of empty loop */
+int asm_loop_overhead(int n);
+
+/** function that performs the measurement
+ *  - (*results)[i]: latency in cycles when accessing one cache line in each of num_pages pages of size data->pagesize[i]
+ *  - (*results)[num_pagesizes]: reference latency, num_pages cache lines packed into the largest available pages
+ */
+void _work(unsigned long long num_pages, volatile mydata_t* data, double **results);
+
+#endif
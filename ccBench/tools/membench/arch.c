@@ -17,14 +17,25 @@
 #include <time.h>
 #include <sys/time.h>
 #include <fcntl.h>
+#if defined(__aarch64__)
+#include <sys/auxv.h>
+#endif
 
-#include "work.h"
+#include "membench.h"
 #include "arch.h"
 #include "cpu.h"
 #include "x86.h"
 
 #define MAX_OUTPUT 512
 
+/* not defined by older kernel headers */
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+#ifndef HWCAP_ATOMICS
+#define HWCAP_ATOMICS (1 << 8)
+#endif
+
 static char output[MAX_OUTPUT];
 
 /** initializes cpuinfo-struct
@@ -130,6 +141,21 @@ void init_cpuinfo(cpu_info_t *cpuinfo,int print)
   if (feature_available("FMA4")) cpuinfo->features|=FMA4;
   if (feature_available("LWP")) cpuinfo->features|=LWP;
   if (feature_available("AES")) cpuinfo->features|=AES;
+  #if defined(__aarch64__)
+  /* SVE support is reported by the kernel in the auxiliary vector, vector length is read with rdvl */
+  if (getauxval(AT_HWCAP)&HWCAP_SVE){
+    cpuinfo->features|=SVE;
+    #ifndef NO_SVE
+    {
+      unsigned long long vl;
+      __asm__ __volatile__(SVE_ARCH "rdvl %0,#1\n\t" : "=r" (vl));
+      cpuinfo->sve_vector_length=(unsigned int)vl;
+    }
+    #endif
+  }
+  /* support of large system extension atomics (cas, swp, ...) is reported by the kernel in the auxiliary vector */
+  if (getauxval(AT_HWCAP)&HWCAP_ATOMICS) cpuinfo->features|=LSE;
+  #endif
   /* determine cache details */  
   for (i=0;i<num_caches(0);i++)
   {
@@ -259,6 +285,8 @@ void init_cpuinfo(cpu_info_t *cpuinfo,int print)
     if(cpuinfo->features&NX) printf(" NX");
     if(cpuinfo->features&CPUID) printf(" CPUID");
     if(cpuinfo->features&MTRR) printf(" MTRR");
+    if(cpuinfo->features&SVE) printf(" SVE(%u bit)",cpuinfo->sve_vector_length*8);
+    if(cpuinfo->features&LSE) printf(" LSE");
     fflush(stdout);
     if(cpuinfo->features&TSC)   printf("\n                        TSC: %i cycles latency",cpuinfo->rdtsc_latency);
     if(cpuinfo->features&CLFLUSH) printf("\n                        CLFLUSH: %i Byte clflush-linesize",cpuinfo->clflush_linesize);
@@ -434,7 +462,7 @@ int inline clflush(void* buffer,unsigned long long size,cpu_info_t cpuinfo)
 
   __asm__ __volatile__("mfence;"::: "memory"); 
 
-  #endif
+  #else
     unsigned long long addr,passes,linesize;
     addr = (unsigned long long) buffer;
     //linesize = (unsigned long long) cpuinfo.clflush_linesize;
@@ -446,6 +474,7 @@ int inline clflush(void* buffer,unsigned long long size,cpu_info_t cpuinfo)
       addr+=linesize;
     }
     asm volatile ("dmb sy" : : : "memory");
+  #endif
   return 0;
 }
 
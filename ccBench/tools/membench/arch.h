@@ -41,6 +41,8 @@
 #define FMA4         0x10000000
 #define LWP          0x20000000
 #define AVX2         0x40000000
+#define SVE          0x80000000
+#define LSE          0x100000000ULL
 
 #define MAX_CACHELEVELS 4
 #define MAX_TLBLEVELS   3
@@ -51,7 +53,8 @@ typedef struct cpu_info
   char vendor[48];
   char model_str[48];
   char architecture[10];
-  unsigned int features;
+  unsigned long long features;
+  unsigned int sve_vector_length;
   unsigned int clflush_linesize;
   unsigned int disable_clflush;
   unsigned int num_phy_cores;
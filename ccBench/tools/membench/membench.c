@@ -0,0 +1,880 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Shared code of the membench kernels: random number generator, cache state generation, cache flushes,
+ * and the handshake with the helper threads.
+ ******************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "arch.h"
+#include "membench.h"
+#include "mm_malloc.h"
+
+/* Cavium ThunderX (vendor 0x43) is handled like AMD family 21 (inclusive L2 cache, exclusive L3) by default,
+ * kernels that treat all of its caches as exclusive are compiled with -DTHUNDERX_EXCLUSIVE_CACHES */
+#ifdef THUNDERX_EXCLUSIVE_CACHES
+#define THUNDERX_EXCLUSIVE(vendor)    (!strcmp(vendor,"0x43"))
+#define THUNDERX_INCLUSIVE_L2(vendor) 0
+#else
+#define THUNDERX_EXCLUSIVE(vendor)    0
+#define THUNDERX_INCLUSIVE_L2(vendor) (!strcmp(vendor,"0x43"))
+#endif
+
+/* full memory barrier, host builds of the shared code (tools/membench/test_membench.sh) use the compiler builtin */
+#if defined(__aarch64__)
+#define MEMORY_BARRIER() asm volatile ("dmb sy\n\t" : : : "memory")
+#else
+#define MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+/* user defined maximum value of random numbers returned by _random() */
+static unsigned long long random_max=0;
+
+/* parameters for random number generator 
+ *  formula: random_value(n+1) = (rand_a*random_value(n)+rand_b)%rand_m
+ *  rand_fix: rand_fix=(rand_a*rand_fix+rand_b)%rand_m
+ *        - won't be used as start_value
+ *        - can't be reached by random_value, however special care is taken that rand_fix will also be returned by _random()
+ */
+static unsigned long long random_value=0;
+static unsigned long long rand_a=0;
+static unsigned long long rand_b=0;
+static unsigned long long rand_m=1;
+static unsigned long long rand_fix=0;
+
+/* table of prime numbers needed to generate parameters for random number generator */
+int *p_list=NULL;
+int p_list_max=0;
+int pos=0;
+
+/* variables for prime factorization needed to generate parameters for random number generator */
+long long parts [64];
+int part_count;
+long long number;
+int max_factor;
+
+/** checks if value is prime
+ *  has to be called with all prime numbers < sqrt(value)+1 prior to the call with value
+ */
+static int isprime(unsigned long long value)
+{
+  int i;
+  int limit = (int) trunc(sqrt((double) value)) +1;
+  for (i=0;i<=pos;i++){
+      if (p_list[i]>limit) break;
+      if (value==(unsigned long long)p_list[i]) return 1;
+      if (value%p_list[i]==0) return 0;
+  }
+  if (pos < p_list_max -1){
+     pos++;
+     p_list[pos]=value;
+  }
+  else
+   if (p_list[pos]<limit) 
+      for (i=p_list[pos];i<=limit;i+=2){
+        if (value%i==0) return 0;
+      }
+  return 1;
+}
+
+/** checks if value is a prime factor of global variable number
+ *  has to be called with all prime numbers < sqrt(value)+1 prior to the call with value
+ */
+static int isfactor(int value)
+{
+  if (value<p_list[p_list_max-1]) if (!isprime(value)) return 0;
+  if (number%value==0){
+     parts[part_count]=value;
+     while (number%value==0){
+       number=number/value;
+     }
+     part_count++;
+     max_factor = (int) trunc(sqrt((double) number))+1;
+  }
+  return 1;
+}
+
+/** calculates (x^y)%m
+ */
+static unsigned long long potenz(long long x, long long y, long long m)
+{
+   unsigned long long res=1,mask=1;
+
+   if (y==0) return 1;
+   if (y==1) return x%m;
+
+   assert(y==(y&0x00000000ffffffffULL));
+   assert(x==(x&0x00000000ffffffffULL));
+   assert(m==(m&0x00000000ffffffffULL));
+   
+   mask = mask<<63;
+   while ((y&mask)==0) mask= mask >> 1;
+   do{
+        if (y&mask){
+            res=(res*x)%m;
+            res=(res*res)%m;
+        }
+        else res=(res*res)%m;
+        mask = mask >> 1;
+   }
+   while (mask>1);
+   if (y&mask) res=(res*x)%m;
+
+   return res;
+}
+
+/** checks if value is a primitive root of rand_m
+ */
+static int isprimitiveroot(long long value)
+{
+  long long i,x,y;
+  for (i=0;i<part_count;i++){
+      x = value;
+      y = (rand_m-1)/parts[i];     
+      if (potenz(x,y,rand_m)==1) return 0;
+  }
+  return 1;
+}
+
+/** returns a pseudo random number
+ *  do not use this function without a prior call to _random_init()
+ */
+unsigned long long _random(void)
+{
+  if (random_max==0) return -1;
+  do{
+    random_value = (random_value * rand_a + rand_b)%rand_m;
+  }
+  while (((random_value>random_max)&&(rand_fix<random_max))||((random_value>=random_max)&&(rand_fix>=random_max)));
+  /* hide fixpoint to ensure that each number < random_max is eventually returned (generate permutation of 0..random_max-1) */
+  if (random_value<rand_fix) return random_value;
+  else return random_value-1;
+}
+
+/** Initializes the random number generator with the values given to the function.
+ *  formula: r(n+1) = (a*r(n)+b)%m
+ *  sequence generated by calls of _random() is a permutation of values from 0 to max-1
+ */
+void _random_init(int start,int max)
+{
+  int i;
+  unsigned long long x,f1,f2;
+
+  random_max = (unsigned long long) max;
+  if (random_max==0) return;
+  /* allocate memory for prime number table */
+  if ((((int) trunc(sqrt((double) random_max)) +1)/2+1)>p_list_max){
+    p_list_max=((int) trunc(sqrt((double) random_max)) +1)/2+1;
+    p_list=realloc(p_list,p_list_max*sizeof(int));
+    if (p_list==NULL){
+      while(p_list==NULL){
+        p_list_max=p_list_max/2;
+        p_list=calloc(p_list_max,sizeof(int));
+        assert(p_list_max>2);
+      }
+      pos=0;
+    }
+    if (pos==0){
+      p_list[0]=2;
+      p_list[1]=3;
+      pos++;
+    }
+  }
+
+  /* setup parameters rand_m, rand_a, rand_b, and rand_fix*/
+  rand_m=1;
+  do{
+    rand_m+=2;
+    rand_a=0;
+
+    /* find a prime number for rand_m, larger than random_max*/
+    while ((pos<p_list_max-1)){rand_m+=2;isprime(rand_m);} /* fill prime number table */
+    if (rand_m<=random_max) {rand_m=random_max+1;if(rand_m%2==0)rand_m++;}
+    while (!isprime(rand_m)) rand_m+=2;
+  
+    /* set rand_b to a value between rand_m/4 and 3*rand_m/4 */
+    rand_b=start%(rand_m/2)+rand_m/4;
+    rand_b|=1; // avoid b=0 for m=3, ensures b is odd
+  
+    /* prime factorize rand_m-1, as those are good candidates for primitive roots of rand_m */
+    number=rand_m-1;
+    max_factor = (int) trunc(sqrt((double) number))+1;
+    part_count=0;
+    for(i=0;i<p_list_max;i++) isfactor(p_list[i]);
+    i=p_list[p_list_max-1];
+    while (i<max_factor){
+       isfactor(i);
+       i+=2;
+    }
+    if (number>1){
+       parts[part_count]=number;
+       part_count++;
+    }
+  
+    /* find a value for rand_a that is a primitive root of rand_m and != rand_m/2 
+     * rand_a = rand_m/2 has a high likelyhood to generate a regular pattern */
+    for (i=0;i<part_count;i++){
+      if ((rand_m/2!=parts[i])&&(parts[i]*parts[i]>rand_m)&&(isprimitiveroot(parts[i]))) {rand_a=parts[i];break;}
+    }
+    
+    /* find fixpoint 
+     * check all possibilities: fix = a * fix + b, fix = (a * fix + b) - m, fix = (a * fix +b) - 2m, ... , fix = (a * fix +b) - (a * m)
+     * b is != 0, thus fix = a * fix + b (i.e., fix = 0) cannot happen 
+     */
+    rand_fix=0;
+    if (rand_a!=0) for(x=1;x<=rand_a;x++){        // check for '- (n * m)' with 1 <= n <= a, '- (0 * m)' does not happen (see above)
+        f1 = ((x*rand_m) -rand_b ) / (rand_a-1);  // f1 = (a * f1 + b) - (x * m) -> 0 = (a-1) * f1 + b - (x * m) -> f1 = ((x * m) -b) / (a - 1)
+        f2 = ((f1*rand_a)+rand_b) % rand_m;       // check if f1 is the fixpoint (this only happens for the right x)
+        if (f1==f2) {rand_fix=f1;break;}
+    }    
+  }
+  /* condition 1 avoids small values for rand_a in order to generate highly fluctuating sequences,
+   * condition 2 avoids that a combination of rand_m, rand_a, and rand_b is choosen that does not have a fixpoint (should never happen for prime rand_m)
+   */
+  while((rand_a*rand_a<rand_m)||(rand_fix==0));
+
+
+  /* generator is initialized with the user defined start value */
+  random_value= (unsigned long long)start%rand_m;
+  if (random_value==rand_fix) random_value=0;  /* replace with 0 if it equals rand_fix */
+}
+
+/*
+ * initializes buffer[offset,offset+size) with the offset of each 8 Byte word relative to the start of the buffer
+ * whole cachelines are written with non-temporal 32 Byte stores, unaligned parts with scalar stores
+ */
+void init_buffer(char* buffer,unsigned long long offset,unsigned long long size)
+{
+   unsigned long long i=offset,end=offset+size,lines;
+
+   //scalar stores up to the first cacheline boundary
+   while ((i+8<=end)&&(((unsigned long long)buffer+i)&63)){
+     *((unsigned long long*)(buffer+i))=i;
+     i+=8;
+   }
+
+   lines=(end-i)/64;
+   if (lines){
+     #if defined(__aarch64__)
+     unsigned long long addr=(unsigned long long)buffer+i;
+     unsigned long long values[8];
+     int j;
+
+     for (j=0;j<8;j++) values[j]=i+8*j;
+     __asm__ __volatile__(
+                "ld1 {v0.2d,v1.2d,v2.2d,v3.2d},[%2]\n\t"
+                "dup v4.2d,%3\n\t"
+                "_init_buffer_loop:\n\t"
+                "stnp q0,q1,[%0]\n\t"
+                "stnp q2,q3,[%0,#32]\n\t"
+                "add v0.2d,v0.2d,v4.2d\n\t"
+                "add v1.2d,v1.2d,v4.2d\n\t"
+                "add v2.2d,v2.2d,v4.2d\n\t"
+                "add v3.2d,v3.2d,v4.2d\n\t"
+                "add %0,%0,#64\n\t"
+                "subs %1,%1,#1\n\t"
+                "bne _init_buffer_loop\n\t"
+                : "+r" (addr), "+r" (lines)
+                : "r" (values), "r" (64ULL)
+                : "v0","v1","v2","v3","v4","cc","memory"
+                );
+     i=end-((end-i)%64);
+     #else
+     for (lines=lines*8;lines>0;lines--){
+       *((unsigned long long*)(buffer+i))=i;
+       i+=8;
+     }
+     #endif
+   }
+
+   //remaining words of the last cacheline
+   while (i+8<=end){
+     *((unsigned long long*)(buffer+i))=i;
+     i+=8;
+   }
+}
+
+/*
+ * use a block of memory to ensure it is in the caches afterwards
+ * MODE_EXCLUSIVE: - cache line will be exclusive in cache of calling CPU
+ * MODE_MODIFIED:  - cache line will be modified in cache of calling CPU
+ * MODE_INVALID:   - cache line will be invalid in all caches
+ * MODE_SHARED/MODE_OWNED/MODE_FORWARD:
+ *   - these modes perform a read-only access (on SHARE_CPU)
+ *   - together with accesses on another CPU with MODE_{EXCLUSIVE|MODIFIED} cache line will be in the
+ *     desired coherency state in the cache of the OTHER CPU, and SHARED in the cache of SHARE_CPU
+ *     (see USE MODE ADAPTION in membench_thread.h)
+ */
+int use_memory(void* buffer,void* flush_buffer,unsigned long long memsize,int mode,int direction,int repeat,cpu_info_t cpuinfo)
+{
+   int i,j,tmp=0xd08a721b;
+   unsigned long long stride = 64;
+
+   for (i=cpuinfo.Cachelevels;i>0;i--)
+   {
+     if (cpuinfo.Cacheline_size[i-1]<stride) stride=cpuinfo.Cacheline_size[i-1];
+   }
+
+   #if defined(__aarch64__)
+   if ((mode==MODE_MODIFIED)||(mode==MODE_EXCLUSIVE)||(mode==MODE_INVALID))
+   {
+     //invalidate remote caches
+     //this kernel needs the content of the buffer, so the usage must not be destructive
+     __asm__ __volatile__(
+       		"_use_mem_inv_loop:\n\t"
+       		"ldr %1,[%0]\n\t"
+		"str %1,[%0]\n\t"
+       		"add %0,%0,%2\n\t"
+       		"subs %3,%3,#1\n\t"
+       		"bne _use_mem_inv_loop\n\t"
+       		:
+		: "r" ((unsigned long long)buffer), "r" (tmp), "r" (stride), "r" (memsize/stride)
+		: "memory"
+		);
+     //invalidate local caches
+     if (!cpuinfo.disable_clflush) clflush(buffer,memsize,cpuinfo);
+     else {
+             __asm__ __volatile__
+		(
+       		"_use_mem_flush_loop:\n\t"
+       		"str %1,[%0]\n\t"
+       		"add %0,%0,%2\n\t"
+       		"subs %3,%3,#1\n\t"
+       		"bne _use_mem_flush_loop\n\t"
+       		:
+       		: "r" ((unsigned long long)flush_buffer), "r" (tmp), "r" (stride), "r" (((cpuinfo.D_Cache_Size_per_Core*cpuinfo.EXTRA_FLUSH_SIZE)/50)/stride) : "memory"
+		);
+	clflush(flush_buffer,(cpuinfo.D_Cache_Size_per_Core*cpuinfo.EXTRA_FLUSH_SIZE)/50,cpuinfo);
+     }
+   } 
+   
+  MEMORY_BARRIER();
+
+   j=repeat;
+
+   if (mode==MODE_MODIFIED)
+   {
+     while(j--)
+     {
+       if (direction==FIFO){
+         //this kernel needs the content of the buffer, so the usage must not be destructive
+            __asm__ __volatile__
+		(
+       		"_use_mem_write_loop_fifo:\n\t"
+       		"ldr %1,[%0]\n\t"
+       		"str %1,[%0]\n\t"
+       		"add %0,%0,%2\n\t"
+       		"subs %3,%3,#1\n\t"
+       		"bne _use_mem_write_loop_fifo\n\t"
+       		:
+		: "r" ((unsigned long long)buffer), "r" (tmp), "r" (stride), "r" (memsize/stride)
+		: "memory"
+		);
+       }
+       if (direction==LIFO){
+         //this kernel needs the content of the buffer, so the usage must not be destructive
+           __asm__ __volatile__
+		(
+       		"_use_mem_write_loop_lifo:\n\t"
+       		"sub %0, %0,%2\n\t"
+       		"ldr %1,[%0]\n\t"
+       		"str %1,[%0]\n\t"
+       		"subs %3,%3,#1\n\t"
+       		"bne _use_mem_write_loop_lifo\n\t"
+       		:
+		: "r" ((unsigned long long)buffer+memsize), "r" (tmp), "r" (stride), "r" (memsize/stride)
+		: "memory"
+		);
+       }
+     }
+   } 
+ 
+   if ((mode==MODE_EXCLUSIVE)||(mode==MODE_SHARED)||(mode==MODE_OWNED)||(mode==MODE_FORWARD)||(mode==MODE_RDONLY)) 
+   {
+     while(j--)
+     {
+       if (direction==FIFO){
+        __asm__ __volatile__(
+       		"_use_mem_read_loop_fifo:\n\t"
+			"ldr x4,[%1]\n\t"
+       		"add %1,%1,%2\n\t"
+       		"subs %3,%3,#1\n\t"
+       		"bne _use_mem_read_loop_fifo\n\t"
+       		: "=&r" (tmp)
+		: "r" ((unsigned long long)buffer), "r" (stride), "r" (memsize/stride)
+		:"cc","x4"
+		);
+       }
+       if (direction==LIFO) {
+        __asm__ __volatile__(
+       		"_use_mem_read_loop_lifo:\n\t"
+       		"sub %1,%1,%2\n\t"
+			"ldr w4,[%1]\n\t"
+       		"subs %3,%3,#1\n\t"
+       		"bne _use_mem_read_loop_lifo\n\t"
+       		: "=&r" (tmp)
+		: "r" ((unsigned long long)buffer+memsize), "r" (stride), "r" (memsize/stride)
+		:"cc","x4"
+		);
+       }
+     }
+   }  
+
+   MEMORY_BARRIER();
+   #else
+   //same accesses in C for host builds, the generated instructions are not controlled
+   volatile unsigned long long *p;
+   unsigned long long k,n=memsize/stride;
+
+   if ((mode==MODE_MODIFIED)||(mode==MODE_EXCLUSIVE)||(mode==MODE_INVALID))
+   {
+     for (k=0;k<n;k++){p=(volatile unsigned long long*)((char*)buffer+k*stride);*p=*p;}
+     if (!cpuinfo.disable_clflush) clflush(buffer,memsize,cpuinfo);
+     else {
+       n=((cpuinfo.D_Cache_Size_per_Core*cpuinfo.EXTRA_FLUSH_SIZE)/50)/stride;
+       for (k=0;k<n;k++) *((volatile unsigned long long*)((char*)flush_buffer+k*stride))=tmp;
+       clflush(flush_buffer,(cpuinfo.D_Cache_Size_per_Core*cpuinfo.EXTRA_FLUSH_SIZE)/50,cpuinfo);
+       n=memsize/stride;
+     }
+   }
+   MEMORY_BARRIER();
+
+   j=repeat;
+   while(j--) for (k=0;k<n;k++)
+   {
+     p=(volatile unsigned long long*)((char*)buffer+((direction==LIFO)?(n-1-k):k)*stride);
+     if (mode==MODE_MODIFIED) *p=*p;
+     else if ((mode==MODE_EXCLUSIVE)||(mode==MODE_SHARED)||(mode==MODE_OWNED)||(mode==MODE_FORWARD)||(mode==MODE_RDONLY)) tmp+=(int)*p;
+   }
+   MEMORY_BARRIER();
+   #endif
+
+   return tmp;
+}
+
+/**
+ * flushes data from the specified cachelevel
+ * @param level the cachelevel that should be flushed
+ * @param num_flushes number of accesses to each cacheline
+ * @param mode MODE_EXCLUSIVE: fill cache with dummy data in state exclusive
+ *             MODE_MODIFIED:  fill cache with dummy data in state modified (causes write backs of dirty data later on)
+ *             MODE_INVALID:   invalidate cache (requires clflush)
+ *             MODE_RDONLY:    fill cache with valid dummy data, does not perform any write operations, state can be exclusive or shared/forward
+ * @param buffer pointer to a memory area, size of the buffer has to be 
+ *               has to be larger than 2 x sum of all cachelevels <= level
+ */
+int cacheflush(int level,int num_flushes,int mode,void* buffer,cpu_info_t cpuinfo)
+{
+  unsigned long long stride=cpuinfo.Cacheline_size[level-1]/num_flushes;
+  unsigned long long size=0;
+  int i,j,tmp=0x0fa38b09;
+
+  if (level>cpuinfo.Cachelevels) return -1;
+
+  //exclusive caches
+  if (((!strcmp(cpuinfo.vendor,"AuthenticAMD")) && (cpuinfo.family != 21))||THUNDERX_EXCLUSIVE(cpuinfo.vendor))
+  for (i=0;i<level;i++)
+  {
+     if (cpuinfo.Cache_unified[i]) size+=cpuinfo.U_Cache_Size[i];
+     else size+=cpuinfo.D_Cache_Size[i];
+  }
+  //inclusive L2, exclusive L3
+  if (((!strcmp(cpuinfo.vendor,"AuthenticAMD")) && (cpuinfo.family == 21))||THUNDERX_INCLUSIVE_L2(cpuinfo.vendor))
+  {
+    if (level<3)
+    {
+      i=level-1;
+   	  if (cpuinfo.Cache_unified[i]) size=cpuinfo.U_Cache_Size[i];
+      else size=cpuinfo.D_Cache_Size[i];
+    }
+    else for (i=1;i<level;i++)
+    {     
+     if (cpuinfo.Cache_unified[i]) size+=cpuinfo.U_Cache_Size[i];
+     else size+=cpuinfo.D_Cache_Size[i];
+    }
+  }
+  //inclusive caches
+  if (!strcmp(cpuinfo.vendor,"GenuineIntel")||!strcmp(cpuinfo.vendor,"0x70")||!strcmp(cpuinfo.vendor,"0x48"))//FT,KP920
+  {
+     i=level-1;
+     if (cpuinfo.Cache_unified[i]) size=cpuinfo.U_Cache_Size[i];
+     else size=cpuinfo.D_Cache_Size[i];
+  } 
+
+  size*=cpuinfo.EXTRA_FLUSH_SIZE;
+  // double amount of accessed memory for LLC flushes and decrease num_flushes
+  if (level==cpuinfo.Cachelevels){ 
+    size*=2;
+    num_flushes/=3;
+    num_flushes++;
+  }
+  size/=100;
+
+  if (stride<sizeof(unsigned int)) stride=sizeof(unsigned int);
+  
+  if (mode!=MODE_RDONLY){
+    j=num_flushes;
+    while(j--)
+    {
+     for (i=0;i<size;i+=stride)
+     {
+       tmp|=*((int*)((unsigned long long)buffer+i));
+       *((int*)((unsigned long long)buffer+i))=tmp;
+     }
+    }
+  }
+  if ((mode==MODE_EXCLUSIVE)||(mode==MODE_INVALID)){
+    clflush(buffer,size,cpuinfo);
+  }
+  if ((mode==MODE_EXCLUSIVE)||(mode==MODE_RDONLY)){
+    j=num_flushes;
+    while(j--)
+    {
+     for (i=0;i<size;i+=stride)
+     {
+       tmp|=*((int*)((unsigned long long)buffer+i));
+     }
+     *((int*)((unsigned long long)buffer+i))=tmp;
+    }
+  }
+
+  return tmp;
+}
+
+
+/*
+ * flush all caches that are smaller than the specified memory size, including shared caches
+ */
+void flush_caches(void* buffer,unsigned long long memsize,int settings,int num_flushes,int flush_mode,void* flush_buffer,cpu_info_t *cpuinfo)
+{
+   int i,j;
+   unsigned long long total_cache_size;
+   if (((!strcmp(cpuinfo->vendor,"AuthenticAMD")) && (cpuinfo->family != 21))||THUNDERX_EXCLUSIVE(cpuinfo->vendor)) //exclusive caches
+   for (i=cpuinfo->Cachelevels;i>0;i--)
+   {   
+     if (settings&FLUSH(i))
+     {
+       // determine total exclusive cache size of level that should be flushed
+       total_cache_size=0;
+       for (j=i;j>0;j--) total_cache_size+=cpuinfo->U_Cache_Size[j-1]+cpuinfo->D_Cache_Size[j-1];
+       // subtract higher levels that are flushed too as these flushes polute the cache and reduce the effectively usable size
+       for (j=i-1;j>0;j--) if (settings&FLUSH(j)) total_cache_size-=cpuinfo->U_Cache_Size[j-1]+cpuinfo->D_Cache_Size[j-1];
+       if(memsize>total_cache_size)
+       {
+         cacheflush(i,num_flushes,flush_mode,flush_buffer,*(cpuinfo));
+         break;
+       }
+     }
+   }
+   else if (((!strcmp(cpuinfo->vendor,"AuthenticAMD")) && (cpuinfo->family == 21))||THUNDERX_INCLUSIVE_L2(cpuinfo->vendor))//inclusive L2 cache, exclusive L3
+   {
+    for (i=cpuinfo->Cachelevels;i>2;i--)
+    {   
+     if (settings&FLUSH(i))
+     {
+       // determine total exclusive cache size of level that should be flushed
+       total_cache_size=0;
+       for (j=i;j>1;j--) total_cache_size+=cpuinfo->U_Cache_Size[j-1]+cpuinfo->D_Cache_Size[j-1];
+       // subtract higher levels that are flushed too as these flushes polute the cache and reduce the effectively usable size
+       if ((i==3) && (settings&FLUSH(2))) total_cache_size-=cpuinfo->U_Cache_Size[1]+cpuinfo->D_Cache_Size[1];
+       else if ((i==3) && (settings&FLUSH(1))) total_cache_size-=cpuinfo->U_Cache_Size[0]+cpuinfo->D_Cache_Size[0];
+       if(memsize>total_cache_size)
+       {
+         cacheflush(i,num_flushes,flush_mode,flush_buffer,*(cpuinfo));
+         break;
+       }
+     }
+    }
+    for (i=2;i>0;i--)
+    {   
+     if ((settings&FLUSH(i))&&(memsize>(cpuinfo->U_Cache_Size[i-1]+cpuinfo->D_Cache_Size[i-1])))
+     {
+       cacheflush(i,num_flushes,flush_mode,flush_buffer,*(cpuinfo));
+       break;
+     }
+    }
+   }
+   else // inclusive caches
+   for (i=cpuinfo->Cachelevels;i>0;i--)
+   {   
+     if ((settings&FLUSH(i))&&(memsize>(cpuinfo->U_Cache_Size[i-1]+cpuinfo->D_Cache_Size[i-1])))
+     {
+       cacheflush(i,num_flushes,flush_mode,flush_buffer,*(cpuinfo));
+       break;
+     }
+   }
+}
+
+/*
+ * use mode of the CPU that holds the data before the CPUs in SHARE_CPU_LIST access it (see USE MODE ADAPTION)
+ * shared and owned copies are derived from exclusive and modified copies, MUW from a shared copy
+ */
+int use_mode_local(int mode)
+{
+   if (mode==MODE_SHARED) return MODE_EXCLUSIVE;
+   if (mode==MODE_MUW) return MODE_SHARED;
+   if (mode==MODE_OWNED) return MODE_MODIFIED;
+   return mode;
+}
+
+/*
+ * allocates and first touches the co-resident working set, exits if the allocation fails
+ */
+void damage_init(volatile damage_t *damage,unsigned long long size,int num_results,int alignment)
+{
+   damage->size=size&~(DAMAGE_GRANULARITY-1ULL);
+   damage->buffer=NULL;
+   damage->results=NULL;
+   if (!damage->size) return;
+
+   damage->buffer=(char*)_mm_malloc(damage->size,alignment);
+   damage->results=(double*)_mm_malloc(num_results*sizeof(double),alignment);
+   if ((damage->buffer==NULL)||(damage->results==NULL)){
+     fprintf( stderr, "Error: Allocation of working set buffer failed\n" ); fflush( stderr );
+     exit( 127 );
+   }
+   memset(damage->buffer,0,damage->size);
+}
+
+void damage_free(volatile damage_t *damage)
+{
+   if (damage->buffer!=NULL) _mm_free(damage->buffer);
+   if (damage->results!=NULL) _mm_free(damage->results);
+   damage->buffer=NULL;
+   damage->results=NULL;
+}
+
+/*
+ * brings the co-resident working set into the caches of the calling CPU
+ */
+void damage_use(volatile damage_t *damage,void* flush_buffer,int repeat,cpu_info_t *cpuinfo)
+{
+   if (damage->size) use_memory((void*)damage->buffer,flush_buffer,damage->size,MODE_EXCLUSIVE,FIFO,repeat,*cpuinfo);
+}
+
+/*
+ * re-reads the co-resident working set with 16 Byte loads, returns the bandwidth in Byte/s
+ * host builds of the shared code do not measure (returns 0)
+ */
+double damage_reread(volatile damage_t *damage,unsigned long long call_latency,unsigned long long freq)
+{
+   #if defined(__aarch64__)
+   unsigned long long addr=(unsigned long long)damage->buffer;
+   #endif
+   unsigned long long passes=damage->size/DAMAGE_GRANULARITY;
+   double ret=0;
+
+   if (!passes) return 0;
+   #if defined(__aarch64__)
+   /*
+    * Input:  %1: addr (pointer to the working set)
+    *         %2: passes (number of loop iterations)
+    * Output: %0: stop timestamp - start timestamp
+    */
+   __asm__ __volatile__(
+                "sub sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                TIMESTAMP
+                SERIALIZE
+                "b _work_loop_damage\n\t"
+                ".align 6\n\t"
+                "_work_loop_damage:\n\t"
+		"ldr q0,[%1,#0]\n\t"
+		"ldr q1,[%1,#16]\n\t"
+		"ldr q2,[%1,#32]\n\t"
+		"ldr q3,[%1,#48]\n\t"
+		"ldr q4,[%1,#64]\n\t"
+		"ldr q5,[%1,#80]\n\t"
+		"ldr q6,[%1,#96]\n\t"
+		"ldr q7,[%1,#112]\n\t"
+		"ldr q0,[%1,#128]\n\t"
+		"ldr q1,[%1,#144]\n\t"
+		"ldr q2,[%1,#160]\n\t"
+		"ldr q3,[%1,#176]\n\t"
+		"ldr q4,[%1,#192]\n\t"
+		"ldr q5,[%1,#208]\n\t"
+		"ldr q6,[%1,#224]\n\t"
+		"ldr q7,[%1,#240]\n\t"
+		"add %1,%1,#256\n\t"
+		"subs %2,%2,#1\n\t"
+                "bne _work_loop_damage\n\t"
+                SERIALIZE
+		"mov %1,%0\n\t"
+                TIMESTAMP
+		"sub %0,%0,%1\n\t"
+		"add sp,sp,#16\n\t"	//fix unexplainable stack pointer bug
+                : "=&r" (addr)
+                : "r"(addr), "r" (passes)
+                : "cc", "memory"
+   );
+   ret=(((double)(passes*DAMAGE_GRANULARITY))/((double)(((addr)-call_latency))/(((double)freq)*0.000000001)));
+   #endif
+
+   return ret;
+}
+
+/*
+ * system counter (generic timer), unlike TIMESTAMP (pmccntr_el0 counts the cycles of the executing CPU) it is
+ * synchronized across all CPUs, so timestamps of different threads can be compared
+ * host builds use CLOCK_MONOTONIC in ns
+ */
+unsigned long long global_timestamp(void)
+{
+   unsigned long long ts;
+
+   #if defined(__aarch64__)
+   asm volatile ("isb\n\tmrs %0,cntvct_el0\n\t" : "=r" (ts) : : "memory");
+   #else
+   struct timespec t;
+
+   clock_gettime(CLOCK_MONOTONIC,&t);
+   ts=(unsigned long long)t.tv_sec*1000000000ULL+t.tv_nsec;
+   #endif
+
+   return ts;
+}
+
+/* frequency of global_timestamp() in Hz */
+unsigned long long global_timestamp_freq(void)
+{
+   unsigned long long freq;
+
+   #if defined(__aarch64__)
+   asm volatile ("mrs %0,cntfrq_el0\n\t" : "=r" (freq));
+   #else
+   freq=1000000000ULL;
+   #endif
+
+   return freq;
+}
+
+/* monotonic time in ns, used for the idle policy of the helper threads */
+static unsigned long long timestamp_ns(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC,&ts);
+   return (unsigned long long)ts.tv_sec*1000000000ULL+ts.tv_nsec;
+}
+
+/*
+ * posts a command to a helper thread, several commands to different threads can be posted before waiting for them
+ * only one command per thread may be outstanding
+ */
+void mailbox_post(mailbox_t *mailbox,int command)
+{
+   mailbox->cmd=command;
+   if (mailbox->spin_time>=0) mailbox->post_time=timestamp_ns();
+   //command has to be visible before the new sequence number
+   MEMORY_BARRIER();
+   mailbox->seq=mailbox->seq+1;
+   //the thread sets sleeping before it checks seq for the last time, so one of both sees the other's update
+   MEMORY_BARRIER();
+   if (mailbox->sleeping) syscall(SYS_futex,&(mailbox->seq),FUTEX_WAKE_PRIVATE,1,NULL,NULL,0);
+}
+
+/*
+ * waits until the helper thread completed the last command posted to its mailbox
+ */
+void mailbox_wait(mailbox_t *mailbox)
+{
+   while (mailbox->ack!=mailbox->seq);
+   //results of the command have to be visible afterwards
+   MEMORY_BARRIER();
+}
+
+/*
+ * hands a command to a helper thread and waits until it has been completed
+ */
+void thread_command(mailbox_t *mailbox,int command)
+{
+   mailbox_post(mailbox,command);
+   mailbox_wait(mailbox);
+}
+
+/*
+ * checks the mailbox of a helper thread for a new command
+ * @param seq sequence number of the last command received by the thread, updated if a new command is found
+ * @return the new command or THREAD_WAIT
+ */
+int mailbox_receive(mailbox_t *mailbox,unsigned int *seq)
+{
+   if (mailbox->seq==*seq) return THREAD_WAIT;
+   *seq=mailbox->seq;
+   MEMORY_BARRIER();
+   return mailbox->cmd;
+}
+
+/*
+ * signals the master that the command with the given sequence number has been completed
+ */
+void mailbox_complete(mailbox_t *mailbox,unsigned int seq)
+{
+   MEMORY_BARRIER();
+   mailbox->ack=seq;
+}
+
+/*
+ * idle loop of a helper thread, returns when a new command might be available
+ * spin_time<0:  short busy wait
+ * spin_time>=0: busy wait for up to spin_time ns, block on seq afterwards until the master posts a new command
+ */
+void mailbox_idle(mailbox_t *mailbox,unsigned int seq)
+{
+   volatile int tmp;
+   unsigned long long start,latency;
+
+   if (mailbox->spin_time<0){
+     tmp=100;while(tmp) tmp--;
+     return;
+   }
+
+   start=timestamp_ns();
+   while (mailbox->seq==seq){
+     if (timestamp_ns()-start<(unsigned long long)mailbox->spin_time) continue;
+
+     mailbox->sleeping=1;
+     MEMORY_BARRIER();
+     if (mailbox->seq==seq) syscall(SYS_futex,&(mailbox->seq),FUTEX_WAIT_PRIVATE,seq,NULL,NULL,0);
+     mailbox->sleeping=0;
+
+     if (mailbox->seq!=seq){
+       //time from posting the command to the thread running again
+       MEMORY_BARRIER();
+       latency=timestamp_ns()-mailbox->post_time;
+       mailbox->wakeups++;
+       mailbox->wake_latency+=latency;
+       if (latency>mailbox->wake_latency_max) mailbox->wake_latency_max=latency;
+     }
+     start=timestamp_ns();
+   }
+}
+
+/*
+ * prints average and maximal wake-up latency of threads that blocked while idle
+ * the latency is part of the coordination between the measurements only, it is not included in the measured times
+ */
+void mailbox_report(mailbox_t *mailbox,int num_threads)
+{
+   unsigned long long wakeups=0,latency=0,latency_max=0;
+   int t;
+
+   for (t=1;t<num_threads;t++){
+     wakeups+=mailbox[t].wakeups;
+     latency+=mailbox[t].wake_latency;
+     if (mailbox[t].wake_latency_max>latency_max) latency_max=mailbox[t].wake_latency_max;
+   }
+   if (wakeups) printf("  helper thread wake-up latency: avg %.2f us, max %.2f us (%llu wake-ups)\n",(double)latency/wakeups/1000.0,(double)latency_max/1000.0,wakeups);
+   fflush(stdout);
+}
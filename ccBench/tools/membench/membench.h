@@ -0,0 +1,180 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Shared definitions of the membench kernels (coherency states, thread functions, cache flushes).
+ *******************************************************************/
+
+#ifndef __MEMBENCH_H
+#define __MEMBENCH_H
+
+#include "arch.h"
+
+/* serialization method */
+#if defined(FORCE_CPUID)
+#define SERIALIZE "push %%rax; push %%rbx; push %%rcx; push %%rdx;" \
+                "mov $0, %%rax;" \
+                "cpuid;" \
+                "pop %%rdx; pop %%rcx; pop %%rbx; pop %%rax;"
+#elif defined(FORCE_MFENCE)
+#define SERIALIZE "dmb sy\n\t"
+#else
+#define SERIALIZE ""
+#endif
+
+/* read timestamp counter */
+#define TIMESTAMP "mrs %0,pmccntr_el0\n\t"
+
+#define LOOP_OVERHEAD_COMP 0x100
+#define OPT_FLUSH_CPU0  0x200
+#define FLUSH(X)  (1<<(X-1))
+
+#define HUGEPAGES_OFF  0x01
+#define HUGEPAGES_ON   0x02
+
+#define LIFO           0x01
+#define FIFO           0x02
+
+/* coherency states */
+#define MODE_EXCLUSIVE 0x01
+#define MODE_MODIFIED  0x02
+#define MODE_INVALID   0x04
+#define MODE_SHARED    0x08
+#define MODE_OWNED     0x10
+#define MODE_FORWARD   0x20
+#define MODE_RDONLY    0x40
+#define MODE_MUW       0x80
+#define MODE_DISABLED  0x00
+
+/* thread functions (mailbox_t->cmd), THREAD_WAIT is returned by mailbox_receive() if no new command has been posted */
+#define THREAD_INIT            1
+#define THREAD_STOP            2
+#define THREAD_USE_MEMORY      3
+#define THREAD_WAIT            4
+#define THREAD_PREFETCH_CODE   5
+#define THREAD_FLUSH           6
+#define THREAD_FLUSH_ALL       7
+#define THREAD_INIT_BUFFER     8
+/* first command number available for kernel specific thread functions (handled by HELPER_COMMAND, see membench_thread.h) */
+#define THREAD_KERNEL          16
+
+/* default value for accessing each cacheline - updated with hw_detect information if available */
+#define STRIDE        64
+
+/* definitions to add the selected number of "nop" instructions (BENCHIT_KERNEL_NOPCOUNT) into the assembler code */
+#ifndef NOPCOUNT
+#define NOPCOUNT 0
+#endif
+#define _nop0 ""
+#define _nop1 "nop;"_nop0
+#define _nop2 "nop;"_nop1
+#define _nop3 "nop;"_nop2
+#define _nop4 "nop;"_nop3
+#define _nop5 "nop;"_nop4
+#define _nop6 "nop;"_nop5
+#define _nop7 "nop;"_nop6
+#define _nop8 "nop;"_nop7
+#define _nop9 "nop;"_nop8
+#define _nop10 "nop;"_nop9
+#define _donop(x) _nop ## x       //_donop(n)     -> _nopn
+#define NOP(x) _donop(x)          //NOP(NOPCOUNT) -> _donop(n)
+
+/* SVE instructions are enabled in the assembler via .arch_extension, no special compiler flags are required
+ * define NO_SVE (e.g. in BENCHIT_CC_C_FLAGS) if the assembler does not support SVE */
+#ifndef NO_SVE
+#define SVE_ARCH ".arch_extension sve\n\t"
+#else
+#define SVE_ARCH ""
+#endif
+
+/* LSE atomics are enabled in the assembler via .arch_extension, no special compiler flags are required
+ * define NO_LSE (e.g. in BENCHIT_CC_C_FLAGS) if the assembler does not support LSE */
+#ifndef NO_LSE
+#define LSE_ARCH ".arch_extension lse\n\t"
+#else
+#define LSE_ARCH ""
+#endif
+
+/* co-resident working set (BENCHIT_KERNEL_DAMAGE_SIZE) of the single-* kernels
+ * it is brought into the caches of the measuring CPU before and re-read after every measurement,
+ * a lower re-read bandwidth than without preceding measurement indicates that the working set has been evicted */
+#define DAMAGE_GRANULARITY 256                          // size is a multiple of the Bytes read per loop iteration
+
+typedef struct damage
+{
+   char* buffer;
+   double *results;                                     // re-read bandwidth for every result of _work()
+   unsigned long long size;                             //24, 0: disabled
+} damage_t;
+
+/* command slot of a helper thread, one per thread
+ * the master writes cmd and increments seq afterwards, the thread stores seq in ack when it completed the command
+ * master and thread write to different cachelines, so polling threads do not slow down each other
+ * idle threads spin for spin_time ns and block on seq afterwards (futex), spin_time<0 disables blocking
+ * (the kernels read BENCHIT_KERNEL_IDLE_SPIN_TIME in microseconds from the PARAMETERS file and store it in ns) */
+typedef struct mailbox
+{
+   volatile int cmd;
+   volatile unsigned int seq;                           //8
+   volatile long long spin_time;                        //+8, ns
+   volatile unsigned long long post_time;               //+8, time of the last command (blocking enabled only)
+   volatile unsigned long long buffer;                  //+8, THREAD_INIT_BUFFER: start of the buffer
+   volatile unsigned long long offset;                  //+8, THREAD_INIT_BUFFER: first Byte to initialize
+   volatile unsigned long long size;                    //+8, THREAD_INIT_BUFFER: number of Bytes to initialize
+   unsigned char padding1[16];                          //+16 = 64
+   volatile unsigned int ack;
+   volatile unsigned int sleeping;                      //+8, thread is blocked (or about to block) on seq
+   unsigned long long wakeups;                          //+8, number of commands that had to wake up the thread
+   unsigned long long wake_latency;                     //+8, sum of the wake-up latencies in ns
+   unsigned long long wake_latency_max;                 //+8
+   unsigned char padding2[32];                          //+32 = 128
+} mailbox_t;
+
+/* repetition free sequence of random numbers in the range [0,max] */
+void _random_init(int start,int max);
+unsigned long long _random(void);
+
+/* writes its offset into every 8 Byte word of buffer[offset,offset+size), uses wide non-temporal stores for whole cachelines */
+void init_buffer(char* buffer,unsigned long long offset,unsigned long long size);
+
+/* brings a buffer into the requested coherency state (MODE_*), accesses are not destructive */
+int use_memory(void* buffer,void* flush_buffer,unsigned long long memsize,int mode,int direction,int repeat,cpu_info_t cpuinfo);
+
+/* flushes a single cache level by filling it with the content of buffer, returns -1 if level does not exist */
+int cacheflush(int level,int num_flushes,int mode,void* buffer,cpu_info_t cpuinfo);
+
+/* flush all caches that are smaller than the specified memory size (cache levels selected by FLUSH(level) in settings) */
+void flush_caches(void* buffer,unsigned long long memsize,int settings,int num_flushes,int flush_mode,void* flush_buffer,cpu_info_t *cpuinfo);
+
+/* use mode of the CPU that holds the data before the CPUs in SHARE_CPU_LIST access it */
+int use_mode_local(int mode);
+
+/* co-resident working set: allocation (nothing is allocated for size 0), use before and re-read after the measurement (Byte/s) */
+void damage_init(volatile damage_t *damage,unsigned long long size,int num_results,int alignment);
+void damage_free(volatile damage_t *damage);
+void damage_use(volatile damage_t *damage,void* flush_buffer,int repeat,cpu_info_t *cpuinfo);
+double damage_reread(volatile damage_t *damage,unsigned long long call_latency,unsigned long long freq);
+
+/* timestamps that are comparable across CPUs (unlike TIMESTAMP), counter frequency in Hz */
+unsigned long long global_timestamp(void);
+unsigned long long global_timestamp_freq(void);
+
+/* master: posts a command (THREAD_*) without waiting, waits for completion of the last posted command, or both */
+void mailbox_post(mailbox_t *mailbox,int command);
+void mailbox_wait(mailbox_t *mailbox);
+void thread_command(mailbox_t *mailbox,int command);
+
+/* helper thread: returns a newly posted command (THREAD_WAIT if there is none) and signals its completion */
+int mailbox_receive(mailbox_t *mailbox,unsigned int *seq);
+void mailbox_complete(mailbox_t *mailbox,unsigned int seq);
+
+/* helper thread: waits for a new command according to the idle policy of the mailbox */
+void mailbox_idle(mailbox_t *mailbox,unsigned int seq);
+
+/* master: prints the wake-up latencies of blocked threads (after the threads have been stopped) */
+void mailbox_report(mailbox_t *mailbox,int num_threads);
+
+#endif
@@ -0,0 +1,219 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Compile-time generator of the load bandwidth measurement loops of the membench kernels.
+ * Included by the kernel's work.c after work.h, which has to provide:
+ *   mydata_t with num_events, Eventset, and values (PAPI, data==NULL disables PAPI measurements)
+ * and optionally
+ *   PREFETCH(offset,reg), PREFETCH_ADVANCE(bytes,reg) - one prfm per cacheline (default: no prefetch)
+ * The kernel instantiates the routines it needs (ASM_WORK_ALL(), ...) and collects them in a dispatch table
+ * of asm_work_t rows indexed by burst length (ASM_WORK_ROW(), ...).
+ *******************************************************************/
+
+#ifndef __MEMBENCH_ASM_H
+#define __MEMBENCH_ASM_H
+
+#ifndef PREFETCH
+#define PREFETCH(offset,reg) ""
+#define PREFETCH_ADVANCE(bytes,reg) ""
+#endif
+
+/* - one function per instruction and burst length (number of registers used before the first one is reused)
+ * - a group covers whole cachelines with one prfm each: lcm(4,burst_length) accesses of 16 Byte, or
+ *   burst_length/2 ldnp register pairs
+ * - one pass (loop iteration) consists of several groups: 1024 Byte, 1152 Byte for burst length 3
+ * - offsets are expressions that are evaluated by the assembler
+ * adding an instruction only requires SIZE_<insn>, LINE_<insn>(), ADVANCE_<insn>(), and a row in the kernel's table */
+#define SIZE_ld1                16
+#define ACCESS_ld1(reg,off)     "ld1 {v"#reg".4s},[%1],#16\n\t"NOP(NOPCOUNT)
+#define ADVANCE_ld1(bytes)      ""                        // post-increment
+#define SIZE_ldr128             16
+#define ACCESS_ldr128(reg,off)  "ldr q"#reg",[%1,#"#off"]\n\t"NOP(NOPCOUNT)
+#define ADVANCE_ldr128(bytes)   "add %1,%1,#"#bytes"\n\t"
+#define SIZE_ldnp               32
+#define ACCESS_ldnp(r0,r1,off)  "ldnp q"#r0",q"#r1",[%1,#"#off"]\n\t"NOP(NOPCOUNT)
+#define ADVANCE_ldnp(bytes)     "add %1,%1,#"#bytes"\n\t"
+
+#define ACCESS(insn,reg,off)    ACCESS_##insn(reg,off)
+#define ADVANCE(insn,bytes)     ADVANCE_##insn(bytes)
+
+/* accesses to one cacheline using registers r0-r3 */
+#define LINE_16(insn,off,r0,r1,r2,r3) ACCESS(insn,r0,off) ACCESS(insn,r1,off+16) ACCESS(insn,r2,off+32) ACCESS(insn,r3,off+48)
+#define LINE_ld1(off,r0,r1,r2,r3)     LINE_16(ld1,off,r0,r1,r2,r3)
+#define LINE_ldr128(off,r0,r1,r2,r3)  LINE_16(ldr128,off,r0,r1,r2,r3)
+#define LINE_ldnp(off,r0,r1,r2,r3)    ACCESS_ldnp(r0,r1,off) ACCESS_ldnp(r2,r3,off+32)
+
+/* one cacheline: prfm and the accesses of the instruction */
+#define LINE(insn,off,r0,r1,r2,r3) PREFETCH(off,%3) LINE_##insn(off,r0,r1,r2,r3)
+
+/* groups for every supported burst length */
+#define GROUP_1(insn,off)       LINE(insn,off,0,0,0,0)
+#define GROUP_2(insn,off)       LINE(insn,off,0,1,0,1)
+#define GROUP_3(insn,off)       LINE(insn,off,0,1,2,0) LINE(insn,off+64,1,2,0,1) LINE(insn,off+128,2,0,1,2)
+#define GROUP_4(insn,off)       LINE(insn,off,0,1,2,3)
+#define GROUP_8(insn,off)       LINE(insn,off,0,1,2,3) LINE(insn,off+64,4,5,6,7)
+
+/* repeat a group within a pass */
+#define REP6(G,insn,size)       G(insn,0*size) G(insn,1*size) G(insn,2*size) G(insn,3*size) G(insn,4*size) G(insn,5*size)
+#define REP8(G,insn,size)       REP6(G,insn,size) G(insn,6*size) G(insn,7*size)
+#define REP16(G,insn,size)      REP8(G,insn,size) G(insn,8*size) G(insn,9*size) G(insn,10*size) G(insn,11*size) \
+                                G(insn,12*size) G(insn,13*size) G(insn,14*size) G(insn,15*size)
+
+#ifdef USE_PAPI
+#define PAPI_START(data) if ((data)&&(data->num_events)) PAPI_reset(data->Eventset);
+#define PAPI_STOP(data)  if ((data)&&(data->num_events)) PAPI_read(data->Eventset,data->values);
+#else
+#define PAPI_START(data)
+#define PAPI_STOP(data)
+#endif
+
+/* signature of all generated routines, returns the bandwidth in Byte/s (0 if accesses is less than one pass) */
+typedef double (*asm_work_t)(unsigned long long addr, unsigned long long accesses, unsigned long long prefetch_distance, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data);
+
+/** generates asm_work_<insn>_<burst>()
+ *  - rep: repetition macro, size: Bytes per group, bytes: Bytes per pass
+ */
+#define ASM_WORK(insn,burst,rep,size,bytes) \
+static double asm_work_##insn##_##burst(unsigned long long addr, unsigned long long accesses, unsigned long long prefetch_distance, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline)); \
+static double asm_work_##insn##_##burst(unsigned long long addr, unsigned long long accesses, unsigned long long prefetch_distance, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) \
+{ \
+   unsigned long long passes,n,cycles,prefetch_addr; \
+   double ret; \
+ \
+   /* prfm instructions use separate pointer that runs ahead by prefetch_distance Byte */ \
+   prefetch_addr=addr+prefetch_distance; \
+   passes=accesses/((bytes)/SIZE_##insn); \
+   if (!passes) return 0; \
+   n=passes; \
+ \
+   PAPI_START(data) \
+   /* \
+    * Input:  %1: addr (pointer to the buffer) \
+    *         %2: passes (number of loop iterations) \
+    *         %3: prefetch_addr \
+    * Output: %0: stop timestamp - start timestamp \
+    */ \
+   __asm__ __volatile__( \
+                "sub sp,sp,#16\n\t"	/* fix unexplainable stack pointer bug */ \
+                TIMESTAMP \
+                SERIALIZE \
+                "b _work_loop_"#insn"_"#burst"\n\t" \
+                ".align 6\n\t" \
+                "_work_loop_"#insn"_"#burst":\n\t" \
+                rep(GROUP_##burst,insn,size) \
+                ADVANCE(insn,bytes) \
+                PREFETCH_ADVANCE(bytes,%3) \
+                "subs %2,%2,#1\n\t" \
+                "bne _work_loop_"#insn"_"#burst"\n\t" \
+                SERIALIZE \
+                "mov %1,%0\n\t" \
+                TIMESTAMP \
+                "sub %0,%0,%1\n\t" \
+                "add sp,sp,#16\n\t"	/* fix unexplainable stack pointer bug */ \
+                : "=&r" (cycles), "+r" (addr), "+r" (n), "+r" (prefetch_addr) \
+                : \
+                : "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "cc", "memory" \
+   ); \
+   ret=(((double)(passes*(bytes)))/((double)((cycles-call_latency))/(((double)freq)*0.000000001))); \
+ \
+   PAPI_STOP(data) \
+   return ret; \
+}
+
+/* all supported burst lengths of an instruction with one register per access */
+#define ASM_WORK_ALL(insn) \
+ASM_WORK(insn,1,REP16,64,1024) \
+ASM_WORK(insn,2,REP16,64,1024) \
+ASM_WORK(insn,3,REP6,192,1152) \
+ASM_WORK(insn,4,REP16,64,1024) \
+ASM_WORK(insn,8,REP8,128,1024)
+
+/* all supported burst lengths of an instruction that loads register pairs */
+#define ASM_WORK_PAIRS(insn) \
+ASM_WORK(insn,2,REP16,64,1024) \
+ASM_WORK(insn,4,REP16,64,1024) \
+ASM_WORK(insn,8,REP8,128,1024)
+
+/* SVE: one pass loads 8 vectors using registers r0-r7, the loop is predicated (whilelo)
+ * t: element type (d, b), esize: Bytes per element
+ * z0-z7 overlap v0-v7, the clobbers use the v names that are known to all toolchains */
+#define ACCESS_SVE(insn,t,reg,idx)  #insn" z"#reg"."#t",p0/z,[%1,#"#idx",mul vl]\n\t"NOP(NOPCOUNT)
+#define PASS_SVE(insn,t,r0,r1,r2,r3,r4,r5,r6,r7) \
+                                ACCESS_SVE(insn,t,r0,0) ACCESS_SVE(insn,t,r1,1) ACCESS_SVE(insn,t,r2,2) ACCESS_SVE(insn,t,r3,3) \
+                                ACCESS_SVE(insn,t,r4,4) ACCESS_SVE(insn,t,r5,5) ACCESS_SVE(insn,t,r6,6) ACCESS_SVE(insn,t,r7,7)
+#define PASS_SVE_1(insn,t)      PASS_SVE(insn,t,0,0,0,0,0,0,0,0)
+#define PASS_SVE_2(insn,t)      PASS_SVE(insn,t,0,1,0,1,0,1,0,1)
+#define PASS_SVE_4(insn,t)      PASS_SVE(insn,t,0,1,2,3,0,1,2,3)
+#define PASS_SVE_8(insn,t)      PASS_SVE(insn,t,0,1,2,3,4,5,6,7)
+
+/** generates asm_work_<insn>_<burst>() for SVE loads
+ *  - vector length (data->cpuinfo->sve_vector_length) is determined at runtime, data must not be NULL
+ *  - no prefetch, prefetch_distance is ignored
+ */
+#define ASM_WORK_SVE(insn,t,esize,burst) \
+static double asm_work_##insn##_##burst(unsigned long long addr, unsigned long long accesses, unsigned long long prefetch_distance, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) __attribute__((noinline)); \
+static double asm_work_##insn##_##burst(unsigned long long addr, unsigned long long accesses, unsigned long long prefetch_distance, unsigned long long call_latency,unsigned long long freq,volatile mydata_t *data) \
+{ \
+   unsigned long long passes,vl,elements,index,cycles; \
+   double ret; \
+ \
+   vl=data->cpuinfo->sve_vector_length; \
+   passes=accesses/8; \
+   if (!passes) return 0; \
+   elements=passes*8*vl/(esize); \
+   index=0; \
+ \
+   PAPI_START(data) \
+   /* \
+    * Input:  %1: addr (pointer to the buffer) \
+    *         %2: elements (number of elements to load) \
+    *         %3: index (element index, loop counter) \
+    * Output: %0: stop timestamp - start timestamp \
+    */ \
+   __asm__ __volatile__( \
+                "sub sp,sp,#16\n\t"	/* fix unexplainable stack pointer bug */ \
+                SVE_ARCH \
+                "whilelo p0."#t",%3,%2\n\t" \
+                TIMESTAMP \
+                SERIALIZE \
+                "b _work_loop_"#insn"_"#burst"\n\t" \
+                ".align 6\n\t" \
+                "_work_loop_"#insn"_"#burst":\n\t" \
+                PASS_SVE_##burst(insn,t) \
+                "addvl %1,%1,#8\n\t" \
+                "inc"#t" %3,all,mul #8\n\t" \
+                "whilelo p0."#t",%3,%2\n\t" \
+                "b.first _work_loop_"#insn"_"#burst"\n\t" \
+                SERIALIZE \
+                "mov %1,%0\n\t" \
+                TIMESTAMP \
+                "sub %0,%0,%1\n\t" \
+                "add sp,sp,#16\n\t"	/* fix unexplainable stack pointer bug */ \
+                : "=&r" (cycles), "+r" (addr), "+r" (elements), "+r" (index) \
+                : \
+                : "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "p0", "cc", "memory" \
+   ); \
+   ret=(((double)(passes*8*vl))/((double)((cycles-call_latency))/(((double)freq)*0.000000001))); \
+ \
+   PAPI_STOP(data) \
+   return ret; \
+}
+
+/* all supported burst lengths of an SVE load */
+#define ASM_WORK_SVE_ALL(insn,t,esize) \
+ASM_WORK_SVE(insn,t,esize,1) \
+ASM_WORK_SVE(insn,t,esize,2) \
+ASM_WORK_SVE(insn,t,esize,4) \
+ASM_WORK_SVE(insn,t,esize,8)
+
+/* rows of the dispatch table, indexed by burst length (NULL: not supported) */
+#define ASM_WORK_NONE           {NULL}
+#define ASM_WORK_ROW(insn)      {NULL,asm_work_##insn##_1,asm_work_##insn##_2,asm_work_##insn##_3,asm_work_##insn##_4,NULL,NULL,NULL,asm_work_##insn##_8}
+#define ASM_WORK_ROW_PAIRS(insn) {NULL,NULL,asm_work_##insn##_2,NULL,asm_work_##insn##_4,NULL,NULL,NULL,asm_work_##insn##_8}
+#define ASM_WORK_ROW_SVE(insn)  {NULL,asm_work_##insn##_1,asm_work_##insn##_2,NULL,asm_work_##insn##_4,NULL,NULL,NULL,asm_work_##insn##_8}
+
+#endif
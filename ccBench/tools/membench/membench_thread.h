@@ -0,0 +1,296 @@
+/********************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ *******************************************************************/
+/* Shared code of the membench kernels that depends on the kernel's mydata_t and threaddata_t:
+ * USE MODE ADAPTION and the loop executed by the helper threads.
+ * Included once by the kernel's work.c after the following macros have been defined:
+ *   LOCAL_USE_MEMORY(data,addr,memsize,mode)  - accesses of the measuring CPU (mydata_t *data)
+ *   HELPER_USE_MEMORY(global_data,mydata)     - accesses of a helper thread (threaddata_t *mydata)
+ * and optionally
+ *   HELPER_COMMAND(global_data,mydata,cmd)    - kernel specific thread functions (cmd>=THREAD_KERNEL), completed afterwards
+ *   FLUSH_SIZE(memsize)                       - memory footprint that selects the flushed cache levels (default: memsize)
+ * Both structures must provide the fields used below (aligned_addr, memsize, accesses, USE_MODE, ...).
+ *******************************************************************/
+
+#ifndef __MEMBENCH_THREAD_H
+#define __MEMBENCH_THREAD_H
+
+#ifndef FLUSH_SIZE
+#define FLUSH_SIZE(memsize) (memsize)
+#endif
+
+/*
+ * let count threads starting with first access the buffer of thread t (or the local buffer at aligned_addr if t==0) with the given use mode
+ * the commands are posted to all threads before waiting for them
+ */
+static void use_memory_remote(volatile mydata_t *data,int first,int count,int t,unsigned long long aligned_addr,unsigned long long memsize,unsigned long long accesses,int mode)
+{
+  unsigned long long own_addr[count>0?count:1];
+  int i;
+
+  for (i=0;i<count;i++){
+    own_addr[i]=data->threaddata[first+i].aligned_addr;
+    if (t) data->threaddata[first+i].aligned_addr=data->threaddata[t].aligned_addr;
+    else data->threaddata[first+i].aligned_addr=aligned_addr;
+    data->threaddata[first+i].memsize=memsize;
+    data->threaddata[first+i].accesses=accesses;
+    data->threaddata[first+i].USE_MODE=mode;
+  }
+  for (i=0;i<count;i++) mailbox_post(&(data->mailbox[first+i]),THREAD_USE_MEMORY);
+  for (i=0;i<count;i++){
+    mailbox_wait(&(data->mailbox[first+i]));
+    data->threaddata[first+i].aligned_addr=own_addr[i];
+  }
+}
+
+/* USE MODE ADAPTION (for BENCHIT_KERNEL_*_USE_MODE={S|F|O})
+ * enforcing data to be in one of the shared coherency states (SHARED/OWNED/FORWARD), is implemented by adapting the target state for
+ * individual accesses (a specific core (BENCHIT_KERNEL_SHARE_CPU) is used to share cachelines with the currently selected CPU (thread_id))
+ * Forward: - Thread on SHARE_CPU accesses data with use mode EXCLUSIVE
+ *          - Thread on selected CPU accesses data with use mode FORWARD (read only)
+ *          Note: Forward seems to be a per-package state
+ *                - Cores will have the line in shared state
+ *                - L3 will have it in shared state (and 2 core valid bits set) if both cores share a package (die)
+ *                - only if cores are in different packacges (dies), one L3 (last accessing core determines which one) will mark the line with state Forward
+ *          Note: only usefull if coherency protocol is MESIF !!!
+ * Shared:  - Thread on selected CPU accesses data with use mode EXCLUSIVE
+ *          - Thread on SHARE_CPU accesses data with use mode SHARED (read only)
+ *          Note: works on MESIF and non-MESIF protocols (copy on SHARE_CPU will be in Forward state for MESIF, thus SHRAE_CPU should be as far away from first CPU as posible)
+ * Owned:   - Thread on selected CPU accesses data with use mode MODIFIED
+ *          - Thread on SHARE_CPU accesses data with use mode SHARED (read only)
+ *          Note: only works if coherency protocol is MOESI (otherwise both lines will be in shared state)
+ * afterwards all cachelevels are flushed as specified in PARAMETERS
+ */
+static void use_mode_adaption(volatile mydata_t *data,int t,unsigned long long aligned_addr,unsigned long long memsize,unsigned long long accesses)
+{
+  int i;
+
+  if ((data->USE_MODE==MODE_FORWARD)&&(data->NUM_SHARED_CPUS)){
+    //tell other threads to use memory, the first one creates the exclusive copy
+    use_memory_remote(data,data->FRST_SHARE_CPU,1,t,aligned_addr,memsize,accesses,MODE_EXCLUSIVE);
+    use_memory_remote(data,data->FRST_SHARE_CPU+1,data->NUM_SHARED_CPUS-1,t,aligned_addr,memsize,accesses,data->USE_MODE);
+  }
+  // -> M in SHARE_CPU, next read results in MUW in the requestor
+  if (data->USE_MODE==MODE_MUW) use_memory_remote(data,data->FRST_SHARE_CPU,1,t,aligned_addr,memsize,accesses,MODE_MODIFIED);
+
+  /*
+   * modified/exclusive: create copy with the requested state in target CPU (CPUs in SHARED_CPU_LIST not involved)
+   * shared: create exclussive copy in target CPU first, will be transformed to shared by later accesses of CPUs in SHARED_CPU_LIST
+   * forward: one exclusive or multiple shared copies already exist in CPUs from SHARED_CPU_LIST, additional read inserts forward copy in target CPU
+   */
+  if (!t){ // measure local cache hierarchy
+    //access whole buffer to warm up cache
+    LOCAL_USE_MEMORY(data,aligned_addr,memsize,use_mode_local(data->USE_MODE));
+  }
+  else{ // measure accesses to other cores' caches
+    //tell other thread to use memory
+    data->threaddata[t].memsize=memsize;
+    data->threaddata[t].accesses=accesses;
+    data->threaddata[t].USE_MODE=use_mode_local(data->USE_MODE);
+
+    thread_command(&(data->mailbox[t]),THREAD_USE_MEMORY);
+  }
+
+  /* turn Exclusive copy in target CPU into Shared copy
+   * one CPU in SHARED_CPU_LIST will have forward copy
+   */
+  if (data->USE_MODE==MODE_SHARED){
+    //tell other threads to use memory
+    use_memory_remote(data,data->FRST_SHARE_CPU,data->NUM_SHARED_CPUS,t,aligned_addr,memsize,accesses,data->USE_MODE);
+  }
+  if (data->USE_MODE==MODE_OWNED) use_memory_remote(data,data->FRST_SHARE_CPU,1,t,aligned_addr,memsize,accesses,data->USE_MODE);
+
+  //flush cachelevels as specified in PARAMETERS
+  //tell threads on shared CPUs and the thread on the target CPU to flush caches, all of them flush concurrently
+  for (i=data->FRST_SHARE_CPU;i<data->FRST_SHARE_CPU+data->NUM_SHARED_CPUS;i++){
+    if (data->flush_share_cpu) mailbox_post(&(data->mailbox[i]),THREAD_FLUSH_ALL);
+    else mailbox_post(&(data->mailbox[i]),THREAD_FLUSH);
+  }
+  if (t) mailbox_post(&(data->mailbox[t]),THREAD_FLUSH);
+  for (i=data->FRST_SHARE_CPU;i<data->FRST_SHARE_CPU+data->NUM_SHARED_CPUS;i++) mailbox_wait(&(data->mailbox[i]));
+  if (t){
+    mailbox_wait(&(data->mailbox[t]));
+    if (data->settings&OPT_FLUSH_CPU0) flush_caches((void*) data->threaddata[t].aligned_addr,FLUSH_SIZE(memsize),data->settings,data->NUM_FLUSHES,data->FLUSH_MODE,data->cache_flush_area,data->cpuinfo);
+  }
+  else flush_caches((void*) data->threaddata[t].aligned_addr,FLUSH_SIZE(memsize),data->settings,data->NUM_FLUSHES,data->FLUSH_MODE,data->cache_flush_area,data->cpuinfo);
+}
+
+/*
+ * parallel first touch of the master buffer and the buffers of the threads
+ * each buffer is split across all threads whose memory is bound to the same NUMA node as the buffer's owner,
+ * so pages are placed exactly as if the owner initialized the buffer itself, buffers on different nodes are initialized concurrently
+ * the master initializes its buffer itself if no thread is bound to its node
+ * @param buffersize size of the master buffer (data->buffer), the threads' buffers are described by threaddata_t
+ * @param mem_bind CPU the master buffer is bound to
+ */
+void init_buffers(volatile mydata_t *data,unsigned long long buffersize,int mem_bind)
+{
+  int num_nodes=numa_max_node()+1;
+  int *node_of=(int*)malloc(data->num_threads*sizeof(int));          // NUMA node of each thread's memory binding
+  int *node_busy=(int*)malloc(num_nodes*sizeof(int));
+  char *pending=(char*)malloc(data->num_threads*sizeof(char));       // buffers that are not initialized yet
+  unsigned long long size,chunk,offset;
+  char *buffer;
+  int b,t,node,workers,remaining;
+
+  if ((node_of==NULL)||(node_busy==NULL)||(pending==NULL)){
+    fprintf( stderr, "Error: Allocation of buffer initialization structures failed\n" ); fflush( stderr );
+    exit( 127 );
+  }
+
+  remaining=0;
+  for (b=0;b<data->num_threads;b++){
+    node_of[b]=numa_node_of_cpu(b?data->threaddata[b].mem_bind:mem_bind);
+    if (node_of[b]<0) node_of[b]=0;
+    pending[b]=b?(data->threaddata[b].buffersize!=0):(buffersize!=0);
+    remaining+=pending[b];
+  }
+
+  while (remaining){
+    // one buffer per NUMA node in each round, split across all threads on that node
+    memset(node_busy,0,num_nodes*sizeof(int));
+    for (b=0;b<data->num_threads;b++){
+      if ((!pending[b])||(node_busy[node_of[b]])) continue;
+      node=node_of[b];
+      node_busy[node]=1;
+      pending[b]=0;
+      remaining--;
+
+      if (b){buffer=data->threaddata[b].buffer;size=data->threaddata[b].buffersize;}
+      else {buffer=data->buffer;size=buffersize;}
+      size&=~7ULL;
+
+      workers=0;
+      for (t=1;t<data->num_threads;t++) if (node_of[t]==node) workers++;
+      if (!workers){
+        init_buffer(buffer,0,size);
+        clflush(buffer,size,*(data->cpuinfo));
+        continue;
+      }
+      // whole pages per thread
+      chunk=((size/workers)+4095)&~4095ULL;
+      offset=0;
+      for (t=1;(t<data->num_threads)&&(offset<size);t++){
+        if (node_of[t]!=node) continue;
+        data->mailbox[t].buffer=(unsigned long long)buffer;
+        data->mailbox[t].offset=offset;
+        data->mailbox[t].size=(offset+chunk<size)?chunk:size-offset;
+        mailbox_post(&(data->mailbox[t]),THREAD_INIT_BUFFER);
+        offset+=chunk;
+      }
+    }
+    for (t=1;t<data->num_threads;t++) mailbox_wait(&(data->mailbox[t]));
+  }
+
+  free(node_of);
+  free(node_busy);
+  free(pending);
+}
+
+/*
+ * loop executed by all threads, except the master thread
+ */
+void *thread(void *threaddata)
+{
+  int id= ((threaddata_t *) threaddata)->thread_id;
+  unsigned int numa_node;
+  struct bitmask *numa_bitmask;
+  volatile mydata_t* global_data = ((threaddata_t *) threaddata)->data; //communication
+  threaddata_t* mydata = (threaddata_t*)threaddata;
+  char* filename=NULL;
+
+  mailbox_t *mailbox = &(global_data->mailbox[id]);
+  unsigned int seq=0;
+  int cmd,fd;
+
+  //wait for THREAD_INIT, allocation is done by all threads in parallel, master waits for completion later on
+  while (mailbox_receive(mailbox,&seq)!=THREAD_INIT) mailbox_idle(mailbox,seq);
+
+  cpu_set(((threaddata_t *) threaddata)->mem_bind);
+  numa_node = numa_node_of_cpu(((threaddata_t *) threaddata)->mem_bind);
+  numa_bitmask = numa_bitmask_alloc((unsigned int) numa_max_possible_node());
+  numa_bitmask = numa_bitmask_clearall(numa_bitmask);
+  numa_bitmask = numa_bitmask_setbit(numa_bitmask, numa_node);
+  numa_set_membind(numa_bitmask);
+  numa_bitmask_free(numa_bitmask);
+
+  if(mydata->buffersize)
+  {
+    if (global_data->hugepages==HUGEPAGES_OFF) mydata->buffer = (void *) _mm_malloc( mydata->buffersize,mydata->alignment);
+    if (global_data->hugepages==HUGEPAGES_ON)
+    {
+      char *dir;
+      dir=bi_getenv("BENCHIT_KERNEL_HUGEPAGE_DIR",0);
+      filename=(char*)malloc((strlen(dir)+20)*sizeof(char));
+      sprintf(filename,"%s/thread_data_%i",dir,id);
+      mydata->buffer=NULL;
+      fd=open(filename,O_CREAT|O_RDWR,0664);
+      if (fd == -1)
+      {
+        fprintf( stderr, "Allocation of buffer failed\n" ); fflush( stderr );
+        perror("open");
+        exit( 127 );
+      }
+      mydata->buffer=(char*) mmap(NULL,mydata->buffersize,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+      close(fd);unlink(filename);
+    }
+    //buffer is initialized later on by all threads on this NUMA node (see init_buffers())
+    mydata->aligned_addr=(unsigned long long)(mydata->buffer) + mydata->offset;
+  }
+  else mydata->aligned_addr=(unsigned long long)(global_data->buffer) + mydata->offset;
+
+  mailbox_complete(mailbox,seq);
+
+  cpu_set(((threaddata_t *) threaddata)->cpu_id);
+  while(1)
+  {
+     cmd=mailbox_receive(mailbox,&seq);
+     switch (cmd){
+       case THREAD_USE_MEMORY:
+         // use memory
+         HELPER_USE_MEMORY(global_data,mydata);
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_FLUSH:
+         //flush cachelevels as specified in PARAMETERS
+         flush_caches((void*) (mydata->aligned_addr),FLUSH_SIZE(mydata->memsize),mydata->settings,mydata->NUM_FLUSHES,mydata->FLUSH_MODE,mydata->cache_flush_area,mydata->cpuinfo);
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_INIT_BUFFER:
+         //first touch of a part of a buffer that belongs to a thread on the same NUMA node
+         init_buffer((char*)mailbox->buffer,mailbox->offset,mailbox->size);
+         clflush((void*)(mailbox->buffer+mailbox->offset),mailbox->size,*(mydata->cpuinfo));
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_FLUSH_ALL:
+         //flush all caches
+         flush_caches((void*) (mydata->aligned_addr),mydata->cpuinfo->Total_D_Cache_Size*2,mydata->settings,mydata->NUM_FLUSHES,mydata->FLUSH_MODE,mydata->cache_flush_area,mydata->cpuinfo);
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_WAIT: // no new command
+          mailbox_idle(mailbox,seq);
+          break;
+       default:
+         #ifdef HELPER_COMMAND
+         if (cmd>=THREAD_KERNEL){
+           HELPER_COMMAND(global_data,mydata,cmd);
+           mailbox_complete(mailbox,seq);
+           break;
+         }
+         #endif
+       case THREAD_STOP: // exit
+         if (global_data->hugepages==HUGEPAGES_ON)
+         {
+           if(mydata->buffer!=NULL) munmap((void*)mydata->buffer,mydata->buffersize);
+         }
+         mailbox_complete(mailbox,seq);
+         pthread_exit(NULL);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,200 @@
+/******************************************************************************************************
+ * BenchIT - Performance Measurement for Scientific Applications
+ * Contact: developer@benchit.org
+ *
+ * $Id$
+ * For license details see COPYING in the package base directory
+ ******************************************************************************************************/
+/* Host test of the shared membench code: buffer initialization, global timestamps and the mailbox handshake with the
+ * helper threads (spinning and blocking idle policy), built and run by test_membench.sh
+ ******************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "arch.h"
+#include "membench.h"
+#include "mm_malloc.h"
+
+/* kernel specific command of the test helper threads */
+#define THREAD_ADD             THREAD_KERNEL
+
+#define NUM_THREADS  4
+#define ROUNDS       200
+#define BUFFERSIZE   (64*1024)
+
+/* data of a test helper thread */
+typedef struct testdata
+{
+   mailbox_t *mailbox;
+   int id;
+   volatile unsigned long long value;                   // THREAD_ADD: added to sum
+   volatile unsigned long long sum;
+} testdata_t;
+
+static int errors=0;
+
+/* arch.c is linked with the hardware detection in tools/hw_detect only, the tested functions do not flush caches */
+int clflush(void* buffer,unsigned long long size, cpu_info_t cpuinfo)
+{
+   return 0;
+}
+
+#define CHECK(cond,...) do { if (!(cond)) { errors++; printf("FAILED: " __VA_ARGS__); printf("\n"); } } while (0)
+
+/* reference check of buffer[0,size) after init_buffer(buffer,offset,length): words in the range hold their offset,
+ * all other words are unchanged (0xff pattern) */
+static void check_buffer(char *buffer,unsigned long long size,unsigned long long offset,unsigned long long length)
+{
+   unsigned long long i,expected,value;
+
+   for (i=0;i+8<=size;i+=8){
+     memcpy(&value,buffer+i,8);
+     if ((i>=offset)&&(i+8<=offset+length)) expected=i;
+     else expected=0xffffffffffffffffULL;
+     if (value!=expected){
+       CHECK(0,"init_buffer(offset %llu, size %llu): word at %llu is 0x%llx, expected 0x%llx",offset,length,i,value,expected);
+       return;
+     }
+   }
+}
+
+static void test_init_buffer(void)
+{
+   /* aligned and unaligned starts and ends, less than one cacheline, empty */
+   unsigned long long ranges[][2]={{0,BUFFERSIZE},{8,200},{56,72},{64,0},{128,64},{24,4096+40},{4096,BUFFERSIZE-4096}};
+   unsigned long long r,split;
+   char *buffer=_mm_malloc(BUFFERSIZE,4096);
+
+   for (r=0;r<sizeof(ranges)/sizeof(ranges[0]);r++){
+     memset(buffer,0xff,BUFFERSIZE);
+     init_buffer(buffer,ranges[r][0],ranges[r][1]);
+     check_buffer(buffer,BUFFERSIZE,ranges[r][0],ranges[r][1]);
+   }
+
+   /* parts initialized independently (as by the helper threads in init_buffers()) equal one initialization of the whole buffer */
+   for (split=8;split<BUFFERSIZE;split+=4104){
+     memset(buffer,0xff,BUFFERSIZE);
+     init_buffer(buffer,0,split);
+     init_buffer(buffer,split,BUFFERSIZE-split);
+     check_buffer(buffer,BUFFERSIZE,0,BUFFERSIZE);
+   }
+   _mm_free(buffer);
+   printf("init_buffer: %s\n",errors?"FAILED":"ok");
+}
+
+/* global_timestamp() is monotonic and global_timestamp_freq() matches the elapsed time */
+static void test_global_timestamp(void)
+{
+   unsigned long long start,end,freq=global_timestamp_freq();
+   double elapsed;
+   int old_errors=errors;
+
+   CHECK(freq>0,"global_timestamp_freq() returned 0");
+   start=global_timestamp();
+   usleep(10000);
+   end=global_timestamp();
+   CHECK(end>start,"global_timestamp() is not monotonic");
+   if (freq){
+     elapsed=((double)(end-start))/((double)freq);
+     CHECK((elapsed>=0.009)&&(elapsed<1.0),"global_timestamp(): %f s elapsed during a sleep of 0.01 s",elapsed);
+   }
+   printf("global_timestamp: %s\n",(errors==old_errors)?"ok":"FAILED");
+}
+
+/* helper thread loop as used by the kernels */
+static void *thread(void *arg)
+{
+   testdata_t *mydata=(testdata_t*)arg;
+   mailbox_t *mailbox=mydata->mailbox;
+   unsigned int seq=0;
+
+   while (mailbox_receive(mailbox,&seq)!=THREAD_INIT) mailbox_idle(mailbox,seq);
+   mydata->sum=0;
+   mailbox_complete(mailbox,seq);
+
+   while(1){
+     switch (mailbox_receive(mailbox,&seq)){
+       case THREAD_ADD:
+         mydata->sum+=mydata->value;
+         mailbox_complete(mailbox,seq);
+         break;
+       case THREAD_WAIT: // no new command
+         mailbox_idle(mailbox,seq);
+         break;
+       case THREAD_STOP: // exit
+       default:
+         mailbox_complete(mailbox,seq);
+         pthread_exit(NULL);
+     }
+   }
+}
+
+/* master side of the handshake, every round posts one command to all threads before waiting for them */
+static void test_mailbox(long long spin_time)
+{
+   mailbox_t *mailbox=_mm_malloc(NUM_THREADS*sizeof(mailbox_t),sizeof(mailbox_t));
+   testdata_t data[NUM_THREADS];
+   pthread_t threads[NUM_THREADS];
+   unsigned long long expected=0,wakeups=0;
+   int t,r,old_errors=errors;
+
+   memset(mailbox,0,NUM_THREADS*sizeof(mailbox_t));
+   for (t=1;t<NUM_THREADS;t++){
+     mailbox[t].spin_time=spin_time;
+     data[t].mailbox=&(mailbox[t]);
+     data[t].id=t;
+     data[t].sum=~0ULL;
+     mailbox_post(&(mailbox[t]),THREAD_INIT);
+     pthread_create(&(threads[t]),NULL,thread,(void*)&(data[t]));
+   }
+   for (t=1;t<NUM_THREADS;t++) mailbox_wait(&(mailbox[t]));
+   for (t=1;t<NUM_THREADS;t++) CHECK(data[t].sum==0,"thread %i did not complete THREAD_INIT",t);
+
+   for (r=1;r<=ROUNDS;r++){
+     for (t=1;t<NUM_THREADS;t++) data[t].value=(unsigned long long)(r*t);
+     __sync_synchronize();
+     for (t=1;t<NUM_THREADS;t++) mailbox_post(&(mailbox[t]),THREAD_ADD);
+     for (t=1;t<NUM_THREADS;t++) mailbox_wait(&(mailbox[t]));
+     expected+=r;
+     /* every result is visible after mailbox_wait() */
+     for (t=1;t<NUM_THREADS;t++) if (data[t].sum!=expected*t){
+       CHECK(0,"spin_time %lld: round %i, thread %i: sum %llu, expected %llu",spin_time,r,t,data[t].sum,expected*t);
+       r=ROUNDS;
+       break;
+     }
+     /* give blocking threads the chance to go to sleep */
+     if ((spin_time>=0)&&(r%20==0)) usleep(2000);
+   }
+
+   /* single command and wait */
+   data[1].value=1;
+   thread_command(&(mailbox[1]),THREAD_ADD);
+   CHECK(data[1].sum==expected+1,"spin_time %lld: thread_command() did not complete",spin_time);
+
+   for (t=1;t<NUM_THREADS;t++) mailbox_post(&(mailbox[t]),THREAD_STOP);
+   for (t=1;t<NUM_THREADS;t++) pthread_join(threads[t],NULL);
+   for (t=1;t<NUM_THREADS;t++) CHECK(mailbox[t].ack==mailbox[t].seq,"spin_time %lld: thread %i did not acknowledge THREAD_STOP",spin_time,t);
+
+   for (t=1;t<NUM_THREADS;t++) wakeups+=mailbox[t].wakeups;
+   if (spin_time<0) CHECK(wakeups==0,"spin_time %lld: spinning threads were woken up %llu times",spin_time,wakeups);
+   else CHECK(wakeups>0,"spin_time %lld: blocking threads never went to sleep",spin_time);
+   mailbox_report(mailbox,NUM_THREADS);
+
+   _mm_free(mailbox);
+   if (spin_time<0) printf("mailbox (spin): %s\n",(errors==old_errors)?"ok":"FAILED");
+   else printf("mailbox (block after %lld ns): %s\n",spin_time,(errors==old_errors)?"ok":"FAILED");
+}
+
+int main(void)
+{
+   test_init_buffer();
+   test_global_timestamp();
+   test_mailbox(-1);
+   test_mailbox(100000);
+   test_mailbox(0);
+
+   return errors?1:0;
+}
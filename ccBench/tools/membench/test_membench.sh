@@ -0,0 +1,22 @@
+#!/bin/sh
+##################################################################################################################
+# BenchIT - Performance Measurement for Scientific Applications
+# Contact: developer@benchit.org
+#
+# $Id$
+# For license details see COPYING in the package base directory
+##################################################################################################################
+# Builds and runs the host test of the shared membench code (buffer initialization, global timestamps, mailbox handshake).
+# Works on AArch64 and on other hosts (e.g. x86-64), the compiler can be selected with CC.
+##################################################################################################################
+
+cd `dirname ${0}` || exit 1
+
+CC=${CC:-cc}
+TMPDIR=`mktemp -d` || exit 1
+trap 'rm -rf ${TMPDIR}' EXIT
+
+printf "${CC} -O2 -Wall -I. -I../.. -I../hw_detect -o ${TMPDIR}/test_membench test_membench.c membench.c -lpthread -lm\n"
+${CC} -O2 -Wall -I. -I../.. -I../hw_detect -o ${TMPDIR}/test_membench test_membench.c membench.c -lpthread -lm || exit 1
+
+${TMPDIR}/test_membench